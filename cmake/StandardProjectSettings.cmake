@@ -40,3 +40,13 @@ else ()
 	message(STATUS "No colored compiler diagnostic set for '${CMAKE_CXX_COMPILER_ID}' compiler.")
 endif ()
 
+
+option(ENABLE_AVX2 "Compile with AVX2 instructions, used by the batched maths kernels (SSE2 is used otherwise on x86-64)" OFF)
+
+if (ENABLE_AVX2)
+	if (MSVC)
+		add_compile_options(/arch:AVX2)
+	else ()
+		add_compile_options(-mavx2 -mfma)
+	endif ()
+endif ()
@@ -0,0 +1,348 @@
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+	constexpr std::size_t channelCount = 4;
+
+	using Color = std::array<float, channelCount>;
+	using Block = std::array<Color, 16>;
+
+	// Texels of the given block, clamped to the edges of the image
+	[[nodiscard]] Block loadBlock(std::span<const std::byte> pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY)
+	{
+		Block block{};
+		for (uint32_t y = 0; y < 4; ++y) {
+			const auto pixelY = std::min(blockY * 4 + y, height - 1);
+			for (uint32_t x = 0; x < 4; ++x) {
+				const auto pixelX = std::min(blockX * 4 + x, width - 1);
+				const auto offset = (static_cast<std::size_t>(pixelY) * width + pixelX) * channelCount;
+				for (std::size_t channel = 0; channel < channelCount; ++channel) {
+					block[y * 4 + x][channel] = static_cast<float>(std::to_integer<uint32_t>(pixels[offset + channel]));
+				}
+			}
+		}
+
+		return block;
+	}
+
+	[[nodiscard]] float getDistance(const Color& lhs, const Color& rhs, std::size_t usedChannels)
+	{
+		float distance = 0.f;
+		for (std::size_t channel = 0; channel < usedChannels; ++channel) {
+			const auto difference = lhs[channel] - rhs[channel];
+			distance += difference * difference;
+		}
+
+		return distance;
+	}
+
+	[[nodiscard]] uint32_t findClosest(std::span<const Color> palette, const Color& color, std::size_t usedChannels)
+	{
+		uint32_t closest     = 0;
+		auto closestDistance = std::numeric_limits<float>::max();
+		for (uint32_t index = 0; index < palette.size(); ++index) {
+			const auto distance = getDistance(palette[index], color, usedChannels);
+			if (distance < closestDistance) {
+				closest         = index;
+				closestDistance = distance;
+			}
+		}
+
+		return closest;
+	}
+
+	// Extremes of the block texels along their principal axis, which is found with a few power iterations on their covariance matrix
+	[[nodiscard]] std::pair<Color, Color> findEndpoints(const Block& block, std::size_t usedChannels)
+	{
+		Color mean{};
+		Color minColor{};
+		Color maxColor{};
+		minColor.fill(255.f);
+		for (const auto& texel : block) {
+			for (std::size_t channel = 0; channel < usedChannels; ++channel) {
+				mean[channel] += texel[channel] / 16.f;
+				minColor[channel] = std::min(minColor[channel], texel[channel]);
+				maxColor[channel] = std::max(maxColor[channel], texel[channel]);
+			}
+		}
+
+		std::array<Color, channelCount> covariance{};
+		for (const auto& texel : block) {
+			for (std::size_t row = 0; row < usedChannels; ++row) {
+				for (std::size_t column = 0; column < usedChannels; ++column) {
+					covariance[row][column] += (texel[row] - mean[row]) * (texel[column] - mean[column]);
+				}
+			}
+		}
+
+		// Starting from the diagonal of the bounding box
+		Color axis{};
+		for (std::size_t channel = 0; channel < usedChannels; ++channel) { axis[channel] = maxColor[channel] - minColor[channel]; }
+		if (getDistance(axis, Color{}, usedChannels) <= 0.f) { return {mean, mean}; }
+		for (uint32_t iteration = 0; iteration < 4; ++iteration) {
+			Color nextAxis{};
+			float length = 0.f;
+			for (std::size_t row = 0; row < usedChannels; ++row) {
+				for (std::size_t column = 0; column < usedChannels; ++column) { nextAxis[row] += covariance[row][column] * axis[column]; }
+				length = std::max(length, std::abs(nextAxis[row]));
+			}
+			if (length <= 0.f) { break; }
+			for (std::size_t channel = 0; channel < usedChannels; ++channel) { axis[channel] = nextAxis[channel] / length; }
+		}
+
+		auto minProjection       = std::numeric_limits<float>::max();
+		auto maxProjection       = std::numeric_limits<float>::lowest();
+		const auto axisLengthSqr = getDistance(axis, Color{}, usedChannels);
+		for (const auto& texel : block) {
+			float projection = 0.f;
+			for (std::size_t channel = 0; channel < usedChannels; ++channel) {
+				projection += (texel[channel] - mean[channel]) * axis[channel];
+			}
+			minProjection = std::min(minProjection, projection / axisLengthSqr);
+			maxProjection = std::max(maxProjection, projection / axisLengthSqr);
+		}
+
+		std::pair<Color, Color> endpoints{mean, mean};
+		for (std::size_t channel = 0; channel < usedChannels; ++channel) {
+			endpoints.first[channel]  = std::clamp(mean[channel] + axis[channel] * minProjection, 0.f, 255.f);
+			endpoints.second[channel] = std::clamp(mean[channel] + axis[channel] * maxProjection, 0.f, 255.f);
+		}
+
+		return endpoints;
+	}
+
+	[[nodiscard]] uint32_t quantize(float value, uint32_t maxValue)
+	{
+		return static_cast<uint32_t>(std::lround(value / 255.f * static_cast<float>(maxValue)));
+	}
+
+	[[nodiscard]] uint16_t toRGB565(const Color& color)
+	{
+		return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+	}
+
+	[[nodiscard]] Color fromRGB565(uint16_t value)
+	{
+		const auto red   = (value >> 11) & 31;
+		const auto green = (value >> 5) & 63;
+		const auto blue  = value & 31;
+
+		return {static_cast<float>((red << 3) | (red >> 2)),
+		        static_cast<float>((green << 2) | (green >> 4)),
+		        static_cast<float>((blue << 3) | (blue >> 2)),
+		        255.f};
+	}
+
+	[[nodiscard]] Color interpolate(const Color& lhs, const Color& rhs, float factor)
+	{
+		Color result{};
+		for (std::size_t channel = 0; channel < channelCount; ++channel) {
+			result[channel] = lhs[channel] + (rhs[channel] - lhs[channel]) * factor;
+		}
+
+		return result;
+	}
+
+	void encodeBC1Block(const Block& block, std::byte* destination)
+	{
+		const auto [minEndpoint, maxEndpoint] = findEndpoints(block, 3);
+		auto color0                           = toRGB565(maxEndpoint);
+		auto color1                           = toRGB565(minEndpoint);
+		// color0 > color1 selects the 4 colors mode, the other one using an index for transparent black
+		if (color0 < color1) { std::swap(color0, color1); }
+
+		uint32_t indices = 0;
+		if (color0 != color1) {
+			const auto endpoint0 = fromRGB565(color0);
+			const auto endpoint1 = fromRGB565(color1);
+			const std::array<Color, 4> palette{
+			  endpoint0,
+			  endpoint1,
+			  interpolate(endpoint0, endpoint1, 1.f / 3.f),
+			  interpolate(endpoint0, endpoint1, 2.f / 3.f),
+			};
+			for (std::size_t texel = 0; texel < block.size(); ++texel) { indices |= findClosest(palette, block[texel], 3) << (2 * texel); }
+		}
+
+		destination[0] = static_cast<std::byte>(color0 & 0xFF);
+		destination[1] = static_cast<std::byte>(color0 >> 8);
+		destination[2] = static_cast<std::byte>(color1 & 0xFF);
+		destination[3] = static_cast<std::byte>(color1 >> 8);
+		for (std::size_t byte = 0; byte < 4; ++byte) { destination[4 + byte] = static_cast<std::byte>((indices >> (8 * byte)) & 0xFF); }
+	}
+
+	// One channel of the block, BC5 blocks being made of two of these
+	void encodeBC4Block(const Block& block, std::size_t channel, std::byte* destination)
+	{
+		auto minValue = 255.f;
+		auto maxValue = 0.f;
+		for (const auto& texel : block) {
+			minValue = std::min(minValue, texel[channel]);
+			maxValue = std::max(maxValue, texel[channel]);
+		}
+		const auto endpoint0 = static_cast<uint32_t>(std::lround(maxValue));
+		const auto endpoint1 = static_cast<uint32_t>(std::lround(minValue));
+
+		// endpoint0 > endpoint1 selects the 8 values mode: the 2 endpoints, and 6 steps between them
+		uint64_t indices = 0;
+		if (endpoint0 > endpoint1) {
+			std::array<Color, 8> palette{};
+			palette[0][0] = static_cast<float>(endpoint0);
+			palette[1][0] = static_cast<float>(endpoint1);
+			for (uint32_t step = 1; step < 7; ++step) {
+				palette[step + 1][0] = static_cast<float>(endpoint0 * (7 - step) + endpoint1 * step) / 7.f;
+			}
+			for (std::size_t texel = 0; texel < block.size(); ++texel) {
+				const Color value{block[texel][channel]};
+				indices |= static_cast<uint64_t>(findClosest(palette, value, 1)) << (3 * texel);
+			}
+		}
+
+		destination[0] = static_cast<std::byte>(endpoint0);
+		destination[1] = static_cast<std::byte>(endpoint1);
+		for (std::size_t byte = 0; byte < 6; ++byte) { destination[2 + byte] = static_cast<std::byte>((indices >> (8 * byte)) & 0xFF); }
+	}
+
+	// BC7 mode 6 endpoints have 7 bits per channel, and a lowest bit shared by all of their channels
+	struct BC7Endpoint
+	{
+		std::array<uint32_t, channelCount> color{};
+		uint32_t pBit{0};
+	};
+
+	[[nodiscard]] std::array<uint32_t, channelCount> decodeBC7Endpoint(const BC7Endpoint& endpoint)
+	{
+		std::array<uint32_t, channelCount> color{};
+		for (std::size_t channel = 0; channel < channelCount; ++channel) {
+			color[channel] = (endpoint.color[channel] << 1) | endpoint.pBit;
+		}
+
+		return color;
+	}
+
+	[[nodiscard]] BC7Endpoint quantizeBC7Endpoint(const Color& color)
+	{
+		BC7Endpoint bestEndpoint{};
+		auto bestError = std::numeric_limits<float>::max();
+		for (uint32_t pBit = 0; pBit < 2; ++pBit) {
+			BC7Endpoint endpoint{.pBit = pBit};
+			for (std::size_t channel = 0; channel < channelCount; ++channel) {
+				const auto value        = std::lround((color[channel] - static_cast<float>(pBit)) / 2.f);
+				endpoint.color[channel] = static_cast<uint32_t>(std::clamp(value, 0l, 127l));
+			}
+
+			float error        = 0.f;
+			const auto decoded  = decodeBC7Endpoint(endpoint);
+			for (std::size_t channel = 0; channel < channelCount; ++channel) {
+				const auto difference = static_cast<float>(decoded[channel]) - color[channel];
+				error += difference * difference;
+			}
+			if (error < bestError) {
+				bestEndpoint = endpoint;
+				bestError    = error;
+			}
+		}
+
+		return bestEndpoint;
+	}
+
+	// Writes values from the lowest bit of the destination on, which has to be zeroed beforehand
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::byte* destination) : m_destination{destination} {}
+
+		void write(uint32_t value, uint32_t bitCount)
+		{
+			for (uint32_t bit = 0; bit < bitCount; ++bit, ++m_position) {
+				if (((value >> bit) & 1) != 0) { m_destination[m_position / 8] |= static_cast<std::byte>(1 << (m_position % 8)); }
+			}
+		}
+
+	private:
+		std::byte* m_destination;
+		uint32_t m_position{0};
+	};
+
+	void encodeBC7Block(const Block& block, std::byte* destination)
+	{
+		static constexpr std::array<uint32_t, 16> weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		const auto [minEndpoint, maxEndpoint] = findEndpoints(block, channelCount);
+		auto endpoint0                        = quantizeBC7Endpoint(minEndpoint);
+		auto endpoint1                        = quantizeBC7Endpoint(maxEndpoint);
+
+		// Interpolated like the hardware does it
+		const auto color0 = decodeBC7Endpoint(endpoint0);
+		const auto color1 = decodeBC7Endpoint(endpoint1);
+		std::array<Color, weights.size()> palette{};
+		for (std::size_t index = 0; index < weights.size(); ++index) {
+			for (std::size_t channel = 0; channel < channelCount; ++channel) {
+				const auto value        = (color0[channel] * (64 - weights[index]) + color1[channel] * weights[index] + 32) >> 6;
+				palette[index][channel] = static_cast<float>(value);
+			}
+		}
+
+		std::array<uint32_t, 16> indices{};
+		for (std::size_t texel = 0; texel < block.size(); ++texel) { indices[texel] = findClosest(palette, block[texel], channelCount); }
+		// The highest bit of the first index is not stored and has to be 0, which swapping the endpoints guarantees
+		if (indices[0] >= 8) {
+			std::swap(endpoint0, endpoint1);
+			for (auto& index : indices) { index = 15 - index; }
+		}
+
+		BitWriter writer{destination};
+		writer.write(1 << 6, 7);  // Mode 6
+		for (std::size_t channel = 0; channel < channelCount; ++channel) {
+			writer.write(endpoint0.color[channel], 7);
+			writer.write(endpoint1.color[channel], 7);
+		}
+		writer.write(endpoint0.pBit, 1);
+		writer.write(endpoint1.pBit, 1);
+		writer.write(indices[0], 3);
+		for (std::size_t texel = 1; texel < indices.size(); ++texel) { writer.write(indices[texel], 4); }
+	}
+
+	[[nodiscard]] std::vector<std::byte>
+	compressImage(std::span<const std::byte> pixels, uint32_t width, uint32_t height, std::size_t blockSize, auto&& encodeBlock)
+	{
+		const auto blocksX = (width + 3) / 4;
+		const auto blocksY = (height + 3) / 4;
+		std::vector<std::byte> result(static_cast<std::size_t>(blocksX) * blocksY * blockSize);
+		for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+			for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+				const auto blockOffset = (static_cast<std::size_t>(blockY) * blocksX + blockX) * blockSize;
+				encodeBlock(loadBlock(pixels, width, height, blockX, blockY), result.data() + blockOffset);
+			}
+		}
+
+		return result;
+	}
+}  // namespace
+
+namespace BlockCompression
+{
+	std::vector<std::byte> compressBC1(std::span<const std::byte> pixels, uint32_t width, uint32_t height)
+	{
+		return compressImage(pixels, width, height, 8, encodeBC1Block);
+	}
+
+	std::vector<std::byte> compressBC5(std::span<const std::byte> pixels, uint32_t width, uint32_t height)
+	{
+		return compressImage(pixels, width, height, 16, [](const Block& block, std::byte* destination) {
+			encodeBC4Block(block, 0, destination);
+			encodeBC4Block(block, 1, destination + 8);
+		});
+	}
+
+	std::vector<std::byte> compressBC7(std::span<const std::byte> pixels, uint32_t width, uint32_t height)
+	{
+		return compressImage(pixels, width, height, 16, encodeBC7Block);
+	}
+}  // namespace BlockCompression
@@ -0,0 +1,21 @@
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Encoders of RGBA8 images into 4x4 blocks, written for offline use: they favour simplicity over quality and speed. Blocks on the right
+// and bottom edges of images whose size is not a multiple of 4 repeat the last column and row.
+namespace BlockCompression
+{
+	// Opaque color images, 8 bytes per block (the alpha channel is ignored)
+	[[nodiscard]] std::vector<std::byte> compressBC1(std::span<const std::byte> pixels, uint32_t width, uint32_t height);
+	// Two channel images like normal maps, 16 bytes per block (only the red and green channels are kept)
+	[[nodiscard]] std::vector<std::byte> compressBC5(std::span<const std::byte> pixels, uint32_t width, uint32_t height);
+	// Color images with or without alpha, 16 bytes per block. Only mode 6 (a single RGBA line per block with 16 steps) is used.
+	[[nodiscard]] std::vector<std::byte> compressBC7(std::span<const std::byte> pixels, uint32_t width, uint32_t height);
+}  // namespace BlockCompression
+
+#endif
@@ -0,0 +1,68 @@
+#include "JobsBenchmark.h"
+#include "MeshCooking.h"
+#include "TextureCooking.h"
+#include "TransformsBenchmark.h"
+
+#include <Morrigu.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	void printUsage()
+	{
+		MRG_INFO("Usage (paths are relative to the assets folders, run from the runtime directory):")
+		MRG_INFO("\tCooker mesh <basic|colored|textured> <mesh files...>")
+		MRG_INFO("\tCooker mesh-benchmark [iterations] [mesh files...]")
+		MRG_INFO("\tCooker texture <bc1|bc1-linear|bc5|bc7|bc7-linear> <texture files...>")
+		MRG_INFO("\tCooker texture-benchmark [iterations] [texture files...]")
+		MRG_INFO("\tCooker jobs-benchmark [threads] [jobs] [iterations]")
+		MRG_INFO("\tCooker transforms-benchmark [iterations]")
+	}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	MRG::Logger::init();
+
+	const std::vector<std::string> args(argv + 1, argv + argc);
+	if (args.empty()) {
+		printUsage();
+		return 1;
+	}
+
+	const auto& command = args[0];
+	if (command == "mesh" && args.size() >= 3) {
+		return MeshCooking::cook(args[1], {args.begin() + 2, args.end()}) ? 0 : 1;
+	}
+	if (command == "mesh-benchmark") {
+		const std::size_t iterations = (args.size() >= 2) ? std::stoul(args[1]) : 20;
+		MeshCooking::benchmark((args.size() >= 3) ? std::vector<std::string>{args.begin() + 2, args.end()} : std::vector<std::string>{},
+		                       iterations);
+		return 0;
+	}
+	if (command == "texture" && args.size() >= 3) {
+		return TextureCooking::cook(args[1], {args.begin() + 2, args.end()}) ? 0 : 1;
+	}
+	if (command == "texture-benchmark") {
+		const std::size_t iterations = (args.size() >= 2) ? std::stoul(args[1]) : 20;
+		TextureCooking::benchmark((args.size() >= 3) ? std::vector<std::string>{args.begin() + 2, args.end()} : std::vector<std::string>{},
+		                          iterations);
+		return 0;
+	}
+	if (command == "jobs-benchmark") {
+		const auto threadCount       = (args.size() >= 2) ? static_cast<uint32_t>(std::stoul(args[1])) : 0u;
+		const std::size_t jobCount   = (args.size() >= 3) ? std::stoul(args[2]) : 10000;
+		const std::size_t iterations = (args.size() >= 4) ? std::stoul(args[3]) : 20;
+		JobsBenchmark::run(threadCount, jobCount, iterations);
+		return 0;
+	}
+	if (command == "transforms-benchmark") {
+		TransformsBenchmark::run((args.size() >= 2) ? std::stoul(args[1]) : 20);
+		return 0;
+	}
+
+	printUsage();
+	return 1;
+}
@@ -0,0 +1,81 @@
+#include "JobsBenchmark.h"
+
+#include <Morrigu.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	[[nodiscard]] double measureNanoseconds(std::size_t iterations, auto&& function)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) { function(); }
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<double, std::nano>{end - start}.count() / static_cast<double>(iterations);
+	}
+
+	// Splits the range in two until it is a single job, so that most jobs are spawned by other jobs and idle threads have to steal them
+	void splitRecursively(std::size_t count, MRG::JobCounter& counter, std::atomic<std::size_t>& executedJobs)
+	{
+		if (count <= 1) {
+			executedJobs.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		const auto half = count / 2;
+		MRG::Jobs::run([half, &counter, &executedJobs]() { splitRecursively(half, counter, executedJobs); }, &counter);
+		splitRecursively(count - half, counter, executedJobs);
+	}
+
+	[[nodiscard]] float simulateWork(float value)
+	{
+		for (int i = 0; i < 64; ++i) { value = std::sqrt(value * value + 1.f); }
+		return value;
+	}
+}  // namespace
+
+namespace JobsBenchmark
+{
+	void run(uint32_t threadCount, std::size_t jobCount, std::size_t iterations)
+	{
+		MRG::Jobs::init(threadCount);
+		MRG_INFO("Job system benchmark ({} threads, {} jobs, average of {} iterations):", MRG::Jobs::getThreadCount(), jobCount, iterations)
+
+		std::atomic<std::size_t> executedJobs{0};
+		const auto spawnTime = measureNanoseconds(iterations, [jobCount, &executedJobs]() {
+			MRG::JobCounter counter{};
+			for (std::size_t i = 0; i < jobCount; ++i) {
+				MRG::Jobs::run([&executedJobs]() { executedJobs.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+			MRG::Jobs::wait(counter);
+		});
+		MRG_INFO("\tSpawn and wait (main thread): {:>9.1f}ns/job", spawnTime / static_cast<double>(jobCount))
+
+		const auto stealTime = measureNanoseconds(iterations, [jobCount, &executedJobs]() {
+			MRG::JobCounter counter{};
+			MRG::Jobs::run([jobCount, &counter, &executedJobs]() { splitRecursively(jobCount, counter, executedJobs); }, &counter);
+			MRG::Jobs::wait(counter);
+		});
+		MRG_INFO("\tRecursive split (stealing):   {:>9.1f}ns/job", stealTime / static_cast<double>(jobCount))
+		MRG_ASSERT(executedJobs.load() == 2 * jobCount * iterations, "Some jobs were not executed!")
+
+		std::vector<float> values(jobCount * 64, 1.f);
+		const auto serialTime = measureNanoseconds(iterations, [&values]() {
+			for (auto& value : values) { value = simulateWork(value); }
+		});
+		const auto parallelTime = measureNanoseconds(iterations, [&values]() {
+			MRG::Jobs::parallelFor(values.size(), 1024, [&values](std::size_t index) { values[index] = simulateWork(values[index]); });
+		});
+		MRG_INFO("\tparallelFor ({} elements):   serial: {:>9.3f}ms | parallel: {:>9.3f}ms | speedup: x{:.1f}",
+		         values.size(),
+		         serialTime / 1e6,
+		         parallelTime / 1e6,
+		         serialTime / parallelTime)
+
+		MRG::Jobs::shutdown();
+	}
+}  // namespace JobsBenchmark
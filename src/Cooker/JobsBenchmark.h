@@ -0,0 +1,13 @@
+#ifndef JOBS_BENCHMARK_H
+#define JOBS_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace JobsBenchmark
+{
+	// Measures the overhead of spawning, stealing and waiting on jobs, and the speedup of parallelFor over a serial loop
+	void run(uint32_t threadCount, std::size_t jobCount, std::size_t iterations);
+}  // namespace JobsBenchmark
+
+#endif
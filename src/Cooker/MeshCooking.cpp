@@ -0,0 +1,94 @@
+#include "MeshCooking.h"
+
+#include <Morrigu.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	template<MRG::Vertex VertexType>
+	bool cookMeshes(const std::vector<std::string>& meshFiles)
+	{
+		bool success = true;
+		for (const auto& meshFile : meshFiles) {
+			const auto mesh       = MRG::Utils::Meshes::loadMeshFromFile<VertexType>(meshFile.c_str());
+			const auto outputPath = MRG::Utils::Meshes::getCookedMeshPath(meshFile.c_str());
+			if (!MRG::Utils::Meshes::cookMesh(*mesh, outputPath)) {
+				success = false;
+				continue;
+			}
+
+			MRG_INFO("Cooked \"{}\" into \"{}\" ({} vertices, {} indices)", meshFile, outputPath, mesh->vertices.size(), mesh->indices.size())
+		}
+
+		return success;
+	}
+
+	[[nodiscard]] float measureMilliseconds(std::size_t iterations, auto&& function)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) { function(); }
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<float, std::milli>{end - start}.count() / static_cast<float>(iterations);
+	}
+}  // namespace
+
+namespace MeshCooking
+{
+	bool cook(const std::string& vertexType, const std::vector<std::string>& meshFiles)
+	{
+		if (vertexType == "basic") { return cookMeshes<MRG::BasicVertex>(meshFiles); }
+		if (vertexType == "colored") { return cookMeshes<MRG::ColoredVertex>(meshFiles); }
+		if (vertexType == "textured") { return cookMeshes<MRG::TexturedVertex>(meshFiles); }
+
+		MRG_ERROR("Unknown vertex type \"{}\" (expected basic, colored or textured)", vertexType)
+		return false;
+	}
+
+	void benchmark(std::vector<std::string> meshFiles, std::size_t iterations)
+	{
+		if (meshFiles.empty()) {
+			meshFiles = {
+			  "monkey_smooth.obj",
+			  "engine/cube.obj",
+			  "engine/cylinder.obj",
+			  "engine/disk.obj",
+			  "engine/sphere.obj",
+			  "engine/torus.obj",
+			};
+		}
+
+		MRG_INFO("Mesh load times (textured vertices, average of {} iterations):", iterations)
+		for (const auto& meshFile : meshFiles) {
+			if (!MRG::Utils::Meshes::loadCookedMesh<MRG::TexturedVertex>(meshFile.c_str()).has_value() &&
+			    !cookMeshes<MRG::TexturedVertex>({meshFile})) {
+				MRG_ERROR("Failed to cook \"{}\", skipping it", meshFile)
+				continue;
+			}
+
+			const auto objTime = measureMilliseconds(iterations, [&meshFile]() {
+				const auto mesh = MRG::Utils::Meshes::loadMeshFromFile<MRG::TexturedVertex>(meshFile.c_str());
+				// Simulates the copy to the staging buffer
+				std::vector<std::byte> staging(mesh->vertices.size() * sizeof(MRG::TexturedVertex) + mesh->indices.size() * sizeof(uint32_t));
+				std::memcpy(staging.data(), mesh->vertices.data(), mesh->vertices.size() * sizeof(MRG::TexturedVertex));
+				std::memcpy(staging.data() + mesh->vertices.size() * sizeof(MRG::TexturedVertex),
+				            mesh->indices.data(),
+				            mesh->indices.size() * sizeof(uint32_t));
+			});
+			const auto cookedTime = measureMilliseconds(iterations, [&meshFile]() {
+				const auto cookedMesh = MRG::Utils::Meshes::loadCookedMesh<MRG::TexturedVertex>(meshFile.c_str());
+				std::vector<std::byte> staging(cookedMesh->vertexData.size() + cookedMesh->indexData.size());
+				std::memcpy(staging.data(), cookedMesh->vertexData.data(), cookedMesh->vertexData.size());
+				std::memcpy(staging.data() + cookedMesh->vertexData.size(), cookedMesh->indexData.data(), cookedMesh->indexData.size());
+			});
+
+			MRG_INFO("\t{:<24} OBJ: {:>9.3f}ms | cooked: {:>7.3f}ms | speedup: x{:.1f}",
+			         meshFile,
+			         static_cast<double>(objTime),
+			         static_cast<double>(cookedTime),
+			         static_cast<double>(objTime / cookedTime))
+		}
+	}
+}  // namespace MeshCooking
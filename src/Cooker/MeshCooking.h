@@ -0,0 +1,16 @@
+#ifndef MESH_COOKING_H
+#define MESH_COOKING_H
+
+#include <string>
+#include <vector>
+
+namespace MeshCooking
+{
+	// Cooks every given mesh (paths relative to the meshes folder) using the requested vertex type ("basic", "colored" or "textured")
+	[[nodiscard]] bool cook(const std::string& vertexType, const std::vector<std::string>& meshFiles);
+
+	// Compares the load times of the source and cooked versions of the given meshes, cooking them first if needed
+	void benchmark(std::vector<std::string> meshFiles, std::size_t iterations);
+}  // namespace MeshCooking
+
+#endif
@@ -0,0 +1,152 @@
+#include "TextureCooking.h"
+
+#include "BlockCompression.h"
+
+#include <Morrigu.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+	struct CookingFormat
+	{
+		std::string_view name;
+		vk::Format format;
+		// Mip levels of sRGB textures are filtered in linear space
+		bool isSRGB;
+		std::vector<std::byte> (*compress)(std::span<const std::byte>, uint32_t, uint32_t);
+	};
+
+	const std::array<CookingFormat, 5> cookingFormats{{
+	  {"bc1", vk::Format::eBc1RgbSrgbBlock, true, BlockCompression::compressBC1},
+	  {"bc1-linear", vk::Format::eBc1RgbUnormBlock, false, BlockCompression::compressBC1},
+	  {"bc5", vk::Format::eBc5UnormBlock, false, BlockCompression::compressBC5},
+	  {"bc7", vk::Format::eBc7SrgbBlock, true, BlockCompression::compressBC7},
+	  {"bc7-linear", vk::Format::eBc7UnormBlock, false, BlockCompression::compressBC7},
+	}};
+
+	[[nodiscard]] const CookingFormat* findCookingFormat(std::string_view name)
+	{
+		const auto cookingFormat = std::ranges::find(cookingFormats, name, &CookingFormat::name);
+		return (cookingFormat != cookingFormats.end()) ? &*cookingFormat : nullptr;
+	}
+
+	bool cookTextures(const CookingFormat& cookingFormat, const std::vector<std::string>& textureFiles)
+	{
+		bool success = true;
+		for (const auto& textureFile : textureFiles) {
+			MRG::MipChain mipChain{};
+			try {
+				mipChain = MRG::loadMipChain((MRG::Folders::Rendering::texturesFolder + textureFile).c_str(), cookingFormat.isSRGB);
+			} catch (const std::runtime_error& error) {
+				MRG_ERROR("{}", error.what())
+				success = false;
+				continue;
+			}
+
+			MRG::MipChain compressedChain{};
+			for (uint32_t level = 0; level < mipChain.getLevelCount(); ++level) {
+				const auto& mipLevel       = mipChain.levels[level];
+				const auto compressedLevel = cookingFormat.compress(mipChain.getLevelData(level), mipLevel.width, mipLevel.height);
+				compressedChain.levels.push_back(MRG::MipLevel{
+				  .width  = mipLevel.width,
+				  .height = mipLevel.height,
+				  .offset = compressedChain.data.size(),
+				  .size   = compressedLevel.size(),
+				});
+				compressedChain.data.insert(compressedChain.data.end(), compressedLevel.begin(), compressedLevel.end());
+			}
+
+			const auto outputPath = MRG::Utils::Textures::getCookedTexturePath(textureFile.c_str());
+			if (!MRG::Utils::Textures::cookTexture(compressedChain, cookingFormat.format, outputPath)) {
+				success = false;
+				continue;
+			}
+
+			MRG_INFO("Cooked \"{}\" into \"{}\" ({}x{}, {} levels, {} KiB instead of {} KiB)",
+			         textureFile,
+			         outputPath,
+			         mipChain.levels.front().width,
+			         mipChain.levels.front().height,
+			         mipChain.getLevelCount(),
+			         compressedChain.data.size() / 1024,
+			         mipChain.data.size() / 1024)
+		}
+
+		return success;
+	}
+
+	[[nodiscard]] float measureMilliseconds(std::size_t iterations, auto&& function)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) { function(); }
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<float, std::milli>{end - start}.count() / static_cast<float>(iterations);
+	}
+}  // namespace
+
+namespace TextureCooking
+{
+	bool cook(const std::string& format, const std::vector<std::string>& textureFiles)
+	{
+		const auto* cookingFormat = findCookingFormat(format);
+		if (cookingFormat == nullptr) {
+			MRG_ERROR("Unknown texture format \"{}\" (expected bc1, bc1-linear, bc5, bc7 or bc7-linear)", format)
+			return false;
+		}
+
+		return cookTextures(*cookingFormat, textureFiles);
+	}
+
+	void benchmark(std::vector<std::string> textureFiles, std::size_t iterations)
+	{
+		if (textureFiles.empty()) { textureFiles = {"brick.jpg", "leaf.jpg", "engine/default.png"}; }
+
+		MRG_INFO("Texture load times (whole mip chain, average of {} iterations):", iterations)
+		for (const auto& textureFile : textureFiles) {
+			if (!MRG::Utils::Textures::loadCookedTexture(textureFile.c_str()).has_value() &&
+			    !cookTextures(*findCookingFormat("bc7"), {textureFile})) {
+				MRG_ERROR("Failed to cook \"{}\", skipping it", textureFile)
+				continue;
+			}
+
+			const auto sourcePath  = MRG::Folders::Rendering::texturesFolder + textureFile;
+			const auto sourceSize  = MRG::loadMipChain(sourcePath.c_str(), true).data.size();
+			std::size_t cookedSize = 0;
+			const auto levels      = MRG::Utils::Textures::loadCookedTexture(textureFile.c_str())->levels;
+			for (const auto& level : levels) { cookedSize += level.size; }
+
+			// Both versions are copied into a buffer, simulating the copy to the staging buffer
+			const auto sourceTime = measureMilliseconds(iterations, [&sourcePath]() {
+				const auto mipChain = MRG::loadMipChain(sourcePath.c_str(), true);
+				std::vector<std::byte> staging(mipChain.data.size());
+				std::memcpy(staging.data(), mipChain.data.data(), mipChain.data.size());
+			});
+			const auto cookedTime = measureMilliseconds(iterations, [&textureFile, cookedSize]() {
+				const auto cookedTexture = MRG::Utils::Textures::loadCookedTexture(textureFile.c_str());
+				const auto fileData      = cookedTexture->file.getData();
+				std::vector<std::byte> staging(cookedSize);
+				std::size_t offset = 0;
+				for (const auto& level : cookedTexture->levels) {
+					std::memcpy(staging.data() + offset, fileData.data() + level.offset, level.size);
+					offset += level.size;
+				}
+			});
+
+			MRG_INFO("\t{:<24} source: {:>9.3f}ms | cooked: {:>7.3f}ms | speedup: x{:.1f} | VRAM: {:>6} KiB -> {:>6} KiB (x{:.1f})",
+			         textureFile,
+			         static_cast<double>(sourceTime),
+			         static_cast<double>(cookedTime),
+			         static_cast<double>(sourceTime / cookedTime),
+			         sourceSize / 1024,
+			         cookedSize / 1024,
+			         static_cast<double>(sourceSize) / static_cast<double>(cookedSize))
+		}
+	}
+}  // namespace TextureCooking
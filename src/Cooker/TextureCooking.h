@@ -0,0 +1,18 @@
+#ifndef TEXTURE_COOKING_H
+#define TEXTURE_COOKING_H
+
+#include <string>
+#include <vector>
+
+namespace TextureCooking
+{
+	// Cooks every given texture (paths relative to the textures folder) into the requested block compressed format: "bc1" or "bc7" for
+	// color textures, "bc1-linear" or "bc7-linear" for other data stored as colors, and "bc5" for normal maps
+	[[nodiscard]] bool cook(const std::string& format, const std::vector<std::string>& textureFiles);
+
+	// Compares the load times and VRAM sizes of the source and cooked versions of the given textures, cooking them first (as BC7) if
+	// needed
+	void benchmark(std::vector<std::string> textureFiles, std::size_t iterations);
+}  // namespace TextureCooking
+
+#endif
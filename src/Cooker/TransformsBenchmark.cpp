@@ -0,0 +1,74 @@
+#include "TransformsBenchmark.h"
+
+#include <Morrigu.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace
+{
+	[[nodiscard]] double measureNanoseconds(std::size_t iterations, auto&& function)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) { function(); }
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<double, std::nano>{end - start}.count() / static_cast<double>(iterations);
+	}
+
+	[[nodiscard]] float maxDifference(const std::vector<glm::mat4>& lhs, const std::vector<glm::mat4>& rhs)
+	{
+		float difference = 0.f;
+		for (std::size_t i = 0; i < lhs.size(); ++i) {
+			for (glm::length_t column = 0; column < 4; ++column) {
+				const auto columnDifference = glm::abs(lhs[i][column] - rhs[i][column]);
+
+				difference = std::max({difference, columnDifference.x, columnDifference.y, columnDifference.z, columnDifference.w});
+			}
+		}
+		return difference;
+	}
+}  // namespace
+
+namespace TransformsBenchmark
+{
+	void run(std::size_t iterations)
+	{
+		std::mt19937 generator{42};
+		std::uniform_real_distribution<float> translations{-100.f, 100.f};
+		std::uniform_real_distribution<float> rotations{-glm::pi<float>(), glm::pi<float>()};
+		std::uniform_real_distribution<float> scales{0.1f, 10.f};
+
+		MRG_INFO("Transform composition (average of {} iterations):", iterations)
+		for (const std::size_t count : std::array<std::size_t, 3>{1'000, 10'000, 100'000}) {
+			std::vector<MRG::Transform> transforms(count);
+			MRG::Utils::Maths::TransformArrays transformArrays{};
+			transformArrays.reserve(count);
+			for (auto& transform : transforms) {
+				transform.translation = {translations(generator), translations(generator), translations(generator)};
+				transform.rotation    = {rotations(generator), rotations(generator), rotations(generator)};
+				transform.scale       = {scales(generator), scales(generator), scales(generator)};
+				transformArrays.push(transform.translation, transform.rotation, transform.scale);
+			}
+
+			std::vector<glm::mat4> perTransformMatrices(count);
+			const auto perTransformTime = measureNanoseconds(iterations, [&transforms, &perTransformMatrices]() {
+				for (std::size_t i = 0; i < transforms.size(); ++i) { perTransformMatrices[i] = transforms[i].getTransform(); }
+			});
+			std::vector<glm::mat4> batchedMatrices(count);
+			const auto batchedTime = measureNanoseconds(iterations, [&transformArrays, &batchedMatrices]() {
+				MRG::Utils::Maths::composeTransforms(transformArrays, batchedMatrices);
+			});
+
+			MRG_INFO("\t{:>7} transforms | per transform: {:>7.2f}ns | batched: {:>7.2f}ns | speedup: x{:.1f} | max difference: {:.2e}",
+			         count,
+			         perTransformTime / static_cast<double>(count),
+			         batchedTime / static_cast<double>(count),
+			         perTransformTime / batchedTime,
+			         static_cast<double>(maxDifference(perTransformMatrices, batchedMatrices)))
+		}
+	}
+}  // namespace TransformsBenchmark
@@ -0,0 +1,12 @@
+#ifndef TRANSFORMS_BENCHMARK_H
+#define TRANSFORMS_BENCHMARK_H
+
+#include <cstddef>
+
+namespace TransformsBenchmark
+{
+	// Compares the per transform glm path (Transform::getTransform) with the batched composition kernel, at 1k, 10k and 100k transforms
+	void run(std::size_t iterations);
+}  // namespace TransformsBenchmark
+
+#endif
@@ -37,24 +37,22 @@ public:
 		torus.setName("Torus");
 		auto torusMesh = MRG::Utils::Meshes::torus<MRG::TexturedVertex>();
 		uploadMesh(torusMesh);
-		auto& torusMRC = torus.addComponent<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(createMeshRenderer(torusMesh, material));
-		auto& torusTC  = torus.getComponent<MRG::Components::Transform>();
-		torusTC.translation = {1.5f, 0.f, 0.f};
-		torusMRC.updateTransform(torusTC.getTransform());
+		torus.addComponent<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(createMeshRenderer(torusMesh, material));
+		torus.getComponent<MRG::Components::Transform>().setTranslation({1.5f, 0.f, 0.f});
 
 		auto cylinder = m_activeScene.createEntity();
 		cylinder.setName("Cylinder");
 		auto cylinderMesh = MRG::Utils::Meshes::cylinder<MRG::TexturedVertex>();
 		uploadMesh(cylinderMesh);
-		auto& cylinderMRC =
-		  cylinder.addComponent<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(createMeshRenderer(cylinderMesh, material));
-		auto& cylinderTC       = cylinder.getComponent<MRG::Components::Transform>();
-		cylinderTC.translation = {-1.5f, 0.f, 0.f};
-		cylinderMRC.updateTransform(cylinderTC.getTransform());
+		cylinder.addComponent<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(createMeshRenderer(cylinderMesh, material));
+		cylinder.getComponent<MRG::Components::Transform>().setTranslation({-1.5f, 0.f, 0.f});
 	}
 
 	void onUpdate(MRG::Timestep ts) override
 	{
+		// Update transforms
+		MRG::Transforms::update<MRG::TexturedVertex>(*m_activeScene.registry);
+
 		// Update viewport
 		m_viewport->onUpdate(*m_activeScene.registry, ts);
 	}
@@ -123,6 +121,14 @@ public:
 			ImGui::TextColored(
 			  color, "Frametime: %2.5fms (%3.2f fps)", static_cast<double>(ts.getMilliseconds()), static_cast<double>(1.f / ts));
 
+			const auto& stats = application->renderer->getFrameStatistics();
+			ImGui::Text("Draw calls: %u (%u instances)", stats.drawCalls, stats.instances);
+			ImGui::Text("Pipeline binds: %u", stats.pipelineBinds);
+			ImGui::Text("Descriptor set binds: %u", stats.descriptorSetBinds);
+			ImGui::Text("Vertex buffer binds: %u", stats.vertexBufferBinds);
+			ImGui::Text("Visible objects: %u (%u culled)", stats.visibleObjects, stats.culledObjects);
+			ImGui::Checkbox("Sort draws", &application->renderer->spec.sortDraws);
+
 			const auto& entity = m_activeScene.selectedEntity;
 			if (entity != entt::null) {
 				ImGui::Text("Selected entity ID: %d (%s)",
@@ -28,6 +28,12 @@ void MaterialEditorLayer::onImGuiUpdate(MRG::Timestep)
 	if (m_editedMaterial) {
 		std::size_t index = 0;
 		for (const auto& ubo : m_editedMaterial->shader->l2UBOData) {
+			// Texture indices are set when binding textures to the material
+			if (m_editedMaterial->shader->l2TextureIndices.contains(ubo.first)) {
+				++index;
+				continue;
+			}
+
 			m_rwHead = m_data[index].data();
 			if (ImGui::TreeNode(ubo.second.name.c_str())) {
 				for (const auto& member : ubo.second.members) { renderData(member); }
@@ -15,12 +15,22 @@ void HierarchyPanel::onImGuiUpdate(entt::registry& registry, const entt::entity
 
 		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, {0.f, 0.f});
 		ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, {0.f, 5.f});
-		registry.each(
-		  [this, &registry, selectedEntity](const entt::entity entity) { renderEntity(registry, entity, entity == selectedEntity); });
+		// Children are rendered by their parent
+		registry.each([this, &registry, selectedEntity](const entt::entity entity) {
+			if (registry.get<MRG::Components::Transform>(entity).getParent() != entt::null) { return; }
+			renderEntity(registry, entity, selectedEntity);
+		});
 		if (ImGui::IsMouseDown(MRG::Mouse::ButtonLeft) && ImGui::IsWindowHovered()) { modifySelectedEntity(entt::null); }
 		ImGui::PopStyleVar(2);
 	}
 
+	if (m_parentChange) {
+		const auto [child, parent] = m_parentChange.value();
+		MRG::Transforms::setParent(registry, child, parent);
+
+		m_parentChange.reset();
+	}
+
 	if (m_entityToDelete) {
 		const auto handle = m_entityToDelete.value();
 		if (selectedEntity == handle) { modifySelectedEntity(entt::null); }
@@ -32,21 +42,46 @@ void HierarchyPanel::onImGuiUpdate(entt::registry& registry, const entt::entity
 	ImGui::End();
 }
 
-void HierarchyPanel::renderEntity(entt::registry& registry, const entt::entity entity, bool isSelected)
+void HierarchyPanel::renderEntity(entt::registry& registry, const entt::entity entity, const entt::entity selectedEntity)
 {
-	int flags = ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding;
-	if (isSelected) { flags |= ImGuiTreeNodeFlags_Selected; }
+	const auto& transform = registry.get<MRG::Components::Transform>(entity);
+
+	int flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding | ImGuiTreeNodeFlags_DefaultOpen;
+	if (transform.getFirstChild() == entt::null) { flags |= ImGuiTreeNodeFlags_Leaf; }
+	if (entity == selectedEntity) { flags |= ImGuiTreeNodeFlags_Selected; }
 
 	// I pray that God forgives ImGui, because he sure knows I can't
 	const auto& tc    = registry.get<MRG::Components::Tag>(entity);
 	const auto opened = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<intptr_t>(entity)), flags, "%s", tc.tag.c_str());
 	if (ImGui::IsItemClicked()) { modifySelectedEntity(entity); }
+	if (ImGui::BeginDragDropSource()) {
+		ImGui::SetDragDropPayload("HIERARCHY_ENTITY", &entity, sizeof(entity));
+		ImGui::Text("%s", tc.tag.c_str());
+		ImGui::EndDragDropSource();
+	}
+	if (ImGui::BeginDragDropTarget()) {
+		if (const auto* payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY")) {
+			const auto droppedEntity = *static_cast<const entt::entity*>(payload->Data);
+			if (droppedEntity != entity) { m_parentChange = std::make_pair(droppedEntity, entity); }
+		}
+		ImGui::EndDragDropTarget();
+	}
 	if (ImGui::BeginPopupContextItem("Entity options popup", ImGuiPopupFlags_MouseButtonRight)) {
+		if (transform.getParent() != entt::null && ImGui::MenuItem("Detach from parent")) {
+			m_parentChange = std::make_pair(entity, entt::entity{entt::null});
+		}
 		if (ImGui::MenuItem("Delete entity")) { m_entityToDelete = entity; }
 
 		ImGui::EndPopup();
 	}
-	if (opened) { ImGui::TreePop(); }
+	if (opened) {
+		auto child = transform.getFirstChild();
+		while (child != entt::null) {
+			renderEntity(registry, child, selectedEntity);
+			child = registry.get<MRG::Components::Transform>(child).getNextSibling();
+		}
+		ImGui::TreePop();
+	}
 }
 
 void HierarchyPanel::modifySelectedEntity(const entt::entity entity) { callbacks.entitySelected(entity); }
@@ -10,6 +10,7 @@
 #include <functional>
 #include <map>
 #include <optional>
+#include <utility>
 
 class HierarchyPanel
 {
@@ -25,8 +26,10 @@ public:
 
 private:
 	std::optional<entt::entity> m_entityToDelete{};
+	// Child and new parent (entt::null to detach it), applied after the hierarchy is rendered
+	std::optional<std::pair<entt::entity, entt::entity>> m_parentChange{};
 
-	void renderEntity(entt::registry& registry, const entt::entity entity, bool isSelected);
+	void renderEntity(entt::registry& registry, const entt::entity entity, const entt::entity selectedEntity);
 	void modifySelectedEntity(const entt::entity entity);
 };
 
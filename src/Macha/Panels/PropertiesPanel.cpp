@@ -32,9 +32,12 @@ namespace
 		}
 	}  // namespace ImGuiUtils
 
-	void
+	// Returns true if the values were modified
+	bool
 	drawVec3Controls(const std::string& id, const std::string& label, glm::vec3& values, float resetValue = 0.f, float columnWidth = 100.f)
 	{
+		bool isModified = false;
+
 		ImGuiIO& io   = ImGui::GetIO();
 		auto boldFont = io.Fonts->Fonts[0];
 
@@ -55,12 +58,15 @@ namespace
 		ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.9f, 0.2f, 0.2f, 1.0f});
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.8f, 0.1f, 0.15f, 1.0f});
 		ImGui::PushFont(boldFont);
-		if (ImGui::Button("X", buttonSize)) values.x = resetValue;
+		if (ImGui::Button("X", buttonSize)) {
+			values.x   = resetValue;
+			isModified = true;
+		}
 		ImGui::PopFont();
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
+		isModified |= ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
 		ImGui::PopItemWidth();
 		ImGui::SameLine();
 
@@ -68,12 +74,15 @@ namespace
 		ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.3f, 0.8f, 0.3f, 1.0f});
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.2f, 0.7f, 0.2f, 1.0f});
 		ImGui::PushFont(boldFont);
-		if (ImGui::Button("Y", buttonSize)) values.y = resetValue;
+		if (ImGui::Button("Y", buttonSize)) {
+			values.y   = resetValue;
+			isModified = true;
+		}
 		ImGui::PopFont();
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
+		isModified |= ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
 		ImGui::PopItemWidth();
 		ImGui::SameLine();
 
@@ -81,12 +90,15 @@ namespace
 		ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.2f, 0.35f, 0.9f, 1.0f});
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.1f, 0.25f, 0.8f, 1.0f});
 		ImGui::PushFont(boldFont);
-		if (ImGui::Button("Z", buttonSize)) values.z = resetValue;
+		if (ImGui::Button("Z", buttonSize)) {
+			values.z   = resetValue;
+			isModified = true;
+		}
 		ImGui::PopFont();
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
+		isModified |= ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
 		ImGui::PopItemWidth();
 
 		ImGui::PopStyleVar();
@@ -94,6 +106,8 @@ namespace
 		ImGui::Columns(1);
 
 		ImGui::PopID();
+
+		return isModified;
 	}
 
 	void renderUBOData(const MRG::Shader::Node& node, std::byte*& rwHead)
@@ -137,7 +151,7 @@ namespace
 	}
 
 	[[nodiscard]] bool editMeshRendererComponent(MRG::Components::MeshRenderer<MRG::TexturedVertex>& mrc,
-	                                             MRG::Components::Transform& tc,
+	                                             const MRG::Components::Transform& tc,
 	                                             Components::EntitySettings& esc,
 	                                             AssetRegistry& assets,
 	                                             MRG::Renderer& renderer)
@@ -165,10 +179,7 @@ namespace
 					    .string();
 					MRG_ENGINE_TRACE("Drag and drop payload to mesh received: {}", meshPath)
 
-					auto mesh = MRG::Utils::Meshes::loadMeshFromFile<MRG::TexturedVertex>(meshPath.c_str());
-					renderer.uploadMesh(mesh);
-
-					mrc.mesh = mesh;
+					mrc.mesh = renderer.loadMesh<MRG::TexturedVertex>(meshPath.c_str());
 				}
 
 				ImGui::EndDragDropTarget();
@@ -178,9 +189,10 @@ namespace
 			ImGui::Checkbox("Visible", &mrc.isVisible);
 
 			ImGuiUtils::subsectionHeader("Offset transform");
-			drawVec3Controls("MRC.t", "Translation", mrc.offset.translation);
-			drawVec3Controls("MRC.r", "Rotation", mrc.offset.rotation);
-			drawVec3Controls("MRC.s", "Scale", mrc.offset.scale, 1.f);
+			bool isOffsetModified = drawVec3Controls("MRC.t", "Translation", mrc.offset.translation);
+			isOffsetModified |= drawVec3Controls("MRC.r", "Rotation", mrc.offset.rotation);
+			isOffsetModified |= drawVec3Controls("MRC.s", "Scale", mrc.offset.scale, 1.f);
+			if (isOffsetModified) { mrc.updateTransform(tc.getWorldMatrix()); }
 
 			ImGuiUtils::subsectionHeader("L3 material parameters (Per entity)");
 			ImGuiUtils::centeredText("Uniform data");
@@ -194,6 +206,12 @@ namespace
 			}
 			std::size_t index = 0;
 			for (const auto& ubo : mrc.material->shader->l3UBOData) {
+				// Texture indices are set through the texture bindings below
+				if (mrc.material->shader->l3TextureIndices.contains(ubo.first)) {
+					++index;
+					continue;
+				}
+
 				auto* rwHead = esc.uboData[index].data();
 				if (ImGui::TreeNode(ubo.second.name.c_str())) {
 					for (const auto& member : ubo.second.members) { renderUBOData(member, rwHead); }
@@ -206,7 +224,10 @@ namespace
 
 			ImGuiUtils::centeredText("Textures bindings");
 			for (const auto& textureBindingInfo : mrc.sampledImages) {
-				const auto name = mrc.material->shader->l3ImageBindings[textureBindingInfo.first].name.c_str();
+				const auto& shader = *mrc.material->shader;
+				const auto name    = shader.l3ImageBindings.contains(textureBindingInfo.first)
+				                       ? shader.l3ImageBindings.at(textureBindingInfo.first).name.c_str()
+				                       : shader.l3TextureIndices.at(textureBindingInfo.first).name.c_str();
 				ImGui::PushID(name);
 				ImGui::Text("%s: %s", name, textureBindingInfo.second->path.c_str());
 				if (ImGui::BeginDragDropTarget()) {
@@ -232,7 +253,6 @@ namespace
 				ImGui::PopID();
 			}
 		}
-		mrc.updateTransform(tc.getTransform());
 		return false;
 	}
 }  // namespace
@@ -269,9 +289,11 @@ namespace PropertiesPanel
 			auto& tc  = registry.get<MRG::Components::Transform>(selectedEntity);
 			auto& esc = registry.get<Components::EntitySettings>(selectedEntity);
 			ImGuiUtils::centeredText("Transform");
-			drawVec3Controls("TC.t", "Translation", tc.translation);
-			drawVec3Controls("TC.r", "Rotation", tc.rotation);
-			drawVec3Controls("TC.s", "Scale", tc.scale, 1.f);
+			auto local               = tc.getLocal();
+			bool isTransformModified = drawVec3Controls("TC.t", "Translation", local.translation);
+			isTransformModified |= drawVec3Controls("TC.r", "Rotation", local.rotation);
+			isTransformModified |= drawVec3Controls("TC.s", "Scale", local.scale, 1.f);
+			if (isTransformModified) { tc.setLocal(local); }
 
 			if (registry.all_of<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(selectedEntity)) {
 				auto& mrc = registry.get<MRG::Components::MeshRenderer<MRG::TexturedVertex>>(selectedEntity);
@@ -88,7 +88,7 @@ void Viewport::onImGuiUpdate(entt::entity selectedEntity, entt::registry& regist
 
 		if (selectedEntity != entt::null) {
 			auto& tc       = registry.get<MRG::Components::Transform>(selectedEntity);
-			auto transform = tc.getTransform();
+			auto transform = tc.getWorldMatrix();
 
 			const auto windowPos = ImGui::GetWindowPos();
 			ImGuizmo::SetRect(windowPos.x, windowPos.y, m_size.x, m_size.y);
@@ -103,10 +103,11 @@ void Viewport::onImGuiUpdate(entt::entity selectedEntity, entt::registry& regist
 			                     nullptr,
 			                     ImGui::IsKeyDown(MRG::Key::LeftControl) ? snapValues.data() : nullptr);
 			if (ImGuizmo::IsUsing() && !ImGui::IsKeyDown(MRG::Key::LeftAlt)) {
-				auto [translation, rotation, scale] = MRG::Utils::Maths::decomposeTransform(transform);
-				tc.translation                      = translation;
-				tc.rotation                         = rotation;
-				tc.scale                            = scale;
+				if (tc.getParent() != entt::null) {
+					transform = glm::inverse(registry.get<MRG::Components::Transform>(tc.getParent()).getWorldMatrix()) * transform;
+				}
+				const auto [translation, rotation, scale] = MRG::Utils::Maths::decomposeTransform(transform);
+				tc.setLocal(MRG::Transform{.translation = translation, .rotation = rotation, .scale = scale});
 			}
 		}
 
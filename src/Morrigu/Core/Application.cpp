@@ -18,8 +18,17 @@ namespace
 
 namespace MRG
 {
-	Application::Application(ApplicationSpecification spec) : m_specification(std::move(spec))
+	Application::Application(ApplicationSpecification spec)
+	    : m_specification(std::move(spec)), glfwWrapper{m_specification.rendererSpecification.headless}
 	{
+		Jobs::init(m_specification.jobThreads);
+
+		if (m_specification.rendererSpecification.headless) {
+			MRG_ENGINE_INFO("Starting in headless mode, no window will be created")
+			renderer = createScope<Renderer>(m_specification.rendererSpecification, nullptr);
+			return;
+		}
+
 		glfwSetErrorCallback(glfwErrorCallback);
 
 		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -112,10 +121,17 @@ namespace MRG
 		renderer = createScope<Renderer>(m_specification.rendererSpecification, window);
 	}
 
+	Application::~Application()
+	{
+		// The renderer records its draws on the job system threads
+		renderer.reset();
+		Jobs::shutdown();
+	}
+
 	void Application::run()
 	{
 		while (m_isRunning) {
-			const auto time = static_cast<float>(glfwGetTime());
+			const auto time = getTime();
 			Timestep ts{time - m_lastTime};
 			elapsedTime += ts;
 			renderer->elapsedTime = elapsedTime;
@@ -123,13 +139,15 @@ namespace MRG
 
 			if (renderer->beginFrame()) {
 				for (auto& layer : m_layers) { layer->onUpdate(ts); }
-				renderer->beginImGui();
-				for (auto& layer : m_layers) { layer->onImGuiUpdate(ts); }
-				renderer->endImGui();
+				if (!renderer->spec.headless) {
+					renderer->beginImGui();
+					for (auto& layer : m_layers) { layer->onImGuiUpdate(ts); }
+					renderer->endImGui();
+				}
 				renderer->endFrame();
 			}
 
-			glfwPollEvents();
+			if (!renderer->spec.headless) { glfwPollEvents(); }
 		}
 	}
 
@@ -141,9 +159,22 @@ namespace MRG
 
 	Layer* Application::popLayer() { return m_layers.popLayer(); }
 
-	void Application::setWindowTitle(const char* title) const { glfwSetWindowTitle(renderer->window, title); }
+	void Application::setWindowTitle(const char* title) const
+	{
+		if (renderer->window != nullptr) { glfwSetWindowTitle(renderer->window, title); }
+	}
 	void Application::close() { m_isRunning = false; }
 
+	float Application::getTime() const
+	{
+		// GLFW's timer is not available in headless mode
+		if (m_specification.rendererSpecification.headless) {
+			return std::chrono::duration<float>{std::chrono::steady_clock::now() - m_startTime}.count();
+		}
+
+		return static_cast<float>(glfwGetTime());
+	}
+
 	void Application::onEvent(Event& event)
 	{
 		EventDispatcher dispatcher{event};
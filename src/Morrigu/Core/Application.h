@@ -6,11 +6,14 @@
 #define MORRIGU_APPLICATION_H
 
 #include "Core/GLFWWrapper.h"
+#include "Core/Jobs.h"
 #include "Core/LayerStack.h"
 #include "Rendering/Renderer.h"
 
 #include "Events/ApplicationEvent.h"
 
+#include <chrono>
+
 int main();
 
 namespace MRG
@@ -19,6 +22,8 @@ namespace MRG
 	{
 		std::string windowName{"Morrigu engine application"};
 		bool maximized{true};
+		// Number of threads of the job system, including the main thread. 0 uses one thread per hardware thread.
+		uint32_t jobThreads{0};
 		RendererSpecification rendererSpecification;
 	};
 
@@ -32,7 +37,7 @@ namespace MRG
 		Application& operator=(const Application&) = delete;
 		Application& operator=(Application&&) = delete;
 
-		~Application() = default;
+		~Application();
 
 		void run();
 
@@ -51,8 +56,11 @@ namespace MRG
 		bool onClose(WindowCloseEvent& resizeEvent);
 		bool onResize(WindowResizeEvent& resizeEvent) const;
 
+		[[nodiscard]] float getTime() const;
+
 		bool m_isRunning = true;
 		float m_lastTime = 0.f;
+		std::chrono::steady_clock::time_point m_startTime{std::chrono::steady_clock::now()};
 
 	public:
 		GLFWWrapper glfwWrapper;
@@ -11,8 +11,11 @@ namespace MRG::Files
 {
 	namespace Rendering
 	{
-		static const std::string vkPipelineCacheFile = ".vkPipelineCache";
-		static const std::string defaultTexture      = "engine/default.png";
+		static const std::string vkPipelineCacheFile       = ".vkPipelineCache";
+		static const std::string defaultTexture            = "engine/default.png";
+		static const std::string cookedMeshExtension       = ".mrgmesh";
+		static const std::string cookedTextureExtension    = ".ktx2";
+		static const std::string shaderReflectionExtension = ".mrgreflection";
 	}  // namespace Rendering
 }  // namespace MRG::Files
 
@@ -25,7 +28,13 @@ namespace MRG::Folders
 		static const std::string texturesFolder = assetsFolder + "textures/";
 		static const std::string fontsFolder    = assetsFolder + "fonts/";
 
+		static const std::string cookedAssetsFolder   = assetsFolder + "cooked/";
+		static const std::string cookedMeshesFolder   = cookedAssetsFolder + "meshes/";
+		static const std::string cookedTexturesFolder = cookedAssetsFolder + "textures/";
+
 		static const std::string shadersFolder = "shaders/";
+		// Generated at runtime, like the pipeline cache
+		static const std::string shaderReflectionCacheFolder = ".shaderReflectionCache/";
 	}  // namespace Rendering
 }  // namespace MRG::Folders
 
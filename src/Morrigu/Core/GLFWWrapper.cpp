@@ -10,10 +10,16 @@
 
 namespace MRG
 {
-	GLFWWrapper::GLFWWrapper()
+	GLFWWrapper::GLFWWrapper(bool isHeadless)
 	{
+		if (isHeadless) { return; }
+
 		[[maybe_unused]] const auto result = glfwInit();
 		MRG_ENGINE_ASSERT(result == GLFW_TRUE, "failed to initialise GLFW!")
+		m_isInitialized = true;
+	}
+	GLFWWrapper::~GLFWWrapper()
+	{
+		if (m_isInitialized) { glfwTerminate(); }
 	}
-	GLFWWrapper::~GLFWWrapper() { glfwTerminate(); }
 }  // namespace MRG
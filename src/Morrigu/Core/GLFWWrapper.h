@@ -10,7 +10,8 @@ namespace MRG
 	class GLFWWrapper
 	{
 	public:
-		GLFWWrapper();
+		// In headless mode, GLFW is not initialised at all, as it would fail on machines without a display
+		explicit GLFWWrapper(bool isHeadless = false);
 		~GLFWWrapper();
 
 		GLFWWrapper(const GLFWWrapper&) = delete;
@@ -18,6 +19,9 @@ namespace MRG
 
 		GLFWWrapper& operator=(const GLFWWrapper&) = delete;
 		GLFWWrapper& operator=(GLFWWrapper&&) = delete;
+
+	private:
+		bool m_isInitialized{false};
 	};
 }  // namespace MRG
 
@@ -0,0 +1,342 @@
+#include "Jobs.h"
+
+#include "Core/Core.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace
+{
+	// Both the maximum number of jobs waiting in a thread's deque and the number of jobs a thread can have in flight
+	constexpr std::size_t JOBS_PER_THREAD = 4096;
+	static_assert((JOBS_PER_THREAD & (JOBS_PER_THREAD - 1)) == 0, "JOBS_PER_THREAD must be a power of two!");
+
+	constexpr uint32_t EXTERNAL_THREAD = UINT32_MAX;
+	// Number of failed attempts to find a job before a worker goes to sleep
+	constexpr int SPIN_COUNT = 64;
+
+	struct Job
+	{
+		MRG::JobFunction function{};
+		MRG::JobCounter* counter{nullptr};
+		// Jobs are allocated from a fixed ring of slots: a slot can be reused once the job it holds was taken out of it
+		std::atomic<bool> isFree{true};
+	};
+
+	// Chase-Lev deque with a fixed capacity, following "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+	// Only the owning thread pushes and pops (at the bottom), any thread can steal (from the top).
+	class WorkStealingDeque
+	{
+	public:
+		[[nodiscard]] bool push(Job* job)
+		{
+			const auto bottom = m_bottom.load(std::memory_order_relaxed);
+			const auto top    = m_top.load(std::memory_order_acquire);
+			if (bottom - top >= static_cast<int64_t>(JOBS_PER_THREAD)) { return false; }
+
+			m_jobs[static_cast<std::size_t>(bottom) & (JOBS_PER_THREAD - 1)].store(job, std::memory_order_release);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		[[nodiscard]] Job* pop()
+		{
+			const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom) {
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			auto* job = m_jobs[static_cast<std::size_t>(bottom) & (JOBS_PER_THREAD - 1)].load(std::memory_order_acquire);
+			if (top == bottom) {
+				// Last job, thieves may be racing for it
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { job = nullptr; }
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		[[nodiscard]] Job* steal()
+		{
+			auto top = m_top.load(std::memory_order_acquire);
+			while (true) {
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const auto bottom = m_bottom.load(std::memory_order_acquire);
+				if (top >= bottom) { return nullptr; }
+
+				auto* job = m_jobs[static_cast<std::size_t>(top) & (JOBS_PER_THREAD - 1)].load(std::memory_order_acquire);
+				// Losing the race means another thread took this job, there may still be others left
+				if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_acquire)) { return job; }
+			}
+		}
+
+	private:
+		std::array<std::atomic<Job*>, JOBS_PER_THREAD> m_jobs{};
+		alignas(64) std::atomic<int64_t> m_top{0};
+		alignas(64) std::atomic<int64_t> m_bottom{0};
+	};
+
+	struct ThreadData
+	{
+		WorkStealingDeque deque{};
+		std::array<Job, JOBS_PER_THREAD> jobs{};
+		std::size_t nextJob{0};
+	};
+
+	struct Scheduler
+	{
+		std::vector<MRG::Scope<ThreadData>> threads{};
+		std::vector<std::thread> workers{};
+
+		// Jobs run from threads outside of the pool
+		std::mutex externalJobsMutex{};
+		std::deque<std::pair<MRG::JobFunction, MRG::JobCounter*>> externalJobs{};
+		std::atomic<std::size_t> externalJobCount{0};
+
+		// Incremented on every push, so that a worker about to sleep can tell whether a job was pushed since it last looked for one
+		std::atomic<uint64_t> pushCount{0};
+		std::atomic<uint32_t> sleepingWorkers{0};
+		std::mutex sleepMutex{};
+		std::condition_variable sleepCondition{};
+		bool isStopping{false};
+	};
+
+	MRG::Scope<Scheduler> s_scheduler{};
+	thread_local uint32_t s_threadIndex = EXTERNAL_THREAD;
+
+	void wakeWorker()
+	{
+		auto& scheduler = *s_scheduler;
+		scheduler.pushCount.fetch_add(1, std::memory_order_seq_cst);
+		if (scheduler.sleepingWorkers.load(std::memory_order_seq_cst) == 0) { return; }
+
+		{ std::lock_guard lock{scheduler.sleepMutex}; }
+		scheduler.sleepCondition.notify_one();
+	}
+}  // namespace
+
+namespace MRG
+{
+	void Jobs::init(uint32_t threadCount)
+	{
+		MRG_ENGINE_ASSERT(s_scheduler == nullptr, "The job system is already initialised!")
+		if (threadCount == 0) { threadCount = std::max(std::thread::hardware_concurrency(), 1u); }
+
+		s_scheduler = createScope<Scheduler>();
+		s_scheduler->threads.resize(threadCount);
+		for (auto& thread : s_scheduler->threads) { thread = createScope<ThreadData>(); }
+
+		s_threadIndex = 0;
+		s_scheduler->workers.reserve(threadCount - 1);
+		for (uint32_t threadIndex = 1; threadIndex < threadCount; ++threadIndex) {
+			s_scheduler->workers.emplace_back(workerLoop, threadIndex);
+		}
+
+		MRG_ENGINE_TRACE("Job system started with {} threads", threadCount)
+	}
+
+	void Jobs::shutdown()
+	{
+		MRG_ENGINE_ASSERT(s_scheduler != nullptr, "The job system is not initialised!")
+		{
+			std::lock_guard lock{s_scheduler->sleepMutex};
+			s_scheduler->isStopping = true;
+		}
+		s_scheduler->sleepCondition.notify_all();
+
+		for (auto& worker : s_scheduler->workers) { worker.join(); }
+		s_scheduler.reset();
+		s_threadIndex = EXTERNAL_THREAD;
+	}
+
+	void Jobs::run(JobFunction function, JobCounter* counter)
+	{
+		if (counter != nullptr) { counter->m_pendingJobs.fetch_add(1, std::memory_order_relaxed); }
+		push(std::move(function), counter);
+	}
+
+	void Jobs::runAfter(JobCounter& dependency, JobFunction function, JobCounter* counter)
+	{
+		if (counter != nullptr) { counter->m_pendingJobs.fetch_add(1, std::memory_order_relaxed); }
+
+		{
+			std::lock_guard lock{dependency.m_mutex};
+			if (dependency.m_pendingJobs.load(std::memory_order_acquire) != 0) {
+				dependency.m_continuations.push_back(JobCounter::Continuation{std::move(function), counter});
+				return;
+			}
+		}
+		push(std::move(function), counter);
+	}
+
+	void Jobs::wait(JobCounter& counter)
+	{
+		const auto threadIndex = s_threadIndex;
+		while (!counter.isDone()) {
+			if (threadIndex == EXTERNAL_THREAD || !tryRunJob(threadIndex)) { std::this_thread::yield(); }
+		}
+
+		// The last job releases the lock after its last access to the counter, which can then safely be destroyed
+		std::lock_guard lock{counter.m_mutex};
+		if (counter.m_exception != nullptr) { std::rethrow_exception(std::exchange(counter.m_exception, nullptr)); }
+	}
+
+	uint32_t Jobs::getThreadCount()
+	{
+		MRG_ENGINE_ASSERT(s_scheduler != nullptr, "The job system is not initialised!")
+		return static_cast<uint32_t>(s_scheduler->threads.size());
+	}
+
+	uint32_t Jobs::getThreadIndex()
+	{
+		MRG_ENGINE_ASSERT(s_threadIndex != EXTERNAL_THREAD, "The calling thread is not part of the job system!")
+		return s_threadIndex;
+	}
+
+	void Jobs::push(JobFunction function, JobCounter* counter)
+	{
+		MRG_ENGINE_ASSERT(s_scheduler != nullptr, "The job system is not initialised!")
+		auto& scheduler = *s_scheduler;
+
+		if (s_threadIndex == EXTERNAL_THREAD) {
+			{
+				std::lock_guard lock{scheduler.externalJobsMutex};
+				scheduler.externalJobs.emplace_back(std::move(function), counter);
+				scheduler.externalJobCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			wakeWorker();
+			return;
+		}
+
+		auto& thread = *scheduler.threads[s_threadIndex];
+		auto& job    = thread.jobs[thread.nextJob & (JOBS_PER_THREAD - 1)];
+		if (!job.isFree.load(std::memory_order_acquire)) {
+			// Every slot of this thread holds a job nobody had the time to start yet: the pool is saturated, running the job right away
+			// does not cost anything
+			execute(function, counter);
+			return;
+		}
+
+		++thread.nextJob;
+		job.isFree.store(false, std::memory_order_relaxed);
+		job.function = std::move(function);
+		job.counter  = counter;
+		// A free slot means there are less than JOBS_PER_THREAD jobs in the deque
+		[[maybe_unused]] const auto isPushed = thread.deque.push(&job);
+		MRG_ENGINE_ASSERT(isPushed, "Job deque overflow!")
+
+		wakeWorker();
+	}
+
+	void Jobs::execute(JobFunction& function, JobCounter* counter)
+	{
+		try {
+			function();
+		} catch (...) {
+			if (counter == nullptr) {
+				MRG_ENGINE_ERROR("A job run without counter threw an exception, it is ignored")
+			} else {
+				std::lock_guard lock{counter->m_mutex};
+				if (counter->m_exception == nullptr) { counter->m_exception = std::current_exception(); }
+			}
+		}
+
+		function.reset();
+		if (counter != nullptr) { complete(*counter); }
+	}
+
+	void Jobs::complete(JobCounter& counter)
+	{
+		auto pendingJobs = counter.m_pendingJobs.load(std::memory_order_relaxed);
+		while (pendingJobs > 1) {
+			if (counter.m_pendingJobs.compare_exchange_weak(
+			      pendingJobs, pendingJobs - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				return;
+			}
+		}
+
+		// Most likely the last job: the count only reaches 0 under the lock, so that waiters (who take it before returning) cannot
+		// destroy the counter while it is still being used here
+		std::vector<JobCounter::Continuation> continuations{};
+		{
+			std::lock_guard lock{counter.m_mutex};
+			if (counter.m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) { continuations.swap(counter.m_continuations); }
+		}
+
+		for (auto& continuation : continuations) { push(std::move(continuation.function), continuation.counter); }
+	}
+
+	bool Jobs::tryRunJob(uint32_t threadIndex)
+	{
+		auto& scheduler = *s_scheduler;
+
+		const auto runJob = [](Job& job) {
+			// The slot is freed before running the job, so that long jobs do not hold it
+			auto function      = std::move(job.function);
+			const auto counter = job.counter;
+			job.isFree.store(true, std::memory_order_release);
+
+			execute(function, counter);
+		};
+
+		if (auto* job = scheduler.threads[threadIndex]->deque.pop(); job != nullptr) {
+			runJob(*job);
+			return true;
+		}
+
+		if (scheduler.externalJobCount.load(std::memory_order_relaxed) != 0) {
+			std::unique_lock lock{scheduler.externalJobsMutex};
+			if (!scheduler.externalJobs.empty()) {
+				auto [function, counter] = std::move(scheduler.externalJobs.front());
+				scheduler.externalJobs.pop_front();
+				scheduler.externalJobCount.fetch_sub(1, std::memory_order_relaxed);
+				lock.unlock();
+
+				execute(function, counter);
+				return true;
+			}
+		}
+
+		const auto threadCount = scheduler.threads.size();
+		for (std::size_t offset = 1; offset < threadCount; ++offset) {
+			if (auto* job = scheduler.threads[(threadIndex + offset) % threadCount]->deque.steal(); job != nullptr) {
+				runJob(*job);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Jobs::workerLoop(uint32_t threadIndex)
+	{
+		s_threadIndex   = threadIndex;
+		auto& scheduler = *s_scheduler;
+
+		while (true) {
+			const auto pushCount = scheduler.pushCount.load(std::memory_order_seq_cst);
+
+			bool hasRunJob = false;
+			for (int attempt = 0; attempt < SPIN_COUNT && !hasRunJob; ++attempt) {
+				hasRunJob = tryRunJob(threadIndex);
+				if (!hasRunJob) { std::this_thread::yield(); }
+			}
+			if (hasRunJob) { continue; }
+
+			std::unique_lock lock{scheduler.sleepMutex};
+			if (scheduler.isStopping) { return; }
+			scheduler.sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			scheduler.sleepCondition.wait(lock, [&scheduler, pushCount]() {
+				return scheduler.isStopping || scheduler.pushCount.load(std::memory_order_seq_cst) != pushCount;
+			});
+			scheduler.sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+			if (scheduler.isStopping) { return; }
+		}
+	}
+}  // namespace MRG
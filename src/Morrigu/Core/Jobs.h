@@ -0,0 +1,200 @@
+#ifndef MORRIGU_JOBS_H
+#define MORRIGU_JOBS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MRG
+{
+	// Move only type erased callable. Callables of up to INLINE_SIZE bytes are stored inline, so that spawning a job does not allocate.
+	class JobFunction
+	{
+	public:
+		static constexpr std::size_t INLINE_SIZE = 48;
+
+		JobFunction() = default;
+		template<typename Function>
+		requires(!std::same_as<std::remove_cvref_t<Function>, JobFunction> && std::invocable<std::remove_cvref_t<Function>&>)
+		JobFunction(Function&& function)  // NOLINT(google-explicit-constructor)
+		{
+			using StoredType = std::remove_cvref_t<Function>;
+			if constexpr (sizeof(StoredType) <= INLINE_SIZE && alignof(StoredType) <= alignof(std::max_align_t) &&
+			              std::is_nothrow_move_constructible_v<StoredType>) {
+				new (m_storage.data()) StoredType(std::forward<Function>(function));
+				m_operations = &inlineOperations<StoredType>;
+			} else {
+				new (m_storage.data()) StoredType*(new StoredType(std::forward<Function>(function)));
+				m_operations = &heapOperations<StoredType>;
+			}
+		}
+		JobFunction(const JobFunction&) = delete;
+		JobFunction(JobFunction&& other) noexcept : m_operations{std::exchange(other.m_operations, nullptr)}
+		{
+			if (m_operations != nullptr) { m_operations->relocate(other.m_storage.data(), m_storage.data()); }
+		}
+		~JobFunction() { reset(); }
+
+		JobFunction& operator=(const JobFunction&) = delete;
+		JobFunction& operator=(JobFunction&& other) noexcept
+		{
+			if (this == &other) { return *this; }
+
+			reset();
+			m_operations = std::exchange(other.m_operations, nullptr);
+			if (m_operations != nullptr) { m_operations->relocate(other.m_storage.data(), m_storage.data()); }
+			return *this;
+		}
+
+		void operator()() { m_operations->invoke(m_storage.data()); }
+		[[nodiscard]] explicit operator bool() const { return m_operations != nullptr; }
+
+		void reset()
+		{
+			if (m_operations != nullptr) { std::exchange(m_operations, nullptr)->destroy(m_storage.data()); }
+		}
+
+	private:
+		struct Operations
+		{
+			void (*invoke)(std::byte* storage);
+			// Moves the callable to the uninitialised destination, and destroys the source
+			void (*relocate)(std::byte* source, std::byte* destination) noexcept;
+			void (*destroy)(std::byte* storage) noexcept;
+		};
+
+		template<typename StoredType>
+		static constexpr Operations inlineOperations{
+		  .invoke = [](std::byte* storage) { (*std::launder(reinterpret_cast<StoredType*>(storage)))(); },
+		  .relocate =
+		    [](std::byte* source, std::byte* destination) noexcept {
+			    auto* callable = std::launder(reinterpret_cast<StoredType*>(source));
+			    new (destination) StoredType(std::move(*callable));
+			    callable->~StoredType();
+		    },
+		  .destroy = [](std::byte* storage) noexcept { std::launder(reinterpret_cast<StoredType*>(storage))->~StoredType(); },
+		};
+		template<typename StoredType>
+		static constexpr Operations heapOperations{
+		  .invoke = [](std::byte* storage) { (**std::launder(reinterpret_cast<StoredType**>(storage)))(); },
+		  .relocate =
+		    [](std::byte* source, std::byte* destination) noexcept {
+			    new (destination) StoredType*(*std::launder(reinterpret_cast<StoredType**>(source)));
+		    },
+		  .destroy = [](std::byte* storage) noexcept { delete *std::launder(reinterpret_cast<StoredType**>(storage)); },
+		};
+
+		alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> m_storage;
+		const Operations* m_operations{nullptr};
+	};
+
+	// Counts the jobs run with it that are not done yet. A counter has to outlive its jobs (waiting on it is enough), and can be reused
+	// once waited on.
+	class JobCounter
+	{
+	public:
+		JobCounter()                  = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter(JobCounter&&)      = delete;
+		~JobCounter()                 = default;
+
+		JobCounter& operator=(const JobCounter&) = delete;
+		JobCounter& operator=(JobCounter&&) = delete;
+
+		[[nodiscard]] bool isDone() const { return m_pendingJobs.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class Jobs;
+
+		struct Continuation
+		{
+			JobFunction function;
+			JobCounter* counter;
+		};
+
+		std::atomic<uint32_t> m_pendingJobs{0};
+
+		// Protects everything below, and the last decrement of the pending jobs count
+		std::mutex m_mutex{};
+		std::vector<Continuation> m_continuations{};
+		std::exception_ptr m_exception{};
+	};
+
+	// Work stealing job scheduler shared by the whole engine.
+	// Every thread of the pool (the one calling init being thread 0) owns a deque it pushes the jobs it spawns to, and pops them from in
+	// LIFO order. Idle threads steal the oldest jobs of the others, and sleep when there is nothing left to steal. Waiting on a counter
+	// runs pending jobs instead of blocking, so jobs can themselves spawn and wait on other jobs.
+	class Jobs
+	{
+	public:
+		// A thread count of 0 uses one thread per hardware thread. The calling thread is part of the pool.
+		static void init(uint32_t threadCount = 0);
+		// Jobs still pending are dropped
+		static void shutdown();
+
+		// Runs the function on any thread of the pool. If a counter is given, it is incremented right away and decremented once the
+		// function returned. Threads outside of the pool can run jobs too, which are then picked up by the pool threads.
+		static void run(JobFunction function, JobCounter* counter = nullptr);
+		// Runs the function once every job of the dependency is done (right away if it already is)
+		static void runAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr);
+		// Runs other jobs until every job of the counter is done, and rethrows the first exception thrown by one of them.
+		// Threads outside of the pool do not run jobs while waiting.
+		static void wait(JobCounter& counter);
+
+		// Calls function(index) for every index in [0, count), in jobs of grainSize indices, and waits for all of them
+		template<typename Function>
+		static void parallelFor(std::size_t count, std::size_t grainSize, Function&& function)
+		{
+			grainSize = std::max(grainSize, std::size_t{1});
+
+			JobCounter counter{};
+			for (std::size_t begin = 0; begin < count; begin += grainSize) {
+				const auto end = std::min(begin + grainSize, count);
+				run(
+				  [&function, begin, end]() {
+					  for (auto index = begin; index < end; ++index) { function(index); }
+				  },
+				  &counter);
+			}
+			wait(counter);
+		}
+
+		// Calls function(entity) for every entity of an EnTT view, in jobs of grainSize entities, and waits for all of them.
+		// Components of different entities can be modified concurrently, but the view's storages must not be resized meanwhile.
+		template<typename View, typename Function>
+		requires requires(const View& view)
+		{
+			typename View::entity_type;
+			view.begin();
+			view.end();
+		}
+		static void parallelFor(const View& view, std::size_t grainSize, Function&& function)
+		{
+			const std::vector<typename View::entity_type> entities(view.begin(), view.end());
+			parallelFor(entities.size(), grainSize, [&entities, &function](std::size_t index) { function(entities[index]); });
+		}
+
+		[[nodiscard]] static uint32_t getThreadCount();
+		// Index of the calling thread in the pool, in [0, getThreadCount()). Only valid on threads of the pool.
+		[[nodiscard]] static uint32_t getThreadIndex();
+
+	private:
+		// Pushes the job without touching its counter
+		static void push(JobFunction function, JobCounter* counter);
+		static void execute(JobFunction& function, JobCounter* counter);
+		static void complete(JobCounter& counter);
+		static bool tryRunJob(uint32_t threadIndex);
+		static void workerLoop(uint32_t threadIndex);
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_JOBS_H
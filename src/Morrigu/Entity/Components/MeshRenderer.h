@@ -5,12 +5,20 @@
 #ifndef MORRIGU_COMP_MESH_RENDERER_H
 #define MORRIGU_COMP_MESH_RENDERER_H
 
+#include "Entity/Components/Transform.h"
 #include "Entity/Transform.h"
+#include "Rendering/DynamicUniformBuffer.h"
 #include "Rendering/Material.h"
 #include "Rendering/Mesh.h"
+#include "Rendering/UniformDescriptorSets.h"
 #include "Rendering/Vertex.h"
 #include "Utils/GLMIncludeHelper.h"
 
+#include <cstring>
+#include <map>
+#include <ranges>
+#include <vector>
+
 namespace MRG::Components
 {
 	template<Vertex VertexType>
@@ -20,184 +28,123 @@ namespace MRG::Components
 		struct VulkanObjects
 		{
 			vk::Device device;
-			VmaAllocator allocator;
 			const Ref<Mesh<VertexType>>& meshRef;
 			const Ref<Material<VertexType>>& materialRef;
 			const Ref<Texture>& defaultTexture;
 		};
 
-		MeshRenderer(const VulkanObjects& objs)
-		    : mesh{objs.meshRef}, material{objs.materialRef}, m_device{objs.device}, m_allocator{objs.allocator}
+		MeshRenderer(const VulkanObjects& objs) : mesh{objs.meshRef}, material{objs.materialRef}
 		{
-			// Pool creation
-			std::array<vk::DescriptorPoolSize, 2> sizes{
-			  vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
-			                         std::max(static_cast<uint32_t>(material->shader->l3UBOData.size()), 1u)},
-			  vk::DescriptorPoolSize{vk::DescriptorType::eSampledImage,
-			                         std::max(static_cast<uint32_t>(material->shader->l3ImageBindings.size()), 1u)},
-			};
-			vk::DescriptorPoolCreateInfo poolInfo{
-			  .maxSets       = 1,
-			  .poolSizeCount = static_cast<uint32_t>(sizes.size()),
-			  .pPoolSizes    = sizes.data(),
-			};
-
-			m_descriptorPool = m_device.createDescriptorPool(poolInfo);
-
-			vk::DescriptorSetAllocateInfo setAllocInfo{
-			  .descriptorPool     = m_descriptorPool,
-			  .descriptorSetCount = 1,
-			  .pSetLayouts        = &material->shader->level3DSL,
-			};
-			level3Descriptor = m_device.allocateDescriptorSets(setAllocInfo).back();
-
 			for (const auto& [bindingSlot, bindingInfo] : material->shader->l3UBOData) {
-				AllocatedBuffer newBuffer{
-				  m_allocator, bindingInfo.size, vk::BufferUsageFlagBits::eUniformBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU};
-
-				vk::DescriptorBufferInfo descriptorBufferInfo{
-				  .buffer = newBuffer.vkHandle,
-				  .offset = 0,
-				  .range  = bindingInfo.size,
-				};
-				vk::WriteDescriptorSet setWrite{
-				  .dstSet          = level3Descriptor,
-				  .dstBinding      = bindingSlot,
-				  .descriptorCount = 1,
-				  .descriptorType  = vk::DescriptorType::eUniformBuffer,
-				  .pBufferInfo     = &descriptorBufferInfo,
-				};
-
-				m_device.updateDescriptorSets(setWrite, {});
-				uniformBuffers.insert(std::make_pair(bindingSlot, std::move(newBuffer)));
+				m_uniformData[bindingSlot].resize(bindingInfo.size);
+			}
+
+			// Only mesh renderers with their own textures need their own descriptor sets
+			if (!material->hasSharedLevel3Descriptor()) {
+				m_descriptorSets = createScope<UniformDescriptorSets>(objs.device,
+				                                                      material->getDescriptorSetAllocator(),
+				                                                      material->shader->level3DSL,
+				                                                      material->shader->l3UBOData,
+				                                                      material->shader->l3ImageBindings,
+				                                                      material->getObjectUniformBuffers(),
+				                                                      material->getInstanceDataRange());
 			}
 
 			for (const auto& imageBinding : material->shader->l3ImageBindings) {
 				sampledImages.insert(std::make_pair(imageBinding.first, objs.defaultTexture));
 				bindTexture(imageBinding.first, objs.defaultTexture);
 			}
+			for (const auto& textureIndex : material->shader->l3TextureIndices) {
+				sampledImages.insert(std::make_pair(textureIndex.first, objs.defaultTexture));
+				bindTexture(textureIndex.first, objs.defaultTexture);
+			}
 
 			updateTransform(glm::mat4{1.f});
 		}
 
-		MeshRenderer(const MeshRenderer&) = delete;
-		MeshRenderer(MeshRenderer&& other)
+		void uploadUniform(uint32_t bindingSlot, const NotPointer auto& uniformData)
 		{
-			isVisible        = std::move(other.isVisible);
-			mesh             = std::move(other.mesh);
-			material         = std::move(other.material);
-			level3Descriptor = std::move(other.level3Descriptor);
-
-			m_device         = std::move(other.m_device);
-			m_allocator      = std::move(other.m_allocator);
-			m_descriptorPool = std::move(other.m_descriptorPool);
-			uniformBuffers   = std::move(other.uniformBuffers);
-			sampledImages    = std::move(other.sampledImages);
-
-			// Necessary to take ownership
-			other.m_allocator = nullptr;
+			uploadUniform(bindingSlot, &uniformData, sizeof(uniformData));
 		}
 
-		~MeshRenderer()
+		void uploadUniform(uint32_t bindingSlot, const void* srcData, std::size_t size)
 		{
-			if (m_allocator != nullptr) m_device.destroyDescriptorPool(m_descriptorPool);
-		}
+			MRG_ENGINE_ASSERT(m_uniformData.contains(bindingSlot), "Invalid binding slot!")
+			auto& uniformData = m_uniformData.at(bindingSlot);
+			MRG_ENGINE_ASSERT(size <= uniformData.size(), "Uniform data is bigger than its binding ({} > {})!", size, uniformData.size())
 
-		MeshRenderer& operator=(const MeshRenderer&) = delete;
+			memcpy(uniformData.data(), srcData, size);
+		}
 
-		MeshRenderer& operator=(MeshRenderer&& other)
+		// Texture index slots are plain uniforms, so they do not need descriptor sets of their own (see Material::bindTexture)
+		void bindTexture(uint32_t bindingSlot, const Ref<Texture>& texture)
 		{
-			isVisible        = std::move(other.isVisible);
-			mesh             = std::move(other.mesh);
-			material         = std::move(other.material);
-			level3Descriptor = std::move(other.level3Descriptor);
+			MRG_ENGINE_ASSERT(sampledImages.contains(bindingSlot), "Invalid binding slot!")
+			if (material->shader->l3TextureIndices.contains(bindingSlot)) {
+				uploadUniform(bindingSlot, texture->getBindlessIndex());
+			} else {
+				MRG_ENGINE_ASSERT(!texture->isStreamed(), "Streamed textures can only be bound to texture index slots!")
+				MRG_ENGINE_ASSERT(texture->isLoaded(), "Textures still loading can only be bound to texture index slots!")
+				m_descriptorSets->setImage(bindingSlot, texture->sampler, texture->image.view);
+			}
 
-			m_device         = std::move(other.m_device);
-			m_allocator      = std::move(other.m_allocator);
-			m_descriptorPool = std::move(other.m_descriptorPool);
-			uniformBuffers   = std::move(other.uniformBuffers);
-			sampledImages    = std::move(other.sampledImages);
+			sampledImages.at(bindingSlot) = texture;
+			sampledFramebuffers.erase(bindingSlot);
+		}
 
-			// Necessary to take ownership
-			other.m_allocator = nullptr;
+		// Uses the color attachment of the framebuffer as a texture. Only valid for sampler slots.
+		void bindTexture(uint32_t bindingSlot, const Ref<Framebuffer>& framebuffer)
+		{
+			MRG_ENGINE_ASSERT(material->shader->l3ImageBindings.contains(bindingSlot), "Invalid binding slot!")
+			m_descriptorSets->setImage(bindingSlot, framebuffer->sampler, framebuffer->colorImage.view);
 
-			return *this;
+			sampledFramebuffers[bindingSlot] = framebuffer;
 		}
 
-		void uploadUniform(uint32_t bindingSlot, const NotPointer auto& uniformData)
+		// Applies the texture changes made since the given frame was last recorded (see UniformDescriptorSets)
+		[[nodiscard]] vk::DescriptorSet getLevel3Descriptor(uint32_t frameIndex, uint64_t frameNumber) const
 		{
-			MRG_ENGINE_ASSERT(uniformBuffers.contains(bindingSlot), "Invalid binding slot!")
-			void* data;
-			vmaMapMemory(m_allocator, uniformBuffers[bindingSlot].allocation, &data);
-			memcpy(data, &uniformData, sizeof(uniformData));
-			vmaUnmapMemory(m_allocator, uniformBuffers[bindingSlot].allocation);
+			if (m_descriptorSets == nullptr) { return material->getSharedLevel3Descriptor(frameIndex, frameNumber); }
+			return m_descriptorSets->getDescriptorSet(frameIndex, frameNumber);
 		}
 
-		void uploadUniform(uint32_t bindingSlot, void* srcData, std::size_t size)
+		// Copies the current uniforms into the frame's object uniform buffer, and appends their offsets (in binding order, as expected
+		// by bindDescriptorSets)
+		void pushUniforms(DynamicUniformBuffer& objectUniformBuffer, std::vector<uint32_t>& dynamicOffsets) const
 		{
-			MRG_ENGINE_ASSERT(uniformBuffers.contains(bindingSlot), "Invalid binding slot!")
-			void* dstData;
-			vmaMapMemory(m_allocator, uniformBuffers[bindingSlot].allocation, &dstData);
-			memcpy(dstData, srcData, size);
-			vmaUnmapMemory(m_allocator, uniformBuffers[bindingSlot].allocation);
+			for (const auto& uniformData : m_uniformData | std::views::values) {
+				dynamicOffsets.push_back(objectUniformBuffer.push(uniformData));
+			}
 		}
 
-		void bindTexture(uint32_t bindingSlot, const Ref<Texture>& texture)
+		void updateTransform(const glm::mat4& transform)
 		{
-			MRG_ENGINE_ASSERT(sampledImages.contains(bindingSlot), "Invalid binding slot!")
-			vk::DescriptorImageInfo imageBufferInfo{
-			  .sampler     = texture->sampler,
-			  .imageView   = texture->image.view,
-			  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-			};
-			vk::WriteDescriptorSet textureUpdate = {
-			  .dstSet          = level3Descriptor,
-			  .dstBinding      = bindingSlot,
-			  .descriptorCount = 1,
-			  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
-			  .pImageInfo      = &imageBufferInfo,
-			};
-			m_device.updateDescriptorSets(textureUpdate, {});
-
-			sampledImages.at(bindingSlot) = texture;
+			m_modelMatrix = offset.getTransform() * transform;
+			if (!material->shader->isInstanced) { uploadUniform(0, m_modelMatrix); }
 		}
-
-		// Uses the color attachment of the framebuffer as a texture
-		void bindTexture(uint32_t bindingSlot, const Ref<Framebuffer>& framebuffer)
+		// Only re-uploads the model matrix if the world matrix of the transform changed since the last call
+		void updateTransform(const Components::Transform& transform)
 		{
-			MRG_ENGINE_ASSERT(sampledImages.contains(bindingSlot), "Invalid binding slot!")
-			vk::DescriptorImageInfo imageBufferInfo{
-			  .sampler     = framebuffer->sampler,
-			  .imageView   = framebuffer->colorImage.view,
-			  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-			};
-			vk::WriteDescriptorSet textureUpdate = {
-			  .dstSet          = level3Descriptor,
-			  .dstBinding      = bindingSlot,
-			  .descriptorCount = 1,
-			  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
-			  .pImageInfo      = &imageBufferInfo,
-			};
-			m_device.updateDescriptorSets(textureUpdate, {});
+			if (m_transformVersion.update(transform)) { updateTransform(transform.getWorldMatrix()); }
 		}
-
-		void updateTransform(const glm::mat4& transform) { uploadUniform(0, offset.getTransform() * transform); }
+		[[nodiscard]] const glm::mat4& getModelMatrix() const { return m_modelMatrix; }
 
 		bool isVisible{true};
 
-		Transform offset{};
+		MRG::Transform offset{};
 
 		Ref<Mesh<VertexType>> mesh;
 		Ref<Material<VertexType>> material;
-		vk::DescriptorSet level3Descriptor;
 
 		std::map<uint32_t, Ref<Texture>> sampledImages;
-		std::map<uint32_t, AllocatedBuffer> uniformBuffers;
+		// Framebuffers have to be rendered before anything sampling them is, so they are tracked separately
+		std::map<uint32_t, Ref<Framebuffer>> sampledFramebuffers;
 
 	private:
-		vk::Device m_device;
-		VmaAllocator m_allocator;
-		vk::DescriptorPool m_descriptorPool;
+		glm::mat4 m_modelMatrix{1.f};
+		TransformVersionTracker m_transformVersion{};
+		std::map<uint32_t, std::vector<std::byte>> m_uniformData{};
+		Scope<UniformDescriptorSets> m_descriptorSets{};
 	};
 }  // namespace MRG::Components
 
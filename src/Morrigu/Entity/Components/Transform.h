@@ -6,11 +6,96 @@
 #define MORRIGU_COMP_TRANSFORM_H
 
 #include "Entity/Transform.h"
+#include "Utils/GLMIncludeHelper.h"
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+
+namespace MRG
+{
+	class Transforms;
+}
 
 namespace MRG::Components
 {
-	// Just a convenience alias
-	using Transform = MRG::Transform;
+	// Local transform of an entity, relative to its parent (if any). The world matrix is cached, and only recomputed by
+	// Transforms::update when the local transform of the entity or of one of its ancestors changed.
+	class Transform
+	{
+	public:
+		[[nodiscard]] const glm::vec3& getTranslation() const { return m_local.translation; }
+		[[nodiscard]] const glm::vec3& getRotation() const { return m_local.rotation; }
+		[[nodiscard]] const glm::vec3& getScale() const { return m_local.scale; }
+		[[nodiscard]] const MRG::Transform& getLocal() const { return m_local; }
+
+		void setTranslation(const glm::vec3& translation)
+		{
+			m_local.translation = translation;
+			m_isDirty           = true;
+		}
+		void setRotation(const glm::vec3& rotation)
+		{
+			m_local.rotation = rotation;
+			m_isDirty        = true;
+		}
+		void setScale(const glm::vec3& scale)
+		{
+			m_local.scale = scale;
+			m_isDirty     = true;
+		}
+		void setLocal(const MRG::Transform& local)
+		{
+			m_local   = local;
+			m_isDirty = true;
+		}
+
+		// Both as of the last Transforms::update
+		[[nodiscard]] const glm::mat4& getLocalMatrix() const { return m_localMatrix; }
+		[[nodiscard]] const glm::mat4& getWorldMatrix() const { return m_worldMatrix; }
+		// Incremented every time the world matrix is recomputed
+		[[nodiscard]] uint32_t getVersion() const { return m_version; }
+
+		// The hierarchy can only be modified through Transforms::setParent
+		[[nodiscard]] entt::entity getParent() const { return m_parent; }
+		[[nodiscard]] entt::entity getFirstChild() const { return m_firstChild; }
+		[[nodiscard]] entt::entity getNextSibling() const { return m_nextSibling; }
+		[[nodiscard]] uint32_t getDepth() const { return m_depth; }
+
+	private:
+		friend class MRG::Transforms;
+
+		MRG::Transform m_local{};
+		glm::mat4 m_localMatrix{1.f};
+		glm::mat4 m_worldMatrix{1.f};
+		uint32_t m_version{0};
+		// Version of the parent the world matrix was computed from
+		uint32_t m_parentVersion{0};
+		bool m_isDirty{true};
+
+		uint32_t m_depth{0};
+		entt::entity m_parent{entt::null};
+		entt::entity m_firstChild{entt::null};
+		entt::entity m_previousSibling{entt::null};
+		entt::entity m_nextSibling{entt::null};
+	};
+
+	// Remembers the version of the transform it last saw, so that work depending on a world matrix is only redone when it changed
+	class TransformVersionTracker
+	{
+	public:
+		// Returns true if the world matrix of the transform changed since the last call
+		[[nodiscard]] bool update(const Transform& transform)
+		{
+			if (transform.getVersion() == m_version) { return false; }
+
+			m_version = transform.getVersion();
+			return true;
+		}
+
+	private:
+		uint32_t m_version{0};
+	};
 }  // namespace MRG::Components
 
 #endif
@@ -0,0 +1,142 @@
+#include "Transforms.h"
+
+#include "Core/Core.h"
+#include "Utils/TransformComposition.h"
+
+#include <vector>
+
+namespace
+{
+	// Reused between updates, so that only updates modifying more transforms than ever before allocate
+	thread_local MRG::Utils::Maths::TransformArrays s_modifiedTransforms{};
+	thread_local std::vector<MRG::Components::Transform*> s_modifiedComponents{};
+	thread_local std::vector<glm::mat4> s_localMatrices{};
+}  // namespace
+
+namespace MRG
+{
+	void Transforms::setParent(entt::registry& registry, entt::entity child, entt::entity parent)
+	{
+		auto& transform = registry.get<Components::Transform>(child);
+		if (transform.m_parent == parent) { return; }
+		for (auto ancestor = parent; ancestor != entt::null; ancestor = registry.get<Components::Transform>(ancestor).m_parent) {
+			if (ancestor == child) {
+				MRG_ENGINE_ERROR("Entity {} cannot be made a child of its descendant {}!", child, parent)
+				return;
+			}
+		}
+
+		detach(registry, child, transform);
+		if (parent == entt::null) {
+			setDepth(registry, transform, 0);
+			return;
+		}
+
+		auto& parentTransform = registry.get<Components::Transform>(parent);
+		if (parentTransform.m_firstChild != entt::null) {
+			registry.get<Components::Transform>(parentTransform.m_firstChild).m_previousSibling = child;
+		}
+		transform.m_parent           = parent;
+		transform.m_nextSibling      = parentTransform.m_firstChild;
+		parentTransform.m_firstChild = child;
+		// The parent version the world matrix was computed from may be the current version of the new parent (when reattaching to an
+		// unchanged parent), so it cannot be relied on to notice the new parent
+		transform.m_isDirty = true;
+		setDepth(registry, transform, parentTransform.m_depth + 1);
+
+		// Connecting an already connected listener replaces it, so registries that never use hierarchies do not pay for it
+		registry.on_destroy<Components::Transform>().connect<&Transforms::onTransformDestroyed>();
+	}
+
+	void Transforms::updateWorldMatrices(entt::registry& registry)
+	{
+		// New roots are appended at the end of the storage, and setParent can move subtrees up or down, so the order is only restored
+		// when needed
+		auto view = registry.view<Components::Transform>();
+		uint32_t previousDepth = 0;
+		for (const auto& entity : view) {
+			const auto& [transform] = view.get(entity);
+			if (transform.m_depth < previousDepth) {
+				registry.sort<Components::Transform>(
+				  [](const Components::Transform& lhs, const Components::Transform& rhs) { return lhs.m_depth < rhs.m_depth; });
+				break;
+			}
+			previousDepth = transform.m_depth;
+		}
+
+		// The local matrices of every modified transform are composed in a single batch
+		s_modifiedTransforms.clear();
+		s_modifiedComponents.clear();
+		for (const auto& entity : view) {
+			auto&& [transform] = view.get(entity);
+			if (!transform.m_isDirty) { continue; }
+
+			s_modifiedTransforms.push(transform.m_local.translation, transform.m_local.rotation, transform.m_local.scale);
+			s_modifiedComponents.push_back(&transform);
+		}
+		s_localMatrices.resize(s_modifiedComponents.size());
+		Utils::Maths::composeTransforms(s_modifiedTransforms, s_localMatrices);
+		for (std::size_t i = 0; i < s_modifiedComponents.size(); ++i) { s_modifiedComponents[i]->m_localMatrix = s_localMatrices[i]; }
+
+		for (const auto& entity : view) {
+			auto&& [transform] = view.get(entity);
+			if (transform.m_parent == entt::null) {
+				if (!transform.m_isDirty) { continue; }
+
+				transform.m_worldMatrix = transform.m_localMatrix;
+			} else {
+				const auto& [parentTransform] = view.get(transform.m_parent);
+				if (!transform.m_isDirty && transform.m_parentVersion == parentTransform.m_version) { continue; }
+
+				transform.m_worldMatrix   = parentTransform.m_worldMatrix * transform.m_localMatrix;
+				transform.m_parentVersion = parentTransform.m_version;
+			}
+			transform.m_isDirty = false;
+			++transform.m_version;
+		}
+	}
+
+	void Transforms::detach(entt::registry& registry, entt::entity entity, Components::Transform& transform)
+	{
+		if (transform.m_parent == entt::null) { return; }
+
+		if (transform.m_previousSibling != entt::null) {
+			registry.get<Components::Transform>(transform.m_previousSibling).m_nextSibling = transform.m_nextSibling;
+		} else {
+			auto& parentTransform = registry.get<Components::Transform>(transform.m_parent);
+			MRG_ENGINE_ASSERT(parentTransform.m_firstChild == entity, "Corrupted transform hierarchy!")
+			parentTransform.m_firstChild = transform.m_nextSibling;
+		}
+		if (transform.m_nextSibling != entt::null) {
+			registry.get<Components::Transform>(transform.m_nextSibling).m_previousSibling = transform.m_previousSibling;
+		}
+
+		transform.m_parent          = entt::null;
+		transform.m_previousSibling = entt::null;
+		transform.m_nextSibling     = entt::null;
+		transform.m_isDirty         = true;
+	}
+
+	void Transforms::setDepth(entt::registry& registry, Components::Transform& transform, uint32_t depth)
+	{
+		transform.m_depth = depth;
+		for (auto child = transform.m_firstChild; child != entt::null;) {
+			auto& childTransform = registry.get<Components::Transform>(child);
+			setDepth(registry, childTransform, depth + 1);
+			child = childTransform.m_nextSibling;
+		}
+	}
+
+	void Transforms::onTransformDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto& transform = registry.get<Components::Transform>(entity);
+		detach(registry, entity, transform);
+
+		while (transform.m_firstChild != entt::null) {
+			const auto child     = transform.m_firstChild;
+			auto& childTransform = registry.get<Components::Transform>(child);
+			detach(registry, child, childTransform);
+			setDepth(registry, childTransform, 0);
+		}
+	}
+}  // namespace MRG
@@ -0,0 +1,50 @@
+#ifndef MORRIGU_ENTITY_TRANSFORMS_H
+#define MORRIGU_ENTITY_TRANSFORMS_H
+
+#include "Entity/Components/MeshRenderer.h"
+#include "Entity/Components/Transform.h"
+#include "Rendering/Vertex.h"
+
+#include <entt/entt.hpp>
+
+namespace MRG
+{
+	// Maintains the transform hierarchy of a registry
+	class Transforms
+	{
+	public:
+		// Makes child a child of parent (or a root if parent is entt::null). The local transform of the child is kept, so its world
+		// matrix changes with its new parent. Making an entity a child of one of its descendants is an error and does nothing.
+		// Children of a destroyed entity become roots.
+		static void setParent(entt::registry& registry, entt::entity child, entt::entity parent);
+
+		// Recomputes the world matrices of the modified transforms and of their descendants, then re-uploads the model matrices of
+		// the mesh renderers (of the given vertex types) whose world matrix changed since the last update
+		template<Vertex... VertexTypes>
+		static void update(entt::registry& registry)
+		{
+			updateWorldMatrices(registry);
+			(updateMeshRenderers<VertexTypes>(registry), ...);
+		}
+
+	private:
+		// Transforms are kept sorted by depth in their storage, so that they are iterated contiguously with parents before children
+		static void updateWorldMatrices(entt::registry& registry);
+
+		template<Vertex VertexType>
+		static void updateMeshRenderers(entt::registry& registry)
+		{
+			auto view = registry.view<const Components::Transform, Components::MeshRenderer<VertexType>>();
+			for (const auto& entity : view) {
+				auto&& [transform, mrc] = view.get(entity);
+				mrc.updateTransform(transform);
+			}
+		}
+
+		static void detach(entt::registry& registry, entt::entity entity, Components::Transform& transform);
+		static void setDepth(entt::registry& registry, Components::Transform& transform, uint32_t depth);
+		static void onTransformDestroyed(entt::registry& registry, entt::entity entity);
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_ENTITY_TRANSFORMS_H
@@ -7,6 +7,7 @@
 
 #include "Core/Application.h"
 #include "Core/Input.h"
+#include "Core/Jobs.h"
 #include "Core/Layer.h"
 #include "Core/Logging.h"
 #include "Core/Timestep.h"
@@ -18,9 +19,12 @@
 
 #include "Entity/Components/MeshRenderer.h"
 #include "Entity/Components/Transform.h"
+#include "Entity/Transforms.h"
 
 #include "Utils/Maths.h"
 #include "Utils/Meshes.h"
+#include "Utils/Textures.h"
+#include "Utils/TransformComposition.h"
 #include "Utils/UtilityLayers.h"
 
 #endif  // MORRIGU_MORRIGU_H
@@ -0,0 +1,61 @@
+#ifndef MORRIGU_BOUNDS_H
+#define MORRIGU_BOUNDS_H
+
+#include "Rendering/Vertex.h"
+#include "Utils/GLMIncludeHelper.h"
+
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace MRG
+{
+	// Default constructed bounds are infinite, so that objects with unknown bounds are never culled
+	struct BoundingBox
+	{
+		glm::vec3 min{-std::numeric_limits<float>::max()};
+		glm::vec3 max{std::numeric_limits<float>::max()};
+	};
+
+	struct BoundingSphere
+	{
+		glm::vec3 center{0.f};
+		float radius{std::numeric_limits<float>::max()};
+
+		[[nodiscard]] static BoundingSphere fromBox(const BoundingBox& box)
+		{
+			return BoundingSphere{
+			  .center = (box.min + box.max) * 0.5f,
+			  .radius = glm::length(box.max - box.min) * 0.5f,
+			};
+		}
+	};
+
+	// Vertex data is read as raw bytes, as cooked meshes are uploaded straight from their file mapping. Vertex types without a position
+	// member get infinite bounds.
+	template<Vertex VertexType>
+	[[nodiscard]] BoundingBox computeBounds(std::span<const std::byte> vertexData)
+	{
+		if constexpr (requires(VertexType vertex) { vertex.position; }) {
+			const auto vertexCount = vertexData.size() / sizeof(VertexType);
+			if (vertexCount == 0) { return BoundingBox{}; }
+
+			BoundingBox bounds{
+			  .min = glm::vec3{std::numeric_limits<float>::max()},
+			  .max = glm::vec3{-std::numeric_limits<float>::max()},
+			};
+			for (std::size_t i = 0; i < vertexCount; ++i) {
+				VertexType vertex;
+				memcpy(&vertex, vertexData.data() + i * sizeof(VertexType), sizeof(VertexType));
+				bounds.min = glm::min(bounds.min, vertex.position);
+				bounds.max = glm::max(bounds.max, vertex.position);
+			}
+
+			return bounds;
+		} else {
+			return BoundingBox{};
+		}
+	}
+}  // namespace MRG
+
+#endif  // MORRIGU_BOUNDS_H
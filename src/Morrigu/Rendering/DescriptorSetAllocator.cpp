@@ -0,0 +1,102 @@
+#include "DescriptorSetAllocator.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace
+{
+	// Descriptors of each type pools hold per set, raised to what the set they are created for needs
+	const std::array<vk::DescriptorPoolSize, 3> defaultSetSizes{{
+	  {vk::DescriptorType::eUniformBufferDynamic, 2},
+	  {vk::DescriptorType::eStorageBufferDynamic, 1},
+	  {vk::DescriptorType::eCombinedImageSampler, 4},
+	}};
+}  // namespace
+
+namespace MRG
+{
+	DescriptorSetAllocator::DescriptorSetAllocator(vk::Device device, uint32_t framesInFlight)
+	    : m_device{device}, m_framesInFlight{framesInFlight}
+	{}
+
+	DescriptorSetAllocator::~DescriptorSetAllocator()
+	{
+		for (const auto& pool : m_pools) { m_device.destroyDescriptorPool(pool); }
+	}
+
+	DescriptorSetAllocation
+	DescriptorSetAllocator::allocate(vk::DescriptorSetLayout layout, uint32_t setCount, std::span<const vk::DescriptorPoolSize> setSizes)
+	{
+		const std::vector<vk::DescriptorSetLayout> layouts(setCount, layout);
+		vk::DescriptorSetAllocateInfo allocInfo{
+		  .descriptorSetCount = setCount,
+		  .pSetLayouts        = layouts.data(),
+		};
+
+		std::lock_guard lock{m_mutex};
+		// The newest pools are the most likely to have room left
+		for (auto pool = m_pools.rbegin(); pool != m_pools.rend(); ++pool) {
+			allocInfo.descriptorPool = *pool;
+			// Full pools are skipped
+			try {
+				return DescriptorSetAllocation{*pool, m_device.allocateDescriptorSets(allocInfo)};
+			} catch (const vk::OutOfPoolMemoryError&) {} catch (const vk::FragmentedPoolError&) {}
+		}
+
+		createPool(setCount, setSizes);
+		allocInfo.descriptorPool = m_pools.back();
+		return DescriptorSetAllocation{m_pools.back(), m_device.allocateDescriptorSets(allocInfo)};
+	}
+
+	void DescriptorSetAllocator::release(DescriptorSetAllocation allocation)
+	{
+		std::lock_guard lock{m_mutex};
+		m_retiredAllocations.push_back(RetiredAllocation{
+		  .allocation = std::move(allocation),
+		  .frame      = m_frame,
+		});
+	}
+
+	void DescriptorSetAllocator::beginFrame()
+	{
+		std::lock_guard lock{m_mutex};
+		++m_frame;
+
+		// Frames that could still use sets released before are all complete by now
+		const auto reclaimedAllocations = std::ranges::partition(m_retiredAllocations, [this](const RetiredAllocation& retiredAllocation) {
+			return retiredAllocation.frame + m_framesInFlight > m_frame;
+		});
+		for (const auto& retiredAllocation : reclaimedAllocations) {
+			m_device.freeDescriptorSets(retiredAllocation.allocation.pool, retiredAllocation.allocation.descriptorSets);
+		}
+		m_retiredAllocations.erase(reclaimedAllocations.begin(), reclaimedAllocations.end());
+	}
+
+	void DescriptorSetAllocator::createPool(uint32_t setCount, std::span<const vk::DescriptorPoolSize> setSizes)
+	{
+		std::vector<vk::DescriptorPoolSize> poolSizes(defaultSetSizes.begin(), defaultSetSizes.end());
+		for (const auto& setSize : setSizes) {
+			if (setSize.descriptorCount == 0) { continue; }
+
+			const auto poolSize = std::ranges::find(poolSizes, setSize.type, &vk::DescriptorPoolSize::type);
+			if (poolSize == poolSizes.end()) {
+				poolSizes.push_back(setSize);
+			} else {
+				poolSize->descriptorCount = std::max(poolSize->descriptorCount, setSize.descriptorCount);
+			}
+		}
+
+		const auto maxSets = std::max(m_setsPerPool, setCount);
+		for (auto& poolSize : poolSizes) { poolSize.descriptorCount *= maxSets; }
+
+		const vk::DescriptorPoolCreateInfo poolInfo{
+		  .flags         = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+		  .maxSets       = maxSets,
+		  .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+		  .pPoolSizes    = poolSizes.data(),
+		};
+		m_pools.push_back(m_device.createDescriptorPool(poolInfo));
+		m_setsPerPool *= 2;
+	}
+}  // namespace MRG
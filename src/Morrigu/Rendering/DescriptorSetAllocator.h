@@ -0,0 +1,65 @@
+#ifndef MORRIGU_DESCRIPTORSETALLOCATOR_H
+#define MORRIGU_DESCRIPTORSETALLOCATOR_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace MRG
+{
+	struct DescriptorSetAllocation
+	{
+		vk::DescriptorPool pool{};
+		std::vector<vk::DescriptorSet> descriptorSets{};
+	};
+
+	// Descriptor pools shared by the descriptor sets created along with objects (mesh renderers, ...), instead of one pool per object.
+	// A new pool, twice as big as the previous one, is created whenever the existing ones are full, and released sets are given back to
+	// their pool once every frame in flight during their release is complete.
+	// Pools live as long as the allocator, which is kept alive by every owner of sets it allocated. Can be used from any thread.
+	class DescriptorSetAllocator
+	{
+	public:
+		DescriptorSetAllocator(vk::Device device, uint32_t framesInFlight);
+		DescriptorSetAllocator(const DescriptorSetAllocator&) = delete;
+		DescriptorSetAllocator(DescriptorSetAllocator&&)      = delete;
+		~DescriptorSetAllocator();
+
+		DescriptorSetAllocator& operator=(const DescriptorSetAllocator&) = delete;
+		DescriptorSetAllocator& operator=(DescriptorSetAllocator&&) = delete;
+
+		// setSizes holds the descriptors of each type needed by a single set of the layout. The sets all come from the same pool.
+		[[nodiscard]] DescriptorSetAllocation
+		allocate(vk::DescriptorSetLayout layout, uint32_t setCount, std::span<const vk::DescriptorPoolSize> setSizes);
+		void release(DescriptorSetAllocation allocation);
+
+		// Must be called once the GPU is done with the previous frame using the same frame in flight
+		void beginFrame();
+
+	private:
+		struct RetiredAllocation
+		{
+			DescriptorSetAllocation allocation;
+			uint64_t frame;
+		};
+
+		// Expects the mutex to be locked
+		void createPool(uint32_t setCount, std::span<const vk::DescriptorPoolSize> setSizes);
+
+		vk::Device m_device;
+		uint32_t m_framesInFlight;
+
+		std::mutex m_mutex{};
+		// From the oldest (and smallest) to the newest one
+		std::vector<vk::DescriptorPool> m_pools{};
+		uint32_t m_setsPerPool{64};
+		std::vector<RetiredAllocation> m_retiredAllocations{};
+		// Frames begun so far
+		uint64_t m_frame{0};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_DESCRIPTORSETALLOCATOR_H
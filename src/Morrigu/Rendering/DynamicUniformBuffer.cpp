@@ -0,0 +1,47 @@
+#include "DynamicUniformBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace MRG
+{
+	DynamicUniformBuffer::DynamicUniformBuffer(VmaAllocator allocator,
+	                                           std::size_t capacity,
+	                                           vk::DeviceSize minOffsetAlignment,
+	                                           std::size_t readPadding)
+	    : m_allocator{allocator},
+	      m_buffer{allocator,
+	               capacity + readPadding,
+	               vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer,
+	               VMA_MEMORY_USAGE_CPU_TO_GPU,
+	               VMA_ALLOCATION_CREATE_MAPPED_BIT},
+	      m_mappedData{static_cast<std::byte*>(m_buffer.mappedData)},
+	      m_capacity{capacity},
+	      m_alignment{std::max(static_cast<std::size_t>(minOffsetAlignment), std::size_t{1})}
+	{}
+
+	uint32_t DynamicUniformBuffer::push(std::span<const std::byte> data)
+	{
+		// Only the range is reserved atomically, the copies themselves can then happen in parallel
+		auto size = m_size.load(std::memory_order_relaxed);
+		std::size_t offset;
+		do {
+			offset = (size + m_alignment - 1) / m_alignment * m_alignment;
+			if (offset + data.size() > m_capacity) {
+				throw std::runtime_error("dynamic uniform buffer is full, increase RendererSpecification::objectUniformBufferSize!");
+			}
+		} while (!m_size.compare_exchange_weak(size, offset + data.size(), std::memory_order_relaxed));
+
+		memcpy(m_mappedData + offset, data.data(), data.size());
+
+		return static_cast<uint32_t>(offset);
+	}
+
+	void DynamicUniformBuffer::flush()
+	{
+		const auto size = m_size.load(std::memory_order_relaxed);
+		if (size == 0) { return; }
+		vmaFlushAllocation(m_allocator, m_buffer.allocation, 0, size);
+	}
+}  // namespace MRG
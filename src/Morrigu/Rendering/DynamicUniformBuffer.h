@@ -0,0 +1,50 @@
+#ifndef MORRIGU_DYNAMICUNIFORMBUFFER_H
+#define MORRIGU_DYNAMICUNIFORMBUFFER_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <atomic>
+#include <span>
+
+namespace MRG
+{
+	// A persistently mapped buffer that per object uniforms of a frame are linearly allocated from. Objects all share the same descriptor
+	// set, bound as a dynamic uniform buffer, and only the offsets given when binding it change between draws. Instance data (model
+	// matrices of instanced draws) is allocated the same way, and bound as a dynamic storage buffer.
+	// There is one such buffer per frame in flight, reset once the GPU is done with the frame.
+	class DynamicUniformBuffer
+	{
+	public:
+		// The alignment has to satisfy both minUniformBufferOffsetAlignment and minStorageBufferOffsetAlignment.
+		// Bindings can have a fixed range bigger than the data pushed for them (instance data), reading up to readPadding bytes past the
+		// capacity: these are allocated, but never pushed to.
+		DynamicUniformBuffer(VmaAllocator allocator, std::size_t capacity, vk::DeviceSize minOffsetAlignment, std::size_t readPadding = 0);
+		DynamicUniformBuffer(const DynamicUniformBuffer&) = delete;
+		DynamicUniformBuffer(DynamicUniformBuffer&&)      = delete;
+		~DynamicUniformBuffer() = default;
+
+		DynamicUniformBuffer& operator=(const DynamicUniformBuffer&) = delete;
+		DynamicUniformBuffer& operator=(DynamicUniformBuffer&&) = delete;
+
+		// Copies the data at the end of the buffer, and returns the dynamic offset to bind it with. Can be called from several recording
+		// threads at once.
+		[[nodiscard]] uint32_t push(std::span<const std::byte> data);
+
+		// Makes everything pushed visible to the GPU, memory used for uniforms is not always host coherent
+		void flush();
+		void reset() { m_size.store(0, std::memory_order_relaxed); }
+
+		[[nodiscard]] vk::Buffer getVkHandle() const { return m_buffer.vkHandle; }
+
+	private:
+		VmaAllocator m_allocator;
+		AllocatedBuffer m_buffer;
+		std::byte* m_mappedData{nullptr};
+		std::size_t m_capacity;
+		std::size_t m_alignment;
+
+		std::atomic<std::size_t> m_size{0};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_DYNAMICUNIFORMBUFFER_H
@@ -20,16 +20,13 @@ namespace MRG
 		  .addressModeV = spec.samplingAddressMode,
 		  .addressModeW = spec.samplingAddressMode,
 		};
-		sampler = m_objects.device.createSampler(samplerInfo);
+		sampler = m_objects.samplerCache->getSampler(samplerInfo);
 	}
 
 	Framebuffer::~Framebuffer()
 	{
-		m_objects.device.destroySampler(sampler);
-
-		m_objects.device.destroyDescriptorPool(descriptorPool);
-		m_objects.device.destroyFence(renderFence);
-		m_objects.device.destroyCommandPool(commandPool);
+		// The attachments may still be used by frames in flight
+		m_objects.device.waitIdle();
 	}
 
 	void Framebuffer::resize(uint32_t width, uint32_t height)
@@ -41,16 +38,15 @@ namespace MRG
 
 	void Framebuffer::invalidate()
 	{
-		if (descriptorPool != vk::DescriptorPool{}) { m_objects.device.destroyDescriptorPool(descriptorPool); }
-		if (renderFence != vk::Fence{}) { m_objects.device.destroyFence(renderFence); }
-		if (commandPool != vk::CommandPool{}) { m_objects.device.destroyCommandPool(commandPool); }
+		// The previous attachments may still be sampled by frames in flight
+		if (vkHandle != vk::Framebuffer{}) { m_objects.device.waitIdle(); }
+
 		if (vkHandle != vk::Framebuffer{}) { m_objects.device.destroyFramebuffer(vkHandle); }
 
 		colorImage = AllocatedImage{AllocatedImageSpecification{
-		  .device        = m_objects.device,
-		  .graphicsQueue = m_objects.graphicsQueue,
-		  .uploadContext = m_objects.uploadContext,
-		  .allocator     = m_objects.allocator,
+		  .device      = m_objects.device,
+		  .uploadQueue = m_objects.uploadQueue,
+		  .allocator   = m_objects.allocator,
 		  .usage  = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
 		  .format = m_objects.swapchainFormat,
 		  .width  = spec.width,
@@ -131,40 +127,6 @@ namespace MRG
 
 		vkHandle = m_objects.device.createFramebuffer(fbInfo);
 
-		vk::CommandPoolCreateInfo cmdPoolInfo{
-		  .flags            = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-		  .queueFamilyIndex = m_objects.graphicsQueueIndex,
-		};
-		commandPool = m_objects.device.createCommandPool(cmdPoolInfo);
-
-		// allocate main command buffer from created command pool
-		vk::CommandBufferAllocateInfo mainCmdBufferInfo{
-		  .commandPool        = commandPool,
-		  .level              = vk::CommandBufferLevel::ePrimary,
-		  .commandBufferCount = 1,
-		};
-		commandBuffer = m_objects.device.allocateCommandBuffers(mainCmdBufferInfo)[0];
-
-		renderFence = m_objects.device.createFence(vk::FenceCreateInfo{});
-
-		std::array<vk::DescriptorPoolSize, 1> sizes{{vk::DescriptorType::eUniformBuffer, 1}};
-		vk::DescriptorPoolCreateInfo poolInfo{
-		  .maxSets       = 1,
-		  .poolSizeCount = static_cast<uint32_t>(sizes.size()),
-		  .pPoolSizes    = sizes.data(),
-		};
-		descriptorPool = m_objects.device.createDescriptorPool(poolInfo);
-
-		vk::DescriptorSetAllocateInfo allocInfo{
-		  .descriptorPool     = descriptorPool,
-		  .descriptorSetCount = 1,
-		  .pSetLayouts        = &m_objects.level0DSL,
-		};
-		level0Descriptor = m_objects.device.allocateDescriptorSets(allocInfo)[0];
-
-		timeDataBuffer =
-		  AllocatedBuffer{m_objects.allocator, sizeof(TimeData), vk::BufferUsageFlagBits::eUniformBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU};
-
 		if (m_imTexID != nullptr) {
 			vk::DescriptorImageInfo descImage{
 			  .sampler     = sampler,
@@ -6,6 +6,7 @@
 #define MORRIGU_FRAMEBUFFER_H
 
 #include "Rendering/RendererTypes.h"
+#include "Rendering/SamplerCache.h"
 
 #include <imgui.h>
 
@@ -30,14 +31,13 @@ namespace MRG
 		struct VulkanObjects
 		{
 			vk::Device device;
-			vk::Queue graphicsQueue;
-			UploadContext uploadContext;
+			UploadQueue* uploadQueue;
 			VmaAllocator allocator;
+			SamplerCache* samplerCache;
 			vk::Format swapchainFormat;
 			vk::Format depthImageFormat;
 			vk::RenderPass renderPass;
 			uint32_t graphicsQueueIndex;
-			vk::DescriptorSetLayout level0DSL;
 		};
 
 		Framebuffer(const FramebufferSpecification& specification, const VulkanObjects vkObjs);
@@ -67,20 +67,10 @@ namespace MRG
 		// Depth attachment
 		AllocatedImage depthImage{};
 
+		// Owned by the renderer's sampler cache (see SamplerCache)
 		vk::Sampler sampler{};
 		vk::Framebuffer vkHandle{};
 
-		// Render data
-		vk::CommandPool commandPool;
-		vk::CommandBuffer commandBuffer;
-
-		vk::Fence renderFence{};
-
-		vk::DescriptorPool descriptorPool{};
-		vk::DescriptorSet level0Descriptor{};
-
-		AllocatedBuffer timeDataBuffer{};
-
 	private:
 		ImTextureID m_imTexID{nullptr};
 		VulkanObjects m_objects;
@@ -0,0 +1,70 @@
+#include "FrustumCulling.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace MRG
+{
+	Frustum Frustum::fromViewProjection(const glm::mat4& viewProjection)
+	{
+		// Gribb & Hartmann plane extraction, with a [0, 1] clip space depth (see GLMIncludeHelper.h)
+		const auto row = [&viewProjection](glm::length_t index) {
+			return glm::vec4{viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]};
+		};
+
+		Frustum frustum{.planes{
+		  row(3) + row(0),  // left
+		  row(3) - row(0),  // right
+		  row(3) + row(1),  // bottom
+		  row(3) - row(1),  // top
+		  row(2),           // near
+		  row(3) - row(2),  // far
+		}};
+		for (auto& plane : frustum.planes) { plane /= glm::length(glm::vec3{plane}); }
+
+		return frustum;
+	}
+
+	void CullingSpheres::clear()
+	{
+		centersX.clear();
+		centersY.clear();
+		centersZ.clear();
+		radii.clear();
+	}
+
+	void CullingSpheres::push(const BoundingSphere& localSphere, const glm::mat4& transform)
+	{
+		const auto center   = transform * glm::vec4{localSphere.center, 1.f};
+		const auto maxScale = std::max({glm::length(glm::vec3{transform[0]}),
+		                                glm::length(glm::vec3{transform[1]}),
+		                                glm::length(glm::vec3{transform[2]})});
+
+		centersX.push_back(center.x);
+		centersY.push_back(center.y);
+		centersZ.push_back(center.z);
+		radii.push_back(localSphere.radius * maxScale);
+	}
+
+	std::size_t cullSpheres(const Frustum& frustum, const CullingSpheres& spheres, std::vector<uint32_t>& visibility)
+	{
+		const auto count = spheres.size();
+		visibility.assign(count, 1);
+
+		const auto* centersX = spheres.centersX.data();
+		const auto* centersY = spheres.centersY.data();
+		const auto* centersZ = spheres.centersZ.data();
+		const auto* radii    = spheres.radii.data();
+		auto* visible        = visibility.data();
+
+		// One plane at a time over every sphere: the inner loop has no branch and only touches contiguous arrays
+		for (const auto& plane : frustum.planes) {
+			for (std::size_t i = 0; i < count; ++i) {
+				const auto distance = plane.x * centersX[i] + plane.y * centersY[i] + plane.z * centersZ[i] + plane.w;
+				visible[i] &= static_cast<uint32_t>(distance >= -radii[i]);
+			}
+		}
+
+		return std::accumulate(visibility.begin(), visibility.end(), std::size_t{0});
+	}
+}  // namespace MRG
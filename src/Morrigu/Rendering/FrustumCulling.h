@@ -0,0 +1,40 @@
+#ifndef MORRIGU_FRUSTUMCULLING_H
+#define MORRIGU_FRUSTUMCULLING_H
+
+#include "Rendering/Bounds.h"
+#include "Utils/GLMIncludeHelper.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace MRG
+{
+	struct Frustum
+	{
+		// Normalised planes (normal pointing inside, distance in w), in the space the matrix transforms from
+		std::array<glm::vec4, 6> planes;
+
+		[[nodiscard]] static Frustum fromViewProjection(const glm::mat4& viewProjection);
+	};
+
+	// World space bounding spheres, stored as a structure of arrays so that the culling loops can be vectorised
+	struct CullingSpheres
+	{
+		std::vector<float> centersX{};
+		std::vector<float> centersY{};
+		std::vector<float> centersZ{};
+		std::vector<float> radii{};
+
+		void clear();
+		// Transforms a local space sphere, scaling its radius by the biggest scale of the transform
+		void push(const BoundingSphere& localSphere, const glm::mat4& transform);
+		[[nodiscard]] std::size_t size() const { return radii.size(); }
+	};
+
+	// Sets visibility[i] to 1 if the sphere i is at least partially inside the frustum, to 0 otherwise, and returns the visible count.
+	// Visibility is stored as 32 bits integers: byte stores could alias the sphere data, which prevents vectorisation.
+	std::size_t cullSpheres(const Frustum& frustum, const CullingSpheres& spheres, std::vector<uint32_t>& visibility);
+}  // namespace MRG
+
+#endif  // MORRIGU_FRUSTUMCULLING_H
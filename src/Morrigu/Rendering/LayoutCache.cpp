@@ -0,0 +1,86 @@
+#include "LayoutCache.h"
+
+#include "Utils/Hashing.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace MRG
+{
+	LayoutCache::LayoutCache(vk::Device device) : m_device{device} {}
+
+	LayoutCache::~LayoutCache()
+	{
+		for (const auto& [key, pipelineLayout] : m_pipelineLayouts) { m_device.destroyPipelineLayout(pipelineLayout); }
+		for (const auto& [key, setLayout] : m_descriptorSetLayouts) { m_device.destroyDescriptorSetLayout(setLayout); }
+	}
+
+	vk::DescriptorSetLayout LayoutCache::getDescriptorSetLayout(std::span<const vk::DescriptorSetLayoutBinding> bindings)
+	{
+		std::vector<vk::DescriptorSetLayoutBinding> sortedBindings(bindings.begin(), bindings.end());
+		std::ranges::sort(sortedBindings, {}, &vk::DescriptorSetLayoutBinding::binding);
+		MRG_ENGINE_ASSERT(std::ranges::none_of(sortedBindings, [](const auto& binding) { return binding.pImmutableSamplers != nullptr; }),
+		                  "Immutable samplers are not supported by the layout cache!")
+
+		std::lock_guard lock{m_mutex};
+		const auto it = m_descriptorSetLayouts.find(sortedBindings);
+		if (it != m_descriptorSetLayouts.end()) { return it->second; }
+
+		vk::DescriptorSetLayoutCreateInfo setInfo{
+		  .bindingCount = static_cast<uint32_t>(sortedBindings.size()),
+		  .pBindings    = sortedBindings.data(),
+		};
+		const auto setLayout = m_device.createDescriptorSetLayout(setInfo);
+		m_descriptorSetLayouts.insert(std::make_pair(std::move(sortedBindings), setLayout));
+		return setLayout;
+	}
+
+	vk::PipelineLayout LayoutCache::getPipelineLayout(std::span<const vk::DescriptorSetLayout> setLayouts,
+	                                                  std::span<const vk::PushConstantRange> pushConstantRanges)
+	{
+		PipelineLayoutKey key{
+		  .setLayouts         = {setLayouts.begin(), setLayouts.end()},
+		  .pushConstantRanges = {pushConstantRanges.begin(), pushConstantRanges.end()},
+		};
+
+		std::lock_guard lock{m_mutex};
+		const auto it = m_pipelineLayouts.find(key);
+		if (it != m_pipelineLayouts.end()) { return it->second; }
+
+		vk::PipelineLayoutCreateInfo layoutInfo{
+		  .setLayoutCount         = static_cast<uint32_t>(key.setLayouts.size()),
+		  .pSetLayouts            = key.setLayouts.data(),
+		  .pushConstantRangeCount = static_cast<uint32_t>(key.pushConstantRanges.size()),
+		  .pPushConstantRanges    = key.pushConstantRanges.data(),
+		};
+		const auto pipelineLayout = m_device.createPipelineLayout(layoutInfo);
+		m_pipelineLayouts.insert(std::make_pair(std::move(key), pipelineLayout));
+		return pipelineLayout;
+	}
+
+	std::size_t LayoutCache::DescriptorSetLayoutHash::operator()(const std::vector<vk::DescriptorSetLayoutBinding>& bindings) const
+	{
+		std::size_t seed = 0;
+		for (const auto& binding : bindings) {
+			Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(binding.binding));
+			Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(binding.descriptorType)));
+			Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(binding.descriptorCount));
+			Utils::Hashing::hashCombine(seed, std::hash<VkShaderStageFlags>{}(static_cast<VkShaderStageFlags>(binding.stageFlags)));
+		}
+		return seed;
+	}
+
+	std::size_t LayoutCache::PipelineLayoutHash::operator()(const PipelineLayoutKey& key) const
+	{
+		std::size_t seed = 0;
+		for (const auto& setLayout : key.setLayouts) {
+			Utils::Hashing::hashCombine(seed, std::hash<VkDescriptorSetLayout>{}(static_cast<VkDescriptorSetLayout>(setLayout)));
+		}
+		for (const auto& range : key.pushConstantRanges) {
+			Utils::Hashing::hashCombine(seed, std::hash<VkShaderStageFlags>{}(static_cast<VkShaderStageFlags>(range.stageFlags)));
+			Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(range.offset));
+			Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(range.size));
+		}
+		return seed;
+	}
+}  // namespace MRG
@@ -0,0 +1,62 @@
+#ifndef MORRIGU_LAYOUTCACHE_H
+#define MORRIGU_LAYOUTCACHE_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace MRG
+{
+	// Owns every descriptor set layout and pipeline layout of the renderer, and returns the existing one when asked for an identical
+	// layout. Besides saving driver memory, sharing layouts keeps the descriptor sets bound by a material valid for the next one whenever
+	// their pipeline layouts are compatible.
+	// Layouts live as long as the cache. Can be used from any thread.
+	class LayoutCache
+	{
+	public:
+		explicit LayoutCache(vk::Device device);
+		LayoutCache(const LayoutCache&) = delete;
+		LayoutCache(LayoutCache&&)      = delete;
+		~LayoutCache();
+
+		LayoutCache& operator=(const LayoutCache&) = delete;
+		LayoutCache& operator=(LayoutCache&&) = delete;
+
+		// The order of the bindings does not matter. Immutable samplers are not supported.
+		[[nodiscard]] vk::DescriptorSetLayout getDescriptorSetLayout(std::span<const vk::DescriptorSetLayoutBinding> bindings);
+		[[nodiscard]] vk::PipelineLayout getPipelineLayout(std::span<const vk::DescriptorSetLayout> setLayouts,
+		                                                   std::span<const vk::PushConstantRange> pushConstantRanges);
+
+	private:
+		struct PipelineLayoutKey
+		{
+			std::vector<vk::DescriptorSetLayout> setLayouts;
+			std::vector<vk::PushConstantRange> pushConstantRanges;
+
+			bool operator==(const PipelineLayoutKey&) const = default;
+		};
+
+		struct DescriptorSetLayoutHash
+		{
+			std::size_t operator()(const std::vector<vk::DescriptorSetLayoutBinding>& bindings) const;
+		};
+		struct PipelineLayoutHash
+		{
+			std::size_t operator()(const PipelineLayoutKey& key) const;
+		};
+
+		vk::Device m_device;
+
+		std::mutex m_mutex{};
+		// Bindings are sorted by binding slot
+		std::unordered_map<std::vector<vk::DescriptorSetLayoutBinding>, vk::DescriptorSetLayout, DescriptorSetLayoutHash>
+		  m_descriptorSetLayouts{};
+		std::unordered_map<PipelineLayoutKey, vk::PipelineLayout, PipelineLayoutHash> m_pipelineLayouts{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_LAYOUTCACHE_H
@@ -5,14 +5,21 @@
 #ifndef MORRIGU_MATERIAL_H
 #define MORRIGU_MATERIAL_H
 
+#include "Rendering/DescriptorSetAllocator.h"
 #include "Rendering/Framebuffer.h"
+#include "Rendering/LayoutCache.h"
 #include "Rendering/PipelineBuilder.h"
 #include "Rendering/RendererTypes.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Texture.h"
+#include "Rendering/UniformDescriptorSets.h"
 #include "Rendering/Vertex.h"
 
+#include <array>
+#include <atomic>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace MRG
 {
@@ -38,63 +45,79 @@ namespace MRG
 	class Material
 	{
 	public:
+		// The object uniform buffers are the per frame buffers level 3 uniforms are pushed into when drawing (one per frame in flight).
+		// Instanced shaders read their model matrices from these through a range of instanceDataRange bytes.
 		explicit Material(vk::Device device,
 		                  VmaAllocator allocator,
 		                  const Ref<Shader>& shaderRef,
 		                  vk::PipelineCache pipelineCache,
 		                  vk::RenderPass renderPass,
+		                  LayoutCache& layoutCache,
+		                  const Ref<DescriptorSetAllocator>& setAllocator,
 		                  vk::DescriptorSetLayout level0DSL,
 		                  vk::DescriptorSetLayout level1DSL,
 		                  const Ref<Texture>& defaultTexture,
-		                  const MaterialConfiguration& config)
-		    : shader{shaderRef}, m_device{device}, m_allocator{allocator}
+		                  const MaterialConfiguration& config,
+		                  const std::vector<vk::Buffer>& objectUniformBuffers,
+		                  vk::DeviceSize instanceDataRange)
+		    : Material{device,
+		               allocator,
+		               shaderRef,
+		               layoutCache,
+		               setAllocator,
+		               level0DSL,
+		               level1DSL,
+		               defaultTexture,
+		               objectUniformBuffers,
+		               instanceDataRange}
 		{
-			// Pool creation
-			std::array<vk::DescriptorPoolSize, 2> sizes{
-			  vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, std::max(static_cast<uint32_t>(shader->l2UBOData.size()), 1u)},
-			  vk::DescriptorPoolSize{vk::DescriptorType::eSampledImage,
-			                         std::max(static_cast<uint32_t>(shader->l2ImageBindings.size()), 1u)},
-			};
-			vk::DescriptorPoolCreateInfo poolInfo{
-			  .maxSets       = 1,
-			  .poolSizeCount = static_cast<uint32_t>(sizes.size()),
-			  .pPoolSizes    = sizes.data(),
-			};
-
-			m_descriptorPool = m_device.createDescriptorPool(poolInfo);
+			compilePipeline(pipelineCache, renderPass, config);
+		}
 
-			vk::DescriptorSetAllocateInfo setAllocInfo{
-			  .descriptorPool     = m_descriptorPool,
-			  .descriptorSetCount = 1,
-			  .pSetLayouts        = &shader->level2DSL,
-			};
-			level2Descriptor = m_device.allocateDescriptorSets(setAllocInfo).back();
-
-			for (const auto& [bindingSlot, bindingInfo] : shader->l2UBOData) {
-				AllocatedBuffer newBuffer{
-				  m_allocator, bindingInfo.size, vk::BufferUsageFlagBits::eUniformBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU};
-
-				vk::DescriptorBufferInfo descriptorBufferInfo{
-				  .buffer = newBuffer.vkHandle,
-				  .offset = 0,
-				  .range  = bindingInfo.size,
-				};
-				vk::WriteDescriptorSet setWrite{
-				  .dstSet          = level2Descriptor,
-				  .dstBinding      = bindingSlot,
-				  .descriptorCount = 1,
-				  .descriptorType  = vk::DescriptorType::eUniformBuffer,
-				  .pBufferInfo     = &descriptorBufferInfo,
-				};
-
-				m_device.updateDescriptorSets(setWrite, {});
-				uniformBuffers.insert(std::make_pair(bindingSlot, std::move(newBuffer)));
+		// Creates everything but the pipeline, which compilePipeline has to be called for (possibly on another thread). In the meantime,
+		// the material can be used for mesh renderers, uniforms and textures, but is not drawn.
+		explicit Material(vk::Device device,
+		                  VmaAllocator allocator,
+		                  const Ref<Shader>& shaderRef,
+		                  LayoutCache& layoutCache,
+		                  const Ref<DescriptorSetAllocator>& setAllocator,
+		                  vk::DescriptorSetLayout level0DSL,
+		                  vk::DescriptorSetLayout level1DSL,
+		                  const Ref<Texture>& defaultTexture,
+		                  const std::vector<vk::Buffer>& objectUniformBuffers,
+		                  vk::DeviceSize instanceDataRange)
+		    : shader{shaderRef},
+		      m_device{device},
+		      m_setAllocator{setAllocator},
+		      m_objectUniformBuffers{objectUniformBuffers},
+		      m_instanceDataRange{shaderRef->isInstanced ? instanceDataRange : 0},
+		      m_descriptorSets{device,
+		                       allocator,
+		                       shaderRef->level2DSL,
+		                       shaderRef->l2UBOData,
+		                       shaderRef->l2ImageBindings,
+		                       static_cast<uint32_t>(objectUniformBuffers.size())}
+		{
+			// Without any per object texture, the level 3 descriptor sets only point to the object uniform buffers, so every mesh renderer
+			// using this material can share them
+			if (shader->l3ImageBindings.empty()) {
+				m_level3DescriptorSets = UniformDescriptorSets{device,
+				                                               m_setAllocator,
+				                                               shader->level3DSL,
+				                                               shader->l3UBOData,
+				                                               shader->l3ImageBindings,
+				                                               m_objectUniformBuffers,
+				                                               m_instanceDataRange};
 			}
 
 			for (const auto& imageBinding : shader->l2ImageBindings) {
 				sampledImages.insert(std::make_pair(imageBinding.first, defaultTexture));
 				bindTexture(imageBinding.first, defaultTexture);
 			}
+			for (const auto& textureIndex : shader->l2TextureIndices) {
+				sampledImages.insert(std::make_pair(textureIndex.first, defaultTexture));
+				bindTexture(textureIndex.first, defaultTexture);
+			}
 
 			vk::PushConstantRange pushConstantRange{
 			  .stageFlags = vk::ShaderStageFlagBits::eVertex,
@@ -102,14 +125,18 @@ namespace MRG
 			  .size       = sizeof(CameraData),
 			};
 
+			// Every material shares the layouts of sets 0 and 1 and the push constant range, so their pipeline layouts are all compatible
+			// for these (see Renderer::recordBatches)
 			std::array<vk::DescriptorSetLayout, 4> setLayouts{level0DSL, level1DSL, shader->level2DSL, shader->level3DSL};
-			vk::PipelineLayoutCreateInfo layoutInfo{
-			  .setLayoutCount         = static_cast<uint32_t>(setLayouts.size()),
-			  .pSetLayouts            = setLayouts.data(),
-			  .pushConstantRangeCount = 1,
-			  .pPushConstantRanges    = &pushConstantRange,
-			};
-			pipelineLayout = m_device.createPipelineLayout(layoutInfo);
+			pipelineLayout = layoutCache.getPipelineLayout(setLayouts, std::span{&pushConstantRange, 1});
+		}
+
+		~Material() { m_device.destroyPipeline(pipeline); }
+
+		// Can be called from any thread, as long as the material is not drawn yet. The pipeline cache is internally synchronised.
+		void compilePipeline(vk::PipelineCache pipelineCache, vk::RenderPass renderPass, const MaterialConfiguration& config)
+		{
+			MRG_ENGINE_ASSERT(!isReady(), "The pipeline of this material is already compiled!")
 
 			const VertexInputDescription vertexInfo = VertexType::getVertexDescription();
 			vk::PipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{
@@ -179,14 +206,11 @@ namespace MRG
 			};
 
 			pipeline = pipelineBuilder.build_pipeline(m_device, renderPass);
+			m_isReady.store(true, std::memory_order_release);
 		}
 
-		~Material()
-		{
-			m_device.destroyPipeline(pipeline);
-			m_device.destroyPipelineLayout(pipelineLayout);
-			m_device.destroyDescriptorPool(m_descriptorPool);
-		}
+		// Once this returns true, the pipeline can be read from any thread
+		[[nodiscard]] bool isReady() const { return m_isReady.load(std::memory_order_acquire); }
 
 		[[nodiscard]] const Shader::Root& getUniformInfo(uint32_t bindingSlot) const
 		{
@@ -196,74 +220,83 @@ namespace MRG
 
 		void uploadUniform(uint32_t bindingSlot, const NotPointer auto& uniformData)
 		{
-			MRG_ENGINE_ASSERT(uniformBuffers.contains(bindingSlot), "Invalid binding slot!")
-			void* data;
-			vmaMapMemory(m_allocator, uniformBuffers[bindingSlot].allocation, &data);
-			memcpy(data, &uniformData, sizeof(uniformData));
-			vmaUnmapMemory(m_allocator, uniformBuffers[bindingSlot].allocation);
+			m_descriptorSets.setUniform(bindingSlot, &uniformData, sizeof(uniformData));
 		}
 
 		void uploadUniform(uint32_t bindingSlot, void* srcData, std::size_t size)
 		{
-			MRG_ENGINE_ASSERT(uniformBuffers.contains(bindingSlot), "Invalid binding slot!")
-			void* dstData;
-			vmaMapMemory(m_allocator, uniformBuffers[bindingSlot].allocation, &dstData);
-			memcpy(dstData, srcData, size);
-			vmaUnmapMemory(m_allocator, uniformBuffers[bindingSlot].allocation);
+			m_descriptorSets.setUniform(bindingSlot, srcData, size);
 		}
 
+		// Texture index slots only get the index of the texture in the texture table, without any descriptor update
 		void bindTexture(uint32_t bindingSlot, const Ref<Texture>& texture)
 		{
 			MRG_ENGINE_ASSERT(sampledImages.contains(bindingSlot), "Invalid binding slot!")
-			vk::DescriptorImageInfo imageBufferInfo{
-			  .sampler     = texture->sampler,
-			  .imageView   = texture->image.view,
-			  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-			};
-			vk::WriteDescriptorSet textureUpdate = {
-			  .dstSet          = level2Descriptor,
-			  .dstBinding      = bindingSlot,
-			  .descriptorCount = 1,
-			  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
-			  .pImageInfo      = &imageBufferInfo,
-			};
-			m_device.updateDescriptorSets(textureUpdate, {});
+			if (shader->l2TextureIndices.contains(bindingSlot)) {
+				const auto textureIndex = texture->getBindlessIndex();
+				m_descriptorSets.setUniform(bindingSlot, &textureIndex, sizeof(textureIndex));
+			} else {
+				MRG_ENGINE_ASSERT(!texture->isStreamed(), "Streamed textures can only be bound to texture index slots!")
+				MRG_ENGINE_ASSERT(texture->isLoaded(), "Textures still loading can only be bound to texture index slots!")
+				m_descriptorSets.setImage(bindingSlot, texture->sampler, texture->image.view);
+			}
 
 			sampledImages.at(bindingSlot) = texture;
+			sampledFramebuffers.erase(bindingSlot);
 		}
 
-		// Uses the color attachment of the framebuffer as a texture
+		// Uses the color attachment of the framebuffer as a texture. Framebuffers are not part of the texture table, so they can only be
+		// bound to sampler slots.
 		void bindTexture(uint32_t bindingSlot, const Ref<Framebuffer>& framebuffer)
 		{
-			MRG_ENGINE_ASSERT(sampledImages.contains(bindingSlot), "Invalid binding slot!")
-			vk::DescriptorImageInfo imageBufferInfo{
-			  .sampler     = framebuffer->sampler,
-			  .imageView   = framebuffer->colorImage.view,
-			  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-			};
-			vk::WriteDescriptorSet textureUpdate = {
-			  .dstSet          = level2Descriptor,
-			  .dstBinding      = bindingSlot,
-			  .descriptorCount = 1,
-			  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
-			  .pImageInfo      = &imageBufferInfo,
-			};
-			m_device.updateDescriptorSets(textureUpdate, {});
+			MRG_ENGINE_ASSERT(shader->l2ImageBindings.contains(bindingSlot), "Invalid binding slot!")
+			m_descriptorSets.setImage(bindingSlot, framebuffer->sampler, framebuffer->colorImage.view);
+
+			sampledFramebuffers[bindingSlot] = framebuffer;
+		}
+
+		// Applies the uniform and texture changes made since the given frame was last recorded (see UniformDescriptorSets)
+		[[nodiscard]] vk::DescriptorSet getLevel2Descriptor(uint32_t frameIndex, uint64_t frameNumber)
+		{
+			return m_descriptorSets.getDescriptorSet(frameIndex, frameNumber);
+		}
+		[[nodiscard]] uint32_t getFramesInFlight() const { return m_descriptorSets.getFramesInFlight(); }
+
+		[[nodiscard]] bool hasSharedLevel3Descriptor() const { return shader->l3ImageBindings.empty(); }
+		// Mesh renderers using this material only differ by their model matrix, so the ones sharing a mesh can be drawn all at once
+		[[nodiscard]] bool isInstanceable() const
+		{
+			return shader->isInstanced && shader->l3UBOData.empty() && shader->l3ImageBindings.empty();
+		}
+		// Only valid if the shader does not have any level 3 texture, see hasSharedLevel3Descriptor()
+		[[nodiscard]] vk::DescriptorSet getSharedLevel3Descriptor(uint32_t frameIndex, uint64_t frameNumber)
+		{
+			return m_level3DescriptorSets.getDescriptorSet(frameIndex, frameNumber);
 		}
+		[[nodiscard]] const std::vector<vk::Buffer>& getObjectUniformBuffers() const { return m_objectUniformBuffers; }
+		// 0 if the shader is not instanced
+		[[nodiscard]] vk::DeviceSize getInstanceDataRange() const { return m_instanceDataRange; }
+		// Level 3 descriptor sets of the mesh renderers using this material come from these shared pools
+		[[nodiscard]] const Ref<DescriptorSetAllocator>& getDescriptorSetAllocator() const { return m_setAllocator; }
 
 		vk::Pipeline pipeline;
+		// Owned by the layout cache
 		vk::PipelineLayout pipelineLayout;
-		vk::DescriptorSet level2Descriptor;
 
 		Ref<Shader> shader;
 
-		std::map<uint32_t, AllocatedBuffer> uniformBuffers;
 		std::map<uint32_t, Ref<Texture>> sampledImages;
+		// Framebuffers have to be rendered before anything sampling them is, so they are tracked separately
+		std::map<uint32_t, Ref<Framebuffer>> sampledFramebuffers;
 
 	private:
 		vk::Device m_device;
-		VmaAllocator m_allocator;
-		vk::DescriptorPool m_descriptorPool;
+		Ref<DescriptorSetAllocator> m_setAllocator;
+		std::vector<vk::Buffer> m_objectUniformBuffers;
+		vk::DeviceSize m_instanceDataRange;
+		UniformDescriptorSets m_descriptorSets;
+		UniformDescriptorSets m_level3DescriptorSets{};
+		std::atomic<bool> m_isReady{false};
 	};
 }  // namespace MRG
 
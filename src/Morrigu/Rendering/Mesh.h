@@ -6,6 +6,7 @@
 #define MORRIGU_MESH_H
 
 #include "Core/FileNames.h"
+#include "Rendering/Bounds.h"
 #include "Rendering/RendererTypes.h"
 #include "Rendering/Vertex.h"
 #include "Utils/GLMIncludeHelper.h"
@@ -19,7 +20,15 @@ namespace MRG
 	{
 	public:
 		std::vector<VertexType> vertices;
+		std::vector<uint32_t> indices;
 		AllocatedBuffer vertexBuffer;
+		AllocatedBuffer indexBuffer;
+		// Number of indices uploaded to the index buffer. Meshes uploaded from cooked files do not keep a CPU copy of their data, so
+		// this is the value to use when drawing
+		uint32_t indexCount{0};
+		// Local space bounds, computed when the mesh is uploaded
+		BoundingBox bounds{};
+		BoundingSphere boundingSphere{};
 	};
 }  // namespace MRG
 
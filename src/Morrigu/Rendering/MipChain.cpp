@@ -0,0 +1,133 @@
+#include "MipChain.h"
+
+#include "Core/Core.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+	constexpr std::size_t channelCount = 4;
+
+	[[nodiscard]] float srgbToLinear(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+	[[nodiscard]] float linearToSRGB(float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+	}
+
+	[[nodiscard]] const std::array<float, 256>& getSRGBToLinearTable()
+	{
+		static const auto table = []() {
+			std::array<float, 256> result{};
+			for (std::size_t i = 0; i < result.size(); ++i) { result[i] = srgbToLinear(static_cast<float>(i) / 255.f); }
+			return result;
+		}();
+		return table;
+	}
+
+	// Odd sizes are handled by clamping the samples to the edge of the source level
+	void downsample(std::span<const std::byte> src,
+	                const MRG::MipLevel& srcLevel,
+	                std::span<std::byte> dst,
+	                const MRG::MipLevel& dstLevel,
+	                bool isSRGB)
+	{
+		const auto& toLinear   = getSRGBToLinearTable();
+		const auto texelOffset = [&srcLevel](uint32_t x, uint32_t y) {
+			return (static_cast<std::size_t>(y) * srcLevel.width + x) * channelCount;
+		};
+
+		for (uint32_t y = 0; y < dstLevel.height; ++y) {
+			const auto y0 = std::min(2 * y, srcLevel.height - 1);
+			const auto y1 = std::min(2 * y + 1, srcLevel.height - 1);
+			for (uint32_t x = 0; x < dstLevel.width; ++x) {
+				const auto x0 = std::min(2 * x, srcLevel.width - 1);
+				const auto x1 = std::min(2 * x + 1, srcLevel.width - 1);
+
+				const std::array<std::size_t, 4> samples{
+				  texelOffset(x0, y0),
+				  texelOffset(x1, y0),
+				  texelOffset(x0, y1),
+				  texelOffset(x1, y1),
+				};
+				const auto dstOffset = (static_cast<std::size_t>(y) * dstLevel.width + x) * channelCount;
+				for (std::size_t channel = 0; channel < channelCount; ++channel) {
+					// Alpha is always linear
+					if (isSRGB && channel < 3) {
+						float sum = 0.f;
+						for (const auto sample : samples) { sum += toLinear[std::to_integer<std::size_t>(src[sample + channel])]; }
+						const auto value         = std::clamp(linearToSRGB(sum / 4.f), 0.f, 1.f);
+						dst[dstOffset + channel] = static_cast<std::byte>(static_cast<uint32_t>(value * 255.f + 0.5f));
+					} else {
+						uint32_t sum = 2;
+						for (const auto sample : samples) { sum += std::to_integer<uint32_t>(src[sample + channel]); }
+						dst[dstOffset + channel] = static_cast<std::byte>(sum / 4);
+					}
+				}
+			}
+		}
+	}
+}  // namespace
+
+namespace MRG
+{
+	MipChain generateMipChain(std::span<const std::byte> pixels, uint32_t width, uint32_t height, bool isSRGB)
+	{
+		MRG_ENGINE_ASSERT(pixels.size() == static_cast<std::size_t>(width) * height * channelCount, "Invalid RGBA8 image size!")
+
+		MipChain chain{};
+		std::size_t offset   = 0;
+		uint32_t levelWidth  = width;
+		uint32_t levelHeight = height;
+		while (true) {
+			const auto size = static_cast<std::size_t>(levelWidth) * levelHeight * channelCount;
+			chain.levels.push_back(MipLevel{
+			  .width  = levelWidth,
+			  .height = levelHeight,
+			  .offset = offset,
+			  .size   = size,
+			});
+			offset += size;
+
+			if (levelWidth == 1 && levelHeight == 1) { break; }
+			levelWidth  = std::max(levelWidth / 2, 1u);
+			levelHeight = std::max(levelHeight / 2, 1u);
+		}
+
+		chain.data.resize(offset);
+		std::memcpy(chain.data.data(), pixels.data(), pixels.size());
+		for (std::size_t level = 1; level < chain.levels.size(); ++level) {
+			const auto& srcLevel = chain.levels[level - 1];
+			const auto& dstLevel = chain.levels[level];
+			downsample(std::span{chain.data}.subspan(srcLevel.offset, srcLevel.size),
+			           srcLevel,
+			           std::span{chain.data}.subspan(dstLevel.offset, dstLevel.size),
+			           dstLevel,
+			           isSRGB);
+		}
+
+		return chain;
+	}
+
+	MipChain loadMipChain(const char* filePath, bool isSRGB)
+	{
+		int width, height, channels;
+		auto* pixels = stbi_load(filePath, &width, &height, &channels, STBI_rgb_alpha);
+		if (pixels == nullptr) { throw std::runtime_error(fmt::format("Failed to load image from file: {}", filePath)); }
+
+		const auto imageSize = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * channelCount;
+		const auto imageData = std::as_bytes(std::span{pixels, imageSize});
+		auto chain           = generateMipChain(imageData, static_cast<uint32_t>(width), static_cast<uint32_t>(height), isSRGB);
+		stbi_image_free(pixels);
+
+		return chain;
+	}
+}  // namespace MRG
@@ -0,0 +1,43 @@
+#ifndef MORRIGU_MIPCHAIN_H
+#define MORRIGU_MIPCHAIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MRG
+{
+	struct MipLevel
+	{
+		uint32_t width;
+		uint32_t height;
+		// In bytes, from the beginning of the chain data
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	// Every mip level of an image, tightly packed from the full resolution one down to 1x1. Levels are RGBA8 when generated by
+	// generateMipChain, but can be in any format (block compressed ones for example).
+	struct MipChain
+	{
+		std::vector<std::byte> data{};
+		std::vector<MipLevel> levels{};
+
+		[[nodiscard]] std::span<const std::byte> getLevelData(uint32_t level) const
+		{
+			return std::span{data}.subspan(levels[level].offset, levels[level].size);
+		}
+		// Size of the given level and of every smaller one
+		[[nodiscard]] std::size_t getSize(uint32_t firstLevel) const { return data.size() - levels[firstLevel].offset; }
+		[[nodiscard]] uint32_t getLevelCount() const { return static_cast<uint32_t>(levels.size()); }
+	};
+
+	// Each level is a 2x2 box filter of the previous one. sRGB images are filtered in linear space, so that they do not get darker with
+	// each level.
+	[[nodiscard]] MipChain generateMipChain(std::span<const std::byte> pixels, uint32_t width, uint32_t height, bool isSRGB);
+	// Decodes the image file into RGBA8 pixels, and generates its mip chain
+	[[nodiscard]] MipChain loadMipChain(const char* filePath, bool isSRGB);
+}  // namespace MRG
+
+#endif  // MORRIGU_MIPCHAIN_H
@@ -0,0 +1,138 @@
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <cstring>
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_ALIGNMENT_MODIFIED
+#include <filesystem>
+DISABLE_WARNING_POP
+#include <fstream>
+
+namespace
+{
+	[[nodiscard]] double toMilliseconds(std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>{duration}.count();
+	}
+}  // namespace
+
+namespace MRG
+{
+	PipelineCache::PipelineCache(vk::Device device, const vk::PhysicalDeviceProperties& properties, std::string filePath)
+	    : m_device{device}, m_properties{properties}, m_filePath{std::move(filePath)}
+	{
+		std::vector<uint8_t> pipelineData{};
+		if (std::filesystem::exists(m_filePath)) {
+			std::ifstream pipelineCacheFile{m_filePath, std::ios::binary | std::ios::ate};
+			const auto fileSize = static_cast<std::size_t>(pipelineCacheFile.tellg());
+			pipelineData.resize(fileSize);
+			pipelineCacheFile.seekg(0, std::ios::beg);
+			pipelineCacheFile.read(reinterpret_cast<char*>(pipelineData.data()), static_cast<std::streamsize>(fileSize));
+			if (!pipelineCacheFile) {
+				MRG_ENGINE_WARN("Failed to read pipeline cache \"{}\", starting with an empty cache.", m_filePath)
+				pipelineData.clear();
+			} else if (!isCompatible(pipelineData)) {
+				pipelineData.clear();
+			}
+		}
+
+		vk::PipelineCacheCreateInfo pipelineCacheCreateInfo{
+		  .initialDataSize = pipelineData.size(),
+		  .pInitialData    = pipelineData.data(),
+		};
+		m_handle                    = m_device.createPipelineCache(pipelineCacheCreateInfo);
+		m_statistics.loadedFromDisk = !pipelineData.empty();
+		if (m_statistics.loadedFromDisk) { MRG_ENGINE_TRACE("Pipeline cache loaded ({} bytes).", pipelineData.size()) }
+	}
+
+	PipelineCache::~PipelineCache() { m_device.destroyPipelineCache(m_handle); }
+
+	void PipelineCache::save() const
+	{
+		const auto pipelineData = m_device.getPipelineCacheData(m_handle);
+		const auto tempFilePath = m_filePath + ".tmp";
+		{
+			std::ofstream pipelineCacheFile{tempFilePath, std::ios::binary | std::ios::trunc};
+			pipelineCacheFile.write(reinterpret_cast<const char*>(pipelineData.data()), static_cast<std::streamsize>(pipelineData.size()));
+			if (!pipelineCacheFile) {
+				MRG_ENGINE_ERROR("Failed to write pipeline cache \"{}\".", tempFilePath)
+				return;
+			}
+		}
+
+		// Renaming over an existing file is atomic, so the previous cache stays intact until the new one is complete
+		std::error_code error{};
+		std::filesystem::rename(tempFilePath, m_filePath, error);
+		if (error) {
+			MRG_ENGINE_ERROR("Failed to replace pipeline cache \"{}\": {}", m_filePath, error.message())
+			std::filesystem::remove(tempFilePath, error);
+		}
+	}
+
+	PipelineCacheStatistics PipelineCache::getStatistics() const
+	{
+		std::lock_guard lock{m_statisticsMutex};
+		return m_statistics;
+	}
+
+	void PipelineCache::logStatistics() const
+	{
+		std::lock_guard lock{m_statisticsMutex};
+		MRG_ENGINE_INFO("Pipeline cache ({}): {} hits in {:.2f}ms, {} misses in {:.2f}ms",
+		                m_statistics.loadedFromDisk ? "warm" : "cold",
+		                m_statistics.hits,
+		                toMilliseconds(m_statistics.hitTime),
+		                m_statistics.misses,
+		                toMilliseconds(m_statistics.missTime))
+	}
+
+	bool PipelineCache::isCompatible(const std::vector<uint8_t>& data) const
+	{
+		VkPipelineCacheHeaderVersionOne header{};
+		if (data.size() < sizeof(header)) {
+			MRG_ENGINE_WARN("Pipeline cache \"{}\" is truncated, discarding it.", m_filePath)
+			return false;
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		if (header.headerSize < sizeof(header) || header.headerSize > data.size() ||
+		    header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+			MRG_ENGINE_WARN("Pipeline cache \"{}\" has an invalid header, discarding it.", m_filePath)
+			return false;
+		}
+		if (header.vendorID != m_properties.vendorID || header.deviceID != m_properties.deviceID) {
+			MRG_ENGINE_WARN("Pipeline cache \"{}\" was created on another GPU ({:#x}:{:#x}), discarding it.",
+			                m_filePath,
+			                header.vendorID,
+			                header.deviceID)
+			return false;
+		}
+		if (!std::equal(std::begin(header.pipelineCacheUUID), std::end(header.pipelineCacheUUID), m_properties.pipelineCacheUUID.begin())) {
+			MRG_ENGINE_WARN("Pipeline cache \"{}\" was created by another driver version, discarding it.", m_filePath)
+			return false;
+		}
+
+		return true;
+	}
+
+	std::size_t PipelineCache::getDataSize() const
+	{
+		std::size_t size = 0;
+		MRG_VK_CHECK(vkGetPipelineCacheData(m_device, m_handle, &size, nullptr), "Failed to query pipeline cache size!")
+		return size;
+	}
+
+	void PipelineCache::record(std::size_t sizeBefore, std::chrono::steady_clock::duration duration)
+	{
+		const auto isHit = getDataSize() == sizeBefore;
+		std::lock_guard lock{m_statisticsMutex};
+		if (isHit) {
+			++m_statistics.hits;
+			m_statistics.hitTime += duration;
+		} else {
+			++m_statistics.misses;
+			m_statistics.missTime += duration;
+		}
+		MRG_ENGINE_TRACE("Pipeline created in {:.2f}ms (cache {}).", toMilliseconds(duration), isHit ? "hit" : "miss")
+	}
+}  // namespace MRG
@@ -0,0 +1,81 @@
+#ifndef MORRIGU_PIPELINECACHE_H
+#define MORRIGU_PIPELINECACHE_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MRG
+{
+	struct PipelineCacheStatistics
+	{
+		bool loadedFromDisk{false};
+		uint32_t hits{0};
+		uint32_t misses{0};
+		std::chrono::steady_clock::duration hitTime{0};
+		std::chrono::steady_clock::duration missTime{0};
+	};
+
+	// Vulkan pipeline cache persisted on disk between runs.
+	// The saved data is only used if it was written by the same driver on the same GPU, as drivers are free to reject (or worse, crash on)
+	// foreign data.
+	class PipelineCache
+	{
+	public:
+		PipelineCache(vk::Device device, const vk::PhysicalDeviceProperties& properties, std::string filePath);
+		PipelineCache(const PipelineCache&) = delete;
+		PipelineCache(PipelineCache&&)      = delete;
+		~PipelineCache();
+
+		PipelineCache& operator=(const PipelineCache&) = delete;
+		PipelineCache& operator=(PipelineCache&&) = delete;
+
+		// Writes the data to a temporary file first, so that a crash while saving never leaves a truncated cache behind
+		void save() const;
+
+		// Calls createPipeline and records how long it took, and whether the pipeline was found in the cache. Drivers only grow the cache
+		// data when they compile something new, so the pipeline is considered a hit when the data size did not change. This is only
+		// approximate when several pipelines are compiled at the same time, as a miss on another thread then turns hits into misses.
+		// Can be called from any thread.
+		template<typename Function>
+		auto track(Function&& createPipeline)
+		{
+			const auto sizeBefore = getDataSize();
+			const auto start      = std::chrono::steady_clock::now();
+			if constexpr (std::is_void_v<std::invoke_result_t<Function>>) {
+				std::forward<Function>(createPipeline)();
+				record(sizeBefore, std::chrono::steady_clock::now() - start);
+			} else {
+				auto result = std::forward<Function>(createPipeline)();
+				record(sizeBefore, std::chrono::steady_clock::now() - start);
+				return result;
+			}
+		}
+
+		[[nodiscard]] vk::PipelineCache getHandle() const { return m_handle; }
+		[[nodiscard]] PipelineCacheStatistics getStatistics() const;
+		void logStatistics() const;
+
+	private:
+		[[nodiscard]] bool isCompatible(const std::vector<uint8_t>& data) const;
+		[[nodiscard]] std::size_t getDataSize() const;
+		void record(std::size_t sizeBefore, std::chrono::steady_clock::duration duration);
+
+		vk::Device m_device;
+		vk::PhysicalDeviceProperties m_properties;
+		std::string m_filePath;
+		vk::PipelineCache m_handle{};
+
+		mutable std::mutex m_statisticsMutex{};
+		PipelineCacheStatistics m_statistics{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_PIPELINECACHE_H
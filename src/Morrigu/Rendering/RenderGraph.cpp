@@ -0,0 +1,74 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <array>
+
+namespace MRG
+{
+	void RenderGraph::addPass(const Ref<Framebuffer>& target,
+	                          std::vector<vk::CommandBuffer> commandBuffers,
+	                          std::vector<const Framebuffer*> sampledFramebuffers)
+	{
+		MRG_ENGINE_ASSERT(std::ranges::none_of(m_passes, [&target](const Pass& pass) { return pass.target == target; }),
+		                  "A framebuffer can only be drawn to once per frame!")
+
+		m_passes.push_back(Pass{
+		  .target              = target,
+		  .commandBuffers      = std::move(commandBuffers),
+		  .sampledFramebuffers = std::move(sampledFramebuffers),
+		});
+	}
+
+	void RenderGraph::record(vk::CommandBuffer commandBuffer, vk::RenderPass renderPass)
+	{
+		std::vector<VisitState> states(m_passes.size(), VisitState::NotVisited);
+		std::vector<std::size_t> sortedPasses{};
+		sortedPasses.reserve(m_passes.size());
+		for (std::size_t passIndex = 0; passIndex < m_passes.size(); ++passIndex) { visit(passIndex, states, sortedPasses); }
+
+		for (const auto passIndex : sortedPasses) {
+			const auto& pass = m_passes[passIndex];
+
+			vk::ClearValue colorClearValue{};
+			colorClearValue.color = {pass.target->spec.clearColor};
+			vk::ClearValue depthClearValue{};
+			depthClearValue.depthStencil.depth = 1.f;
+
+			std::array<vk::ClearValue, 2> clearValues{colorClearValue, depthClearValue};
+
+			vk::RenderPassBeginInfo renderPassInfo{
+			  .renderPass  = renderPass,
+			  .framebuffer = pass.target->vkHandle,
+			  .renderArea =
+			    vk::Rect2D{
+			      .offset = {0, 0},
+			      .extent = {pass.target->spec.width, pass.target->spec.height},
+			    },
+			  .clearValueCount = static_cast<uint32_t>(clearValues.size()),
+			  .pClearValues    = clearValues.data(),
+			};
+			commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eSecondaryCommandBuffers);
+			if (!pass.commandBuffers.empty()) { commandBuffer.executeCommands(pass.commandBuffers); }
+			commandBuffer.endRenderPass();
+		}
+
+		m_passes.clear();
+	}
+
+	void RenderGraph::visit(std::size_t passIndex, std::vector<VisitState>& states, std::vector<std::size_t>& sortedPasses) const
+	{
+		// A cycle means a framebuffer is (indirectly) sampled while being rendered to: the dependency is ignored, and the sampled
+		// framebuffer will contain the result of the previous frame
+		if (states[passIndex] != VisitState::NotVisited) { return; }
+		states[passIndex] = VisitState::InProgress;
+
+		for (const auto* sampledFramebuffer : m_passes[passIndex].sampledFramebuffers) {
+			for (std::size_t dependencyIndex = 0; dependencyIndex < m_passes.size(); ++dependencyIndex) {
+				if (m_passes[dependencyIndex].target.get() == sampledFramebuffer) { visit(dependencyIndex, states, sortedPasses); }
+			}
+		}
+
+		states[passIndex] = VisitState::Done;
+		sortedPasses.push_back(passIndex);
+	}
+}  // namespace MRG
@@ -0,0 +1,48 @@
+#ifndef MORRIGU_RENDERGRAPH_H
+#define MORRIGU_RENDERGRAPH_H
+
+#include "Rendering/Framebuffer.h"
+
+#include <vector>
+
+namespace MRG
+{
+	// Collects the offscreen passes of a frame, and records them in an order where every framebuffer is rendered before the passes
+	// sampling it. All passes end up in the same primary command buffer, submitted right before the frame's own, and the ordering
+	// between them (and with the swapchain pass) is done by the framebuffer render pass external dependencies: the CPU never waits.
+	class RenderGraph
+	{
+	public:
+		// The command buffers are secondary command buffers recorded to continue the framebuffer render pass, executed in order. Each
+		// framebuffer may only be drawn to once per frame.
+		void addPass(const Ref<Framebuffer>& target,
+		             std::vector<vk::CommandBuffer> commandBuffers,
+		             std::vector<const Framebuffer*> sampledFramebuffers);
+
+		// Records every pass added since the last call into the given primary command buffer, and clears the graph
+		void record(vk::CommandBuffer commandBuffer, vk::RenderPass renderPass);
+
+		[[nodiscard]] bool isEmpty() const { return m_passes.empty(); }
+
+	private:
+		struct Pass
+		{
+			Ref<Framebuffer> target;
+			std::vector<vk::CommandBuffer> commandBuffers;
+			std::vector<const Framebuffer*> sampledFramebuffers;
+		};
+
+		enum class VisitState
+		{
+			NotVisited,
+			InProgress,
+			Done,
+		};
+
+		std::vector<Pass> m_passes{};
+
+		void visit(std::size_t passIndex, std::vector<VisitState>& states, std::vector<std::size_t>& sortedPasses) const;
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_RENDERGRAPH_H
@@ -0,0 +1,56 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace MRG
+{
+	void RenderQueue::clear()
+	{
+		m_items.clear();
+		m_sortIDs.clear();
+	}
+
+	uint16_t RenderQueue::getSortID(const void* object)
+	{
+		static constexpr auto maxID = std::numeric_limits<uint16_t>::max();
+
+		const auto newID = static_cast<uint16_t>(std::min(m_sortIDs.size(), std::size_t{maxID}));
+		return m_sortIDs.try_emplace(object, newID).first->second;
+	}
+
+	uint64_t RenderQueue::makeKey(uint16_t pipelineID, uint16_t materialID, uint16_t meshID, float depth)
+	{
+		// The bit pattern of positive floats sorts the same way as their values, so its top bits are a cheap quantisation
+		const auto clampedDepth = std::max(depth, 0.f);
+		uint32_t depthBits;
+		memcpy(&depthBits, &clampedDepth, sizeof(depthBits));
+
+		return (uint64_t{pipelineID} << 48) | (uint64_t{materialID} << 32) | (uint64_t{meshID} << 16) | uint64_t{depthBits >> 16};
+	}
+
+	void RenderQueue::sort()
+	{
+		m_sortBuffer.resize(m_items.size());
+
+		for (uint32_t shift = 0; shift < 64; shift += 8) {
+			std::array<std::size_t, 256> offsets{};
+			for (const auto& item : m_items) { ++offsets[(item.key >> shift) & 0xFF]; }
+			// Every key has the same value for this digit, the pass would not change anything
+			if (std::ranges::find(offsets, m_items.size()) != offsets.end()) { continue; }
+
+			std::size_t total = 0;
+			for (auto& offset : offsets) {
+				const auto count = offset;
+				offset           = total;
+				total += count;
+			}
+			for (const auto& item : m_items) { m_sortBuffer[offsets[(item.key >> shift) & 0xFF]++] = item; }
+
+			std::swap(m_items, m_sortBuffer);
+		}
+	}
+}  // namespace MRG
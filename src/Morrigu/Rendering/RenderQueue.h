@@ -0,0 +1,44 @@
+#ifndef MORRIGU_RENDERQUEUE_H
+#define MORRIGU_RENDERQUEUE_H
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace MRG
+{
+	// Orders the draws of a recording with 64 bits keys, so that draws sharing a pipeline, then a material, then a mesh end up next to
+	// each other (and front to back inside of those), minimising state changes.
+	// Key layout, from the most significant bits: pipeline (16 bits), material (16 bits), mesh (16 bits), depth (16 bits).
+	class RenderQueue
+	{
+	public:
+		struct Item
+		{
+			uint64_t key;
+			// Index of the draw in the caller's own list
+			uint32_t index;
+		};
+
+		void clear();
+
+		// Returns a small ID for the given object, unique until the next clear. IDs are only used for sorting: past 65535 different
+		// objects, the remaining ones all share the last ID, which only makes the order less optimal.
+		[[nodiscard]] uint16_t getSortID(const void* object);
+		[[nodiscard]] static uint64_t makeKey(uint16_t pipelineID, uint16_t materialID, uint16_t meshID, float depth);
+
+		void push(uint64_t key, uint32_t index) { m_items.push_back(Item{.key = key, .index = index}); }
+		// Stable LSD radix sort on the keys
+		void sort();
+
+		[[nodiscard]] std::span<const Item> getItems() const { return m_items; }
+
+	private:
+		std::vector<Item> m_items{};
+		std::vector<Item> m_sortBuffer{};
+		std::unordered_map<const void*, uint16_t> m_sortIDs{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_RENDERQUEUE_H
@@ -9,11 +9,7 @@
 #include <VkBootstrap.h>
 #include <imgui.h>
 
-DISABLE_WARNING_PUSH
-DISABLE_WARNING_ALIGNMENT_MODIFIED
-#include <filesystem>
-DISABLE_WARNING_POP
-#include <fstream>
+#include <algorithm>
 
 namespace
 {
@@ -88,6 +84,13 @@ namespace MRG
 		spec   = newSpec;
 		window = newWindow;
 
+		MRG_ENGINE_ASSERT(spec.framesInFlight >= 1 && spec.framesInFlight <= MAX_FRAMES_IN_FLIGHT,
+		                  "Invalid frames in flight count: {} (expected between 1 and {})",
+		                  spec.framesInFlight,
+		                  MAX_FRAMES_IN_FLIGHT)
+		MRG_ENGINE_ASSERT(spec.maxInstancesPerDraw >= 1, "Invalid max instances per draw: {}", spec.maxInstancesPerDraw)
+		m_framesData.resize(spec.framesInFlight);
+
 		initVulkan();
 		initSwapchain();
 		initCommands();
@@ -104,62 +107,108 @@ namespace MRG
 
 	Renderer::~Renderer()
 	{
+		// Pending pipeline compilations use the device and the pipeline cache
+		try {
+			Jobs::wait(m_pipelineJobs);
+		} catch (const std::exception& exception) {
+			MRG_ENGINE_ERROR("Pipeline compilation failed: {}", exception.what())
+		}
 		m_device.waitIdle();
+		m_textureStreamer.reset();
+		// Waits for the textures still being decoded
+		m_textureLoader.reset();
+		m_uploadQueue.reset();
+		m_stagingBuffer.reset();
+
+		if (!spec.headless) {
+			ImGui_ImplVulkan_Shutdown();
+			ImGui_ImplGlfw_Shutdown();
+			ImGui::DestroyContext();
+			m_device.destroyDescriptorPool(m_imGuiPool);
+		}
 
-		ImGui_ImplVulkan_Shutdown();
-		ImGui_ImplGlfw_Shutdown();
-		ImGui::DestroyContext();
-		m_device.destroyDescriptorPool(m_imGuiPool);
-
-		const auto newPipelineCacheData = m_device.getPipelineCacheData(m_pipelineCache);
-		std::ofstream pipelineCacheFile{Files::Rendering::vkPipelineCacheFile, std::ios::binary | std::ios::trunc};
-		pipelineCacheFile.write(reinterpret_cast<const char*>(newPipelineCacheData.data()),
-		                        static_cast<std::streamsize>(newPipelineCacheData.size()));
-		m_device.destroyPipelineCache(m_pipelineCache);
+		m_pipelineCache->logStatistics();
+		m_pipelineCache->save();
+		m_pipelineCache.reset();
 
-		m_device.destroyDescriptorSetLayout(m_level1DSL);
-		m_device.destroyDescriptorSetLayout(m_level0DSL);
 		m_device.destroyDescriptorPool(m_descriptorPool);
+		m_layoutCache.reset();
+		m_samplerCache.reset();
 
-		m_device.destroyFence(m_uploadContext.uploadFence);
 		for (auto& frameData : m_framesData) {
 			m_device.destroySemaphore(frameData.presentSemaphore);
 			m_device.destroySemaphore(frameData.renderSemaphore);
 			m_device.destroyFence(frameData.renderFence);
 
 			m_device.destroyCommandPool(frameData.commandPool);
+			frameData.recordingPools.clear();
+
+			frameData.objectUniformBuffer.reset();
 		}
+	}
 
-		m_device.destroyCommandPool(m_uploadContext.commandPool);
+	std::vector<vk::Buffer> Renderer::getObjectUniformBuffers() const
+	{
+		std::vector<vk::Buffer> buffers{};
+		buffers.reserve(m_framesData.size());
+		for (const auto& frameData : m_framesData) { buffers.push_back(frameData.objectUniformBuffer->getVkHandle()); }
+
+		return buffers;
 	}
 
 	Ref<Shader> Renderer::createShader(const char* vertexShaderName, const char* fragmentShaderName)
 	{
-		return MRG::createRef<Shader>(m_device, vertexShaderName, fragmentShaderName);
+		auto& cachedShader = m_shaders[std::make_pair(std::string{vertexShaderName}, std::string{fragmentShaderName})];
+		if (auto shader = cachedShader.lock()) { return shader; }
+
+		auto shader  = MRG::createRef<Shader>(m_device, *m_layoutCache, vertexShaderName, fragmentShaderName);
+		cachedShader = shader;
+		return shader;
+	}
+
+	Ref<Texture> Renderer::createTexture(void* data, uint32_t width, uint32_t height, SamplerPreset samplerPreset)
+	{
+		const auto sampler = m_samplerCache->getSampler(samplerPreset, vk::SamplerAddressMode::eClampToEdge);
+		auto texture       = createRef<Texture>(m_device, *m_uploadQueue, m_allocator, data, width, height, sampler);
+		m_textureTable->add(*texture);
+		return texture;
+	}
+
+	Ref<Texture> Renderer::createTexture(const char* fileName, SamplerPreset samplerPreset)
+	{
+		const auto sampler = m_samplerCache->getSampler(samplerPreset, vk::SamplerAddressMode::eRepeat);
+		auto texture       = createRef<Texture>(m_device, *m_uploadQueue, m_allocator, fileName, m_useCookedTextures, sampler);
+		m_textureTable->add(*texture);
+		return texture;
 	}
 
-	Ref<Texture> Renderer::createTexture(void* data, uint32_t width, uint32_t height)
+	Ref<Texture> Renderer::createTextureAsync(const char* fileName, SamplerPreset samplerPreset)
 	{
-		return createRef<Texture>(m_device, m_graphicsQueue, m_uploadContext, m_allocator, data, width, height);
+		const auto sampler = m_samplerCache->getSampler(samplerPreset, vk::SamplerAddressMode::eRepeat);
+		auto texture       = m_textureLoader->loadTexture(fileName, defaultTexture, sampler);
+		m_textureTable->add(*texture);
+		return texture;
 	}
 
-	Ref<Texture> Renderer::createTexture(const char* fileName)
+	Ref<Texture> Renderer::createStreamedTexture(const char* fileName, SamplerPreset samplerPreset)
 	{
-		return createRef<Texture>(m_device, m_graphicsQueue, m_uploadContext, m_allocator, fileName);
+		const auto sampler = m_samplerCache->getSampler(samplerPreset, vk::SamplerAddressMode::eRepeat);
+		auto texture       = m_textureStreamer->createTexture(fileName, sampler);
+		m_textureTable->add(*texture);
+		return texture;
 	}
 
 	Ref<Framebuffer> Renderer::createFrameBuffer(const FramebufferSpecification& fbSpec)
 	{
 		Framebuffer::VulkanObjects objs{
 		  .device             = m_device,
-		  .graphicsQueue      = m_graphicsQueue,
-		  .uploadContext      = m_uploadContext,
+		  .uploadQueue        = m_uploadQueue.get(),
 		  .allocator          = m_allocator,
+		  .samplerCache       = m_samplerCache.get(),
 		  .swapchainFormat    = m_swapchainFormat,
 		  .depthImageFormat   = m_depthImage.spec.format,
 		  .renderPass         = m_fbRenderPass,
 		  .graphicsQueueIndex = m_graphicsQueueIndex,
-		  .level0DSL          = m_level0DSL,
 		};
 		return createRef<Framebuffer>(fbSpec, objs);
 	}
@@ -170,6 +219,31 @@ namespace MRG
 		MRG_VK_CHECK_HPP(m_device.waitForFences(frameData.renderFence, VK_TRUE, UINT64_MAX), "failed to wait for render fence!")
 		m_device.resetFences(frameData.renderFence);
 
+		// The GPU is done with this frame's resources, they can safely be written to
+		frameData.objectUniformBuffer->reset();
+		m_textureTable->beginFrame(getCurrentFrameIndex());
+		m_descriptorSetAllocator->beginFrame();
+		for (const auto& recordingPool : frameData.recordingPools) { recordingPool->reset(); }
+		m_mainPassCommandBuffers.clear();
+		m_frameStatistics = FrameStatistics{};
+
+		TimeData timeData{
+		  // Shamelessly stolen from https://docs.unity3d.com/Manual/SL-UnityShaderVariables.html
+		  .time = {elapsedTime / 20.f, elapsedTime, elapsedTime * 2.f, elapsedTime * 3.f},
+		};
+		frameData.timeDataBuffer.write(&timeData, sizeof(TimeData));
+
+		vk::CommandBufferBeginInfo beginInfo{
+		  .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+		};
+
+		if (spec.headless) {
+			// Nothing to acquire nor to render into: the frame command buffer is only opened for offscreen work
+			frameData.commandBuffer.reset();
+			frameData.commandBuffer.begin(beginInfo);
+			return true;
+		}
+
 		try {
 			m_imageIndex = m_device.acquireNextImageKHR(m_swapchain, UINT64_MAX, frameData.presentSemaphore).value;
 		} catch (const vk::OutOfDateKHRError&) {
@@ -179,11 +253,55 @@ namespace MRG
 			return false;
 		}
 
+		// The fence of the current frame has already been waited on above (and reset since)
+		if (m_imagesInFlight[m_imageIndex] != vk::Fence{} && m_imagesInFlight[m_imageIndex] != frameData.renderFence) {
+			MRG_VK_CHECK_HPP(m_device.waitForFences(m_imagesInFlight[m_imageIndex], VK_TRUE, UINT64_MAX),
+			                 "failed to wait for swapchain image fence!")
+		}
+		m_imagesInFlight[m_imageIndex] = frameData.renderFence;
+
 		frameData.commandBuffer.reset();
+		frameData.commandBuffer.begin(beginInfo);
+
+		return true;
+	}
+
+	void Renderer::endFrame()
+	{
+		// Textures refined or loaded from now on are only seen by the next frames, as this one keeps its texture table as is
+		m_textureTable->endFrame();
+		m_textureStreamer->update();
+		m_textureLoader->update();
+
+		// Everything uploaded during this frame has to be submitted before the frame itself
+		m_uploadQueue->flush();
+
+		const auto& frameData = getCurrentFrameData();
+		frameData.objectUniformBuffer->flush();
+
+		// Framebuffer passes go in their own command buffer, submitted in the same batch right before the frame one. The render pass
+		// dependencies of the framebuffers order them with anything sampling their attachments, so the CPU never has to wait on them.
+		frameData.offscreenCommandBuffer.reset();
 		vk::CommandBufferBeginInfo beginInfo{
 		  .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
 		};
-		frameData.commandBuffer.begin(beginInfo);
+		frameData.offscreenCommandBuffer.begin(beginInfo);
+		m_renderGraph.record(frameData.offscreenCommandBuffer, m_fbRenderPass);
+		frameData.offscreenCommandBuffer.end();
+
+		std::array<vk::CommandBuffer, 2> commandBuffers{frameData.offscreenCommandBuffer, frameData.commandBuffer};
+
+		if (spec.headless) {
+			frameData.commandBuffer.end();
+
+			vk::SubmitInfo submitInfo{
+			  .commandBufferCount = static_cast<uint32_t>(commandBuffers.size()),
+			  .pCommandBuffers    = commandBuffers.data(),
+			};
+			m_graphicsQueue.submit(submitInfo, frameData.renderFence);
+			++m_frameNumber;
+			return;
+		}
 
 		vk::ClearValue colorClearValue{};
 		colorClearValue.color = {std::array<float, 4>{clearColor.r, clearColor.g, clearColor.b}};
@@ -203,14 +321,9 @@ namespace MRG
 		  .clearValueCount = static_cast<uint32_t>(clearValues.size()),
 		  .pClearValues    = clearValues.data(),
 		};
-		frameData.commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-
-		return true;
-	}
-
-	void Renderer::endFrame()
-	{
-		const auto& frameData = getCurrentFrameData();
+		// Everything drawn to the swapchain (including ImGui) was recorded into secondary command buffers, possibly on several threads
+		frameData.commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eSecondaryCommandBuffers);
+		if (!m_mainPassCommandBuffers.empty()) { frameData.commandBuffer.executeCommands(m_mainPassCommandBuffers); }
 		frameData.commandBuffer.endRenderPass();
 		frameData.commandBuffer.end();
 
@@ -220,8 +333,8 @@ namespace MRG
 		  .waitSemaphoreCount   = 1,
 		  .pWaitSemaphores      = &frameData.presentSemaphore,
 		  .pWaitDstStageMask    = &waitStage,
-		  .commandBufferCount   = 1,
-		  .pCommandBuffers      = &frameData.commandBuffer,
+		  .commandBufferCount   = static_cast<uint32_t>(commandBuffers.size()),
+		  .pCommandBuffers      = commandBuffers.data(),
 		  .signalSemaphoreCount = 1,
 		  .pSignalSemaphores    = &frameData.renderSemaphore,
 		};
@@ -243,6 +356,8 @@ namespace MRG
 
 	void Renderer::beginImGui()
 	{
+		if (spec.headless) { return; }
+
 		ImGui_ImplGlfw_NewFrame();
 		ImGui_ImplVulkan_NewFrame();
 		ImGui::NewFrame();
@@ -250,10 +365,22 @@ namespace MRG
 
 	void Renderer::endImGui()
 	{
+		if (spec.headless) { return; }
+
 		const auto& frameData = getCurrentFrameData();
 
 		ImGui::Render();
-		ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), frameData.commandBuffer);
+
+		const auto inheritanceInfo = getMainPassInheritanceInfo();
+		vk::CommandBufferBeginInfo beginInfo{
+		  .flags            = vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+		  .pInheritanceInfo = &inheritanceInfo,
+		};
+		const auto commandBuffer = frameData.recordingPools.front()->acquire();
+		commandBuffer.begin(beginInfo);
+		ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+		commandBuffer.end();
+		m_mainPassCommandBuffers.push_back(commandBuffer);
 
 		if ((ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0) {
 			ImGui::UpdatePlatformWindows();
@@ -272,7 +399,8 @@ namespace MRG
 
 	void Renderer::initVulkan()
 	{
-		std::array<uint32_t, 3> requestedAPIVersion{1, 0, 0};
+		// 1.2 for descriptor indexing, which the texture table relies on
+		std::array<uint32_t, 3> requestedAPIVersion{1, 2, 0};
 
 		// basic instance creation
 		vkb::InstanceBuilder instanceBuilder{};
@@ -286,6 +414,7 @@ namespace MRG
 		                              VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
 		    .set_debug_callback(vkDebugCallback)
 #endif
+		    .set_headless(spec.headless)
 		    .build()
 		    .value();
 
@@ -293,12 +422,35 @@ namespace MRG
 		m_debugMessenger = vkbInstance.debug_messenger;
 
 		// surface creation
-		glfwCreateWindowSurface(m_instance, window, nullptr, reinterpret_cast<VkSurfaceKHR*>(&m_surface));
+		if (!spec.headless) { glfwCreateWindowSurface(m_instance, window, nullptr, reinterpret_cast<VkSurfaceKHR*>(&m_surface)); }
 
 		// GPU selection
 		vkb::PhysicalDeviceSelector selector{vkbInstance};
-		const auto vkbPhysicalDevice =
-		  selector.set_minimum_version(requestedAPIVersion[0], requestedAPIVersion[1]).set_surface(m_surface).select().value();
+		selector.set_minimum_version(requestedAPIVersion[0], requestedAPIVersion[1]);
+		if (!spec.headless) { selector.set_surface(m_surface); }
+		// Descriptor indexing is optional in 1.2 (but supported by every desktop driver exposing 1.2), and the texture table relies on it.
+		// Requiring it skips the devices that do not support it, and enables it when creating the device.
+		selector.set_required_features_12(vk::PhysicalDeviceVulkan12Features{
+		  .shaderSampledImageArrayNonUniformIndexing    = VK_TRUE,
+		  .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+		  .descriptorBindingPartiallyBound              = VK_TRUE,
+		  .runtimeDescriptorArray                       = VK_TRUE,
+		});
+		auto vkbPhysicalDevice = selector.select().value();
+		// Block compression and anisotropic filtering are optional: cooked textures are only used when the device supports the former, and
+		// anisotropic samplers fall back to trilinear filtering without the latter. They are enabled on the selected device only (the
+		// device builder enables the features held by vkbPhysicalDevice), as selecting again could pick another device.
+		const auto deviceFeatures               = vk::PhysicalDevice{vkbPhysicalDevice.physical_device}.getFeatures();
+		const auto supportsBlockCompression     = deviceFeatures.textureCompressionBC == VK_TRUE;
+		const auto supportsAnisotropicFiltering = deviceFeatures.samplerAnisotropy == VK_TRUE;
+
+		vkbPhysicalDevice.features.textureCompressionBC = deviceFeatures.textureCompressionBC;
+		vkbPhysicalDevice.features.samplerAnisotropy    = deviceFeatures.samplerAnisotropy;
+
+		if (!supportsBlockCompression && spec.useCookedTextures) {
+			MRG_ENGINE_WARN("The selected device does not support block compressed textures, cooked textures will not be used")
+		}
+		m_useCookedTextures = spec.useCookedTextures && supportsBlockCompression;
 
 		m_GPU = vkbPhysicalDevice.physical_device;
 
@@ -322,6 +474,17 @@ namespace MRG
 		m_graphicsQueue      = vkbDevice.get_queue(vkb::QueueType::graphics).value();
 		m_graphicsQueueIndex = vkbDevice.get_queue_index(vkb::QueueType::graphics).value();
 
+		// Uploads are done on a transfer only queue when the GPU exposes one, so that they can overlap with rendering
+		const auto dedicatedTransferQueue = vkbDevice.get_dedicated_queue(vkb::QueueType::transfer);
+		if (dedicatedTransferQueue.has_value()) {
+			m_transferQueue      = dedicatedTransferQueue.value();
+			m_transferQueueIndex = vkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+			MRG_ENGINE_TRACE("\tUsing dedicated transfer queue family {}", m_transferQueueIndex)
+		} else {
+			m_transferQueue      = m_graphicsQueue;
+			m_transferQueueIndex = m_graphicsQueueIndex;
+		}
+
 		// VMA allocator creation
 		VmaAllocatorCreateInfo allocatorInfo{
 		  .flags                       = 0,
@@ -338,10 +501,22 @@ namespace MRG
 		  .vulkanApiVersion            = 0,
 		};
 		MRG_VK_CHECK(vmaCreateAllocator(&allocatorInfo, &m_allocator), "failed to create VMA allocator!")
+
+		const auto maxAnisotropy =
+		  supportsAnisotropicFiltering ? std::min(spec.maxAnisotropy, properties.limits.maxSamplerAnisotropy) : 1.f;
+		m_samplerCache = createScope<SamplerCache>(m_device, maxAnisotropy);
+		MRG_ENGINE_TRACE("\tMax sampler anisotropy: {}", static_cast<double>(maxAnisotropy))
 	}
 
 	void Renderer::initSwapchain()
 	{
+		if (spec.headless) {
+			// No swapchain to query, but the formats are still needed to create render passes compatible with the framebuffers
+			m_swapchainFormat        = vk::Format::eB8G8R8A8Srgb;
+			m_depthImage.spec.format = vk::Format::eD32Sfloat;
+			return;
+		}
+
 		vkb::SwapchainBuilder swapchainBuilder{m_GPU, m_device, m_surface};
 		auto vkbSwapchain = swapchainBuilder
 		                      .set_desired_format({
@@ -364,6 +539,7 @@ namespace MRG
 		const auto rawImageViews = vkbSwapchain.get_image_views().value();
 		m_swapchainImages        = std::vector<vk::Image>(rawImages.begin(), rawImages.end());
 		m_swapchainImageViews    = std::vector<vk::ImageView>(rawImageViews.begin(), rawImageViews.end());
+		m_imagesInFlight         = std::vector<vk::Fence>(m_swapchainImages.size());
 
 		m_depthImage.spec.allocator = m_allocator;
 		m_depthImage.spec.device    = m_device;
@@ -430,18 +606,38 @@ namespace MRG
 		for (auto& frame : m_framesData) {
 			frame.commandPool = m_device.createCommandPool(cmdPoolInfo);
 
-			// allocate main command buffer from created command pool
+			// allocate main and offscreen command buffers from created command pool
 			vk::CommandBufferAllocateInfo mainCmdBufferInfo{
 			  .commandPool        = frame.commandPool,
 			  .level              = vk::CommandBufferLevel::ePrimary,
-			  .commandBufferCount = 1,
+			  .commandBufferCount = 2,
 			};
-			frame.commandBuffer = m_device.allocateCommandBuffers(mainCmdBufferInfo)[0];
+			const auto commandBuffers    = m_device.allocateCommandBuffers(mainCmdBufferInfo);
+			frame.commandBuffer          = commandBuffers[0];
+			frame.offscreenCommandBuffer = commandBuffers[1];
 		}
 
-		// create upload context command pool
-		cmdPoolInfo.flags           = {};
-		m_uploadContext.commandPool = m_device.createCommandPool(cmdPoolInfo);
+		for (auto& frame : m_framesData) {
+			frame.recordingPools.resize(Jobs::getThreadCount());
+			for (auto& recordingPool : frame.recordingPools) {
+				recordingPool = createScope<SecondaryCommandPool>(m_device, m_graphicsQueueIndex);
+			}
+		}
+
+		m_stagingBuffer = createScope<StagingRingBuffer>(m_allocator, spec.stagingBufferSize);
+		m_uploadQueue   = createScope<UploadQueue>(m_device,
+		                                           m_allocator,
+		                                           *m_stagingBuffer,
+		                                           QueueInfo{m_transferQueue, m_transferQueueIndex},
+		                                           QueueInfo{m_graphicsQueue, m_graphicsQueueIndex});
+		m_textureStreamer = createScope<TextureStreamer>(m_device,
+		                                                 *m_uploadQueue,
+		                                                 m_allocator,
+		                                                 spec.textureStreamingBudget,
+		                                                 spec.textureStreamingBytesPerFrame,
+		                                                 spec.framesInFlight,
+		                                                 m_useCookedTextures);
+		m_textureLoader   = createScope<TextureLoader>(m_device, *m_uploadQueue, m_allocator, m_useCookedTextures);
 	}
 
 	void Renderer::initDefaultRenderPass()
@@ -496,6 +692,32 @@ namespace MRG
 
 		m_renderPass = m_device.createRenderPass(renderPassInfo);
 
+		// Framebuffers are sampled by the passes recorded after them (other framebuffers, or ImGui in the swapchain pass), and can be
+		// rendered again while the previous frame still samples them: both hazards are covered here instead of with explicit barriers
+		std::array<vk::SubpassDependency, 2> fbDependencies{
+		  vk::SubpassDependency{
+		    .srcSubpass    = VK_SUBPASS_EXTERNAL,
+		    .dstSubpass    = 0,
+		    .srcStageMask  = vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eLateFragmentTests |
+		                     vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		    .dstStageMask  = vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		    .srcAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eColorAttachmentWrite,
+		    .dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+		                     vk::AccessFlagBits::eColorAttachmentWrite,
+		  },
+		  vk::SubpassDependency{
+		    .srcSubpass    = 0,
+		    .dstSubpass    = VK_SUBPASS_EXTERNAL,
+		    .srcStageMask  = vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		    // Framebuffer textures can be sampled from any stage of the passes that come after (vertex displacement, ...)
+		    .dstStageMask  = vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
+		    .srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite,
+		    .dstAccessMask = vk::AccessFlagBits::eShaderRead,
+		  },
+		};
+		renderPassInfo.dependencyCount = static_cast<uint32_t>(fbDependencies.size());
+		renderPassInfo.pDependencies   = fbDependencies.data();
+
 		attachments[0].finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
 		m_fbRenderPass             = m_device.createRenderPass(renderPassInfo);
 	}
@@ -534,20 +756,20 @@ namespace MRG
 			frame.presentSemaphore = m_device.createSemaphore(vk::SemaphoreCreateInfo{});
 			frame.renderSemaphore  = m_device.createSemaphore(vk::SemaphoreCreateInfo{});
 		}
-
-		fenceInfo.flags             = {};
-		m_uploadContext.uploadFence = m_device.createFence(fenceInfo);
 	}
 
 	void Renderer::initDescriptors()
 	{
-		std::array<vk::DescriptorPoolSize, 1> sizes{{vk::DescriptorType::eUniformBuffer, 1}};
+		m_layoutCache = createScope<LayoutCache>(m_device);
+
+		std::array<vk::DescriptorPoolSize, 1> sizes{{vk::DescriptorType::eUniformBuffer, spec.framesInFlight}};
 		vk::DescriptorPoolCreateInfo poolInfo{
-		  .maxSets       = FRAMES_IN_FLIGHT + 1,
+		  .maxSets       = spec.framesInFlight,
 		  .poolSizeCount = static_cast<uint32_t>(sizes.size()),
 		  .pPoolSizes    = sizes.data(),
 		};
-		m_descriptorPool = m_device.createDescriptorPool(poolInfo);
+		m_descriptorPool         = m_device.createDescriptorPool(poolInfo);
+		m_descriptorSetAllocator = createRef<DescriptorSetAllocator>(m_device, spec.framesInFlight);
 
 		std::array<vk::DescriptorSetLayoutBinding, 1> level0Bindings{
 		  vk::DescriptorSetLayoutBinding{
@@ -557,14 +779,9 @@ namespace MRG
 		    .stageFlags      = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
 		  },
 		};
-		vk::DescriptorSetLayoutCreateInfo setInfo{
-		  .bindingCount = static_cast<uint32_t>(level0Bindings.size()),
-		  .pBindings    = level0Bindings.data(),
-		};
-		m_level0DSL = m_device.createDescriptorSetLayout(setInfo);
+		m_level0DSL = m_layoutCache->getDescriptorSetLayout(level0Bindings);
 
-		std::array<vk::DescriptorSetLayout, FRAMES_IN_FLIGHT> layouts{};
-		layouts.fill(m_level0DSL);
+		std::vector<vk::DescriptorSetLayout> layouts(m_framesData.size(), m_level0DSL);
 		vk::DescriptorSetAllocateInfo allocInfo{
 		  .descriptorPool     = m_descriptorPool,
 		  .descriptorSetCount = static_cast<uint32_t>(layouts.size()),
@@ -583,9 +800,12 @@ namespace MRG
 		  .pBufferInfo     = &timeBufferInfo,
 		};
 
-		for (std::size_t i = 0; i < FRAMES_IN_FLIGHT; ++i) {
-			m_framesData[i].timeDataBuffer =
-			  AllocatedBuffer{m_allocator, sizeof(TimeData), vk::BufferUsageFlagBits::eUniformBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU};
+		for (std::size_t i = 0; i < m_framesData.size(); ++i) {
+			m_framesData[i].timeDataBuffer = AllocatedBuffer{m_allocator,
+			                                                 sizeof(TimeData),
+			                                                 vk::BufferUsageFlagBits::eUniformBuffer,
+			                                                 VMA_MEMORY_USAGE_CPU_TO_GPU,
+			                                                 VMA_ALLOCATION_CREATE_MAPPED_BIT};
 			m_framesData[i].level0Descriptor = level0Descriptors[i];
 
 			timeBufferInfo.buffer = m_framesData[i].timeDataBuffer.vkHandle;
@@ -593,49 +813,60 @@ namespace MRG
 			m_device.updateDescriptorSets(timeSetWrite, {});
 		}
 
-		// level 1 DSL (currently empty)
-		setInfo.bindingCount = 0;
-		m_level1DSL          = m_device.createDescriptorSetLayout(setInfo);
+		const auto limits           = m_GPU.getProperties().limits;
+		const auto uniformAlignment = std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+		m_maxInstancesPerDraw =
+		  std::min(spec.maxInstancesPerDraw, static_cast<uint32_t>(limits.maxStorageBufferRange / sizeof(glm::mat4)));
+		if (m_maxInstancesPerDraw < spec.maxInstancesPerDraw) {
+			MRG_ENGINE_WARN("Instanced draws limited to {} instances by the device ({} requested)",
+			                m_maxInstancesPerDraw,
+			                spec.maxInstancesPerDraw)
+		}
+		// The instance data range is bound at every offset model matrices are pushed at, so it has to fit even past the last one
+		for (auto& frameData : m_framesData) {
+			frameData.objectUniformBuffer =
+			  createScope<DynamicUniformBuffer>(m_allocator, spec.objectUniformBufferSize, uniformAlignment, getInstanceDataRange());
+		}
 
-		vk::DescriptorSetAllocateInfo allocLeve1Info{
-		  .descriptorPool     = m_descriptorPool,
-		  .descriptorSetCount = 1,
-		  .pSetLayouts        = &m_level1DSL,
-		};
-		m_level1Descriptor = m_device.allocateDescriptorSets(allocLeve1Info)[0];
+		// level 1: texture table
+		const auto indexingLimits =
+		  m_GPU.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorIndexingProperties>()
+		    .get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+		const auto textureTableCapacity = std::min({spec.maxTextures,
+		                                            indexingLimits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+		                                            indexingLimits.maxPerStageDescriptorUpdateAfterBindSamplers,
+		                                            indexingLimits.maxDescriptorSetUpdateAfterBindSampledImages,
+		                                            indexingLimits.maxDescriptorSetUpdateAfterBindSamplers});
+		if (textureTableCapacity < spec.maxTextures) {
+			MRG_ENGINE_WARN("Texture table limited to {} textures by the device ({} requested)", textureTableCapacity, spec.maxTextures)
+		}
+		m_textureTable = createRef<TextureTable>(m_device, textureTableCapacity, spec.framesInFlight);
+		m_level1DSL    = m_textureTable->getLayout();
 	}
 
 	void Renderer::initAssets() { defaultTexture = createTexture(Files::Rendering::defaultTexture.c_str()); }
 
 	void Renderer::initMaterials()
 	{
-		vk::PipelineCacheCreateInfo pipelineCacheCreateInfo{};
-		if (std::filesystem::exists(Files::Rendering::vkPipelineCacheFile)) {
-			MRG_ENGINE_TRACE("Pipeline cache found.")
-			std::ifstream pipelineCacheFile{Files::Rendering::vkPipelineCacheFile, std::ios::binary | std::ios::ate};
-			const auto fileSize = static_cast<std::size_t>(pipelineCacheFile.tellg());
-			std::vector<uint8_t> pipelineData(fileSize / sizeof(uint8_t));
-			pipelineCacheFile.seekg(std::ios::beg);
-			pipelineCacheFile.read(reinterpret_cast<char*>(pipelineData.data()), static_cast<std::streamsize>(fileSize));
-			pipelineCacheFile.close();
-		}
-		m_pipelineCache = m_device.createPipelineCache(pipelineCacheCreateInfo);
+		m_pipelineCache = createScope<PipelineCache>(m_device, m_GPU.getProperties(), Files::Rendering::vkPipelineCacheFile);
 
 		defaultBasicShader   = createShader("BasicMesh.vert.spv", "BasicMesh.frag.spv");
-		defaultBasicMaterial = createMaterial<BasicVertex>(defaultBasicShader, {});
+		defaultBasicMaterial = createMaterialAsync<BasicVertex>(defaultBasicShader, {});
 
 		defaultColoredShader   = createShader("ColoredMesh.vert.spv", "ColoredMesh.frag.spv");
-		defaultColoredMaterial = createMaterial<ColoredVertex>(defaultColoredShader, {});
+		defaultColoredMaterial = createMaterialAsync<ColoredVertex>(defaultColoredShader, {});
 
 		defaultTexturedShader   = createShader("TexturedMesh.vert.spv", "TexturedMesh.frag.spv");
-		defaultTexturedMaterial = createMaterial<TexturedVertex>(defaultTexturedShader, {});
+		defaultTexturedMaterial = createMaterialAsync<TexturedVertex>(defaultTexturedShader, {});
 
 		pbrShader   = createShader("PBR.vert.spv", "PBR.frag.spv");
-		pbrMaterial = createMaterial<TexturedVertex>(pbrShader, {});
+		pbrMaterial = createMaterialAsync<TexturedVertex>(pbrShader, {});
 	}
 
 	void Renderer::initImGui()
 	{
+		if (spec.headless) { return; }
+
 		std::array<vk::DescriptorPoolSize, 11> poolSizes{
 		  vk::DescriptorPoolSize{vk::DescriptorType::eSampler, 1000},
 		  vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, 1000},
@@ -669,7 +900,7 @@ namespace MRG
 		  .Device          = m_device,
 		  .QueueFamily     = 0,
 		  .Queue           = m_graphicsQueue,
-		  .PipelineCache   = m_pipelineCache,
+		  .PipelineCache   = m_pipelineCache->getHandle(),
 		  .DescriptorPool  = m_imGuiPool,
 		  .Subpass         = 0,
 		  .MinImageCount   = m_imageCount,
@@ -682,8 +913,8 @@ namespace MRG
 		ImGui_ImplGlfw_InitForVulkan(window, true);
 		ImGui_ImplVulkan_Init(&initInfo, m_renderPass);
 
-		Utils::Commands::immediateSubmit(
-		  m_device, m_graphicsQueue, m_uploadContext, [&](vk::CommandBuffer cmdBuffer) { ImGui_ImplVulkan_CreateFontsTexture(cmdBuffer); });
+		m_uploadQueue->wait(
+		  m_uploadQueue->enqueueGraphicsCommands([](vk::CommandBuffer cmdBuffer) { ImGui_ImplVulkan_CreateFontsTexture(cmdBuffer); }));
 		ImGui_ImplVulkan_DestroyFontUploadObjects();
 
 		ImGui::StyleColorsDark();
@@ -756,7 +987,7 @@ namespace MRG
 
 	void Renderer::destroySwapchain()
 	{
-		if (!isInitalized) { return; }
+		if (!isInitalized || spec.headless) { return; }
 
 		for (const auto& framebuffer : m_framebuffers) { m_device.destroyFramebuffer(framebuffer); }
 		m_device.destroySwapchainKHR(m_swapchain);
@@ -5,19 +5,39 @@
 #ifndef MORRIGU_RENDERER_H
 #define MORRIGU_RENDERER_H
 
+#include "Core/Jobs.h"
 #include "Entity/Components/MeshRenderer.h"
 #include "Entity/Entity.h"
 #include "Events/ApplicationEvent.h"
 #include "Rendering/Camera.h"
+#include "Rendering/DescriptorSetAllocator.h"
+#include "Rendering/DynamicUniformBuffer.h"
 #include "Rendering/Framebuffer.h"
+#include "Rendering/FrustumCulling.h"
+#include "Rendering/LayoutCache.h"
+#include "Rendering/PipelineCache.h"
+#include "Rendering/RenderGraph.h"
+#include "Rendering/RenderQueue.h"
 #include "Rendering/RendererTypes.h"
+#include "Rendering/SamplerCache.h"
+#include "Rendering/SecondaryCommandPool.h"
 #include "Rendering/Texture.h"
-#include "Utils/Commands.h"
+#include "Rendering/TextureLoader.h"
+#include "Rendering/TextureStreamer.h"
+#include "Rendering/TextureTable.h"
+#include "Rendering/UploadQueue.h"
+#include "Utils/Meshes.h"
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
 #include <ranges>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace MRG
@@ -28,6 +48,74 @@ namespace MRG
 		vk::PresentModeKHR preferredPresentMode{vk::PresentModeKHR::eMailbox};
 		int windowWidth{1280};
 		int windowHeight{720};
+
+		// When set, no window surface nor swapchain are created: the renderer can only draw into Framebuffer objects.
+		// This allows running the engine on machines without any display (CI, render farms, software ICDs like lavapipe, ...)
+		bool headless{false};
+
+		// Size of the persistently mapped buffer all uploads are staged through. Uploads bigger than this still work, but get their own
+		// temporary staging buffer.
+		std::size_t stagingBufferSize{64 * 1024 * 1024};
+
+		// Number of frames the CPU can record ahead of the GPU (between 1 and 3). Every resource written each frame (uniforms, descriptor
+		// sets, command buffers, ...) is duplicated that many times.
+		uint32_t framesInFlight{2};
+
+		// Size of the buffer per object uniforms (model matrices, ...) are written into each frame. Every object drawn takes at least
+		// minUniformBufferOffsetAlignment bytes (256 at most) per uniform binding.
+		std::size_t objectUniformBufferSize{16 * 1024 * 1024};
+
+		// Instanced draws of bigger batches are split, as instanced shaders read their model matrices through a fixed size range of the
+		// object uniform buffer. Lowered to what the device supports if needed.
+		uint32_t maxInstancesPerDraw{1024};
+
+		// Maximum number of textures alive at the same time, as every texture is part of the texture table (see TextureTable). Lowered to
+		// what the device supports if needed.
+		uint32_t maxTextures{4096};
+
+		// Texture files are loaded from their cooked version when there is one (see Utils::Textures::loadCookedTexture), as long as the
+		// device supports block compressed formats
+		bool useCookedTextures{true};
+
+		// Texels taken at most per sample by anisotropic samplers (see SamplerPreset). Lowered to what the device supports if needed,
+		// anisotropic samplers falling back to trilinear filtering when it does not support anisotropic filtering at all.
+		float maxAnisotropy{16.f};
+
+		// VRAM streamed textures can use (see TextureStreamer). Their smallest levels are always resident, even over the budget.
+		std::size_t textureStreamingBudget{512 * 1024 * 1024};
+		// Bytes uploaded per frame at most when refining streamed textures, to avoid hitches
+		std::size_t textureStreamingBytesPerFrame{16 * 1024 * 1024};
+
+		// Draws are sorted to minimise state changes. Can be turned off at any time to compare the frame statistics.
+		bool sortDraws{true};
+
+		// Draws of a drawMeshes call are recorded on the job system threads, in groups of at least that many draws (an instanced draw
+		// counting as one), as each group is recorded into its own secondary command buffer
+		uint32_t minDrawsPerRecordingGroup{256};
+	};
+
+	// Counts of the commands recorded by drawMeshes since the beginning of the frame
+	struct FrameStatistics
+	{
+		uint32_t drawCalls{0};
+		uint32_t instances{0};
+		uint32_t pipelineBinds{0};
+		uint32_t descriptorSetBinds{0};
+		uint32_t vertexBufferBinds{0};
+		uint32_t visibleObjects{0};
+		uint32_t culledObjects{0};
+
+		FrameStatistics& operator+=(const FrameStatistics& other)
+		{
+			drawCalls += other.drawCalls;
+			instances += other.instances;
+			pipelineBinds += other.pipelineBinds;
+			descriptorSetBinds += other.descriptorSetBinds;
+			vertexBufferBinds += other.vertexBufferBinds;
+			visibleObjects += other.visibleObjects;
+			culledObjects += other.culledObjects;
+			return *this;
+		}
 	};
 
 	struct FrameData
@@ -37,9 +125,16 @@ namespace MRG
 
 		vk::CommandPool commandPool;
 		vk::CommandBuffer commandBuffer;
+		// Framebuffer passes of the frame, submitted right before the frame command buffer
+		vk::CommandBuffer offscreenCommandBuffer;
 
 		AllocatedBuffer timeDataBuffer{};
 		vk::DescriptorSet level0Descriptor;
+
+		Scope<DynamicUniformBuffer> objectUniformBuffer{};
+
+		// One per job system thread, every pass of the frame is recorded into secondary command buffers allocated from these
+		std::vector<Scope<SecondaryCommandPool>> recordingPools{};
 	};
 
 	class Renderer
@@ -48,50 +143,113 @@ namespace MRG
 		Renderer(const RendererSpecification&, GLFWwindow*);
 		~Renderer();
 
+		// Uploads are batched and submitted at the end of the frame (or when calling flushUploads), so the returned ticket can be used
+		// to know when the GPU is done with them. Meshes can be drawn right away either way.
 		template<Vertex VertexType>
-		void uploadMesh(Ref<Mesh<VertexType>>& mesh)
+		UploadTicket uploadMesh(Ref<Mesh<VertexType>>& mesh)
 		{
-			const auto bufferSize = static_cast<uint32_t>(mesh->vertices.size() * sizeof(VertexType));
+			// Meshes built by hand without any index are drawn as a plain triangle list
+			if (mesh->indices.empty()) { mesh->indices = Utils::Meshes::makeTriangleListIndices(mesh->vertices.size()); }
 
-			AllocatedBuffer stagingBuffer{m_allocator, bufferSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY};
+			return uploadMeshData(*mesh, std::as_bytes(std::span{mesh->vertices}), std::as_bytes(std::span{mesh->indices}));
+		}
 
-			void* data;
-			vmaMapMemory(m_allocator, stagingBuffer.allocation, &data);
-			memcpy(data, mesh->vertices.data(), mesh->vertices.size() * sizeof(VertexType));
-			vmaUnmapMemory(m_allocator, stagingBuffer.allocation);
+		// Uploads the cooked data straight from the file mapping, no CPU copy of the vertices or indices is kept in the mesh
+		template<Vertex VertexType>
+		UploadTicket uploadMesh(Ref<Mesh<VertexType>>& mesh, const Utils::Meshes::CookedMesh<VertexType>& cookedMesh)
+		{
+			return uploadMeshData(*mesh, cookedMesh.vertexData, cookedMesh.indexData);
+		}
 
-			// mesh vertex buffer
-			mesh->vertexBuffer = AllocatedBuffer{m_allocator,
-			                                     bufferSize,
-			                                     vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
-			                                     VMA_MEMORY_USAGE_GPU_ONLY};
-
-			Utils::Commands::immediateSubmit(m_device, m_graphicsQueue, m_uploadContext, [&](vk::CommandBuffer cmdBuffer) {
-				vk::BufferCopy copy{
-				  .size = bufferSize,
-				};
-				cmdBuffer.copyBuffer(stagingBuffer.vkHandle, mesh->vertexBuffer.vkHandle, copy);
-			});
+		// Loads and uploads a mesh, using its cooked version if there is a valid one, and parsing the source file otherwise
+		template<Vertex VertexType>
+		[[nodiscard]] Ref<Mesh<VertexType>> loadMesh(const char* filePath)
+		{
+			if (const auto cookedMesh = Utils::Meshes::loadCookedMesh<VertexType>(filePath); cookedMesh.has_value()) {
+				auto mesh = createRef<Mesh<VertexType>>();
+				uploadMesh(mesh, cookedMesh.value());
+				return mesh;
+			}
+
+			auto mesh = Utils::Meshes::loadMeshFromFile<VertexType>(filePath);
+			uploadMesh(mesh);
+			return mesh;
 		}
 
+		[[nodiscard]] const FrameStatistics& getFrameStatistics() const { return m_frameStatistics; }
+		[[nodiscard]] const TextureStreamingStatistics& getTextureStreamingStatistics() const { return m_textureStreamer->getStatistics(); }
+
+		UploadTicket flushUploads() { return m_uploadQueue->flush(); }
+		[[nodiscard]] bool isUploadComplete(UploadTicket ticket) { return m_uploadQueue->isComplete(ticket); }
+		void waitForUpload(UploadTicket ticket) { m_uploadQueue->wait(ticket); }
+
+		// Returns the existing shader if one was already created from the same files and is still in use
 		[[nodiscard]] Ref<Shader> createShader(const char* vertexShaderName, const char* fragmentShaderName);
 		template<Vertex VertexType>
 		[[nodiscard]] Ref<Material<VertexType>> createMaterial(const Ref<Shader>& shader, const MaterialConfiguration& config)
 		{
-			return createRef<Material<VertexType>>(
-			  m_device, m_allocator, shader, m_pipelineCache, m_renderPass, m_level0DSL, m_level1DSL, defaultTexture, config);
+			return m_pipelineCache->track([&]() {
+				return createRef<Material<VertexType>>(m_device,
+				                                       m_allocator,
+				                                       shader,
+				                                       m_pipelineCache->getHandle(),
+				                                       m_renderPass,
+				                                       *m_layoutCache,
+				                                       m_descriptorSetAllocator,
+				                                       m_level0DSL,
+				                                       m_level1DSL,
+				                                       defaultTexture,
+				                                       config,
+				                                       getObjectUniformBuffers(),
+				                                       getInstanceDataRange());
+			});
 		}
 
-		[[nodiscard]] Ref<Texture> createTexture(void* data, uint32_t width, uint32_t height);
+		// Compiles the pipeline on the job system threads, so that this returns right away. The material can be used as soon as it is
+		// returned, but mesh renderers using it are not drawn until its pipeline is ready (see Material::isReady).
+		template<Vertex VertexType>
+		[[nodiscard]] Ref<Material<VertexType>> createMaterialAsync(const Ref<Shader>& shader, const MaterialConfiguration& config)
+		{
+			auto material = createRef<Material<VertexType>>(m_device,
+			                                                m_allocator,
+			                                                shader,
+			                                                *m_layoutCache,
+			                                                m_descriptorSetAllocator,
+			                                                m_level0DSL,
+			                                                m_level1DSL,
+			                                                defaultTexture,
+			                                                getObjectUniformBuffers(),
+			                                                getInstanceDataRange());
+			Jobs::run(
+			  [this, material, config]() {
+				  m_pipelineCache->track([&]() { material->compilePipeline(m_pipelineCache->getHandle(), m_renderPass, config); });
+			  },
+			  &m_pipelineJobs);
+			return material;
+		}
+
+		// Textures created from data have a single mip level, and clamp their coordinates to their edges
+		[[nodiscard]] Ref<Texture> createTexture(void* data,
+		                                         uint32_t width,
+		                                         uint32_t height,
+		                                         SamplerPreset samplerPreset = SamplerPreset::Nearest);
+
+		// Textures created from files have a whole mip chain, and repeat when sampled outside of their bounds
+		[[nodiscard]] Ref<Texture> createTexture(const char* fileName, SamplerPreset samplerPreset = SamplerPreset::Anisotropic);
+		// Decodes the texture on the job system threads, so that this returns right away. The texture samples the default texture until
+		// it is uploaded, at the end of the frame its decoding is done in, and can only be bound to texture index slots until then (see
+		// Texture::isLoaded).
+		[[nodiscard]] Ref<Texture> createTextureAsync(const char* fileName, SamplerPreset samplerPreset = SamplerPreset::Anisotropic);
 
-		[[nodiscard]] Ref<Texture> createTexture(const char* fileName);
+		// Only the smallest levels of the texture are uploaded right away, the others are streamed in according to the size the texture
+		// is drawn at. Streamed textures can only be bound to texture index slots (see Shader::isTextureIndex).
+		[[nodiscard]] Ref<Texture> createStreamedTexture(const char* fileName, SamplerPreset samplerPreset = SamplerPreset::Anisotropic);
 
 		template<Vertex VertexType>
 		[[nodiscard]] Components::MeshRenderer<VertexType>::VulkanObjects createMeshRenderer(const Ref<Mesh<VertexType>>& meshRef,
 		                                                                                     const Ref<Material<VertexType>>& materialRef)
 		{
-			return
-			  typename Components::MeshRenderer<VertexType>::VulkanObjects{m_device, m_allocator, meshRef, materialRef, defaultTexture};
+			return typename Components::MeshRenderer<VertexType>::VulkanObjects{m_device, meshRef, materialRef, defaultTexture};
 		}
 
 		[[nodiscard]] Ref<Framebuffer> createFrameBuffer(const FramebufferSpecification& fbSpec);
@@ -99,170 +257,29 @@ namespace MRG
 		template<Vertex VertexType>
 		void drawMeshes(const entt::registry& registry, const Camera& camera)
 		{
-			const auto& frameData = getCurrentFrameData();
-
-			TimeData timeData{
-			  // Shamelessly stolen from https://docs.unity3d.com/Manual/SL-UnityShaderVariables.html
-			  .time = {elapsedTime / 20.f, elapsedTime, elapsedTime * 2.f, elapsedTime * 3.f},
-			};
-			void* data;
-			vmaMapMemory(m_allocator, frameData.timeDataBuffer.allocation, &data);
-			memcpy(data, &timeData, sizeof(TimeData));
-			vmaUnmapMemory(m_allocator, frameData.timeDataBuffer.allocation);
-
-			vk::Pipeline currentMaterial{};
-			bool isFirst = true;
-			auto view    = registry.view<Components::MeshRenderer<VertexType>>();
-			for (const auto& entity : view) {
-				auto [mrc] = view.get(entity);
-				if (!mrc.isVisible) { continue; }
-				if (isFirst) {
-					frameData.commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-					                                           mrc.material->pipelineLayout,
-					                                           0,
-					                                           {frameData.level0Descriptor, m_level1Descriptor},
-					                                           {});
-					isFirst = false;
-				}
-				if (currentMaterial != mrc.material->pipeline) {
-					frameData.commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, mrc.material->pipeline);
-					frameData.commandBuffer.setViewport(0,
-					                                    vk::Viewport{
-					                                      .x        = 0.f,
-					                                      .y        = 0.f,
-					                                      .width    = static_cast<float>(spec.windowWidth),
-					                                      .height   = static_cast<float>(spec.windowHeight),
-					                                      .minDepth = 0.f,
-					                                      .maxDepth = 1.f,
-					                                    });
-					frameData.commandBuffer.setScissor(
-					  0,
-					  vk::Rect2D{
-					    .offset{0, 0},
-					    .extent = {static_cast<uint32_t>(spec.windowWidth), static_cast<uint32_t>(spec.windowHeight)},
-					  });
-					frameData.commandBuffer.bindDescriptorSets(
-					  vk::PipelineBindPoint::eGraphics, mrc.material->pipelineLayout, 2, mrc.material->level2Descriptor, {});
-					currentMaterial = mrc.material->pipeline;
-				}
-
-				CameraData cameraData{
-				  .viewMatrix           = camera.getView(),
-				  .projectionMatrix     = camera.getProjection(),
-				  .viewProjectionMatrix = camera.getViewProjection(),
-				};
-				frameData.commandBuffer.pushConstants(
-				  mrc.material->pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0, sizeof(cameraData), &cameraData);
-
-				frameData.commandBuffer.bindDescriptorSets(
-				  vk::PipelineBindPoint::eGraphics, mrc.material->pipelineLayout, 3, mrc.level3Descriptor, {});
+			MRG_ENGINE_ASSERT(!spec.headless, "Cannot draw to the swapchain in headless mode, use a framebuffer instead!")
 
-				frameData.commandBuffer.bindVertexBuffers(0, mrc.mesh->vertexBuffer.vkHandle, {0});
-				frameData.commandBuffer.draw(static_cast<uint32_t>(mrc.mesh->vertices.size()), 1, 0, 0);
-			}
+			const vk::Extent2D extent{static_cast<uint32_t>(spec.windowWidth), static_cast<uint32_t>(spec.windowHeight)};
+			recordDraws<VertexType>(getMainPassInheritanceInfo(), registry, camera, extent, m_mainPassCommandBuffers, nullptr);
 		}
 
+		// Only records the draws: the framebuffer is rendered at the end of the frame, before the swapchain, after every framebuffer it
+		// samples from has been rendered, and with no CPU wait
 		template<Vertex VertexType>
 		void drawMeshes(const entt::registry& registry, const Camera& camera, Ref<Framebuffer> framebuffer)
 		{
-			framebuffer->commandBuffer.reset();
-			vk::CommandBufferBeginInfo beginInfo{
-			  .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
-			};
-			framebuffer->commandBuffer.begin(beginInfo);
-
-			vk::ClearValue colorClearValue{};
-			colorClearValue.color = {framebuffer->spec.clearColor};
-			vk::ClearValue depthClearValue{};
-			depthClearValue.depthStencil.depth = 1.f;
-
-			std::array<vk::ClearValue, 2> clearValues{colorClearValue, depthClearValue};
-
-			vk::RenderPassBeginInfo renderPassInfo{
+			const vk::CommandBufferInheritanceInfo inheritanceInfo{
 			  .renderPass  = m_fbRenderPass,
+			  .subpass     = 0,
 			  .framebuffer = framebuffer->vkHandle,
-			  .renderArea =
-			    vk::Rect2D{
-			      .offset = {0, 0},
-			      .extent = {framebuffer->spec.width, framebuffer->spec.height},
-			    },
-			  .clearValueCount = static_cast<uint32_t>(clearValues.size()),
-			  .pClearValues    = clearValues.data(),
-			};
-			framebuffer->commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-
-			TimeData timeData{
-			  // Shamelessly stolen from https://docs.unity3d.com/Manual/SL-UnityShaderVariables.html
-			  .time = {elapsedTime / 20.f, elapsedTime, elapsedTime * 2.f, elapsedTime * 3.f},
 			};
-			void* data;
-			vmaMapMemory(m_allocator, framebuffer->timeDataBuffer.allocation, &data);
-			memcpy(data, &timeData, sizeof(TimeData));
-			vmaUnmapMemory(m_allocator, framebuffer->timeDataBuffer.allocation);
-
-			vk::Pipeline currentMaterial{};
-			bool isFirst = true;
-			auto view    = registry.view<Components::MeshRenderer<VertexType>>();
-			for (const auto& entity : view) {
-				auto [mrc] = view.get(entity);
-				if (!mrc.isVisible) { continue; }
-				if (isFirst) {
-					framebuffer->commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-					                                              mrc.material->pipelineLayout,
-					                                              0,
-					                                              {framebuffer->level0Descriptor, m_level1Descriptor},
-					                                              {});
-					isFirst = false;
-				}
-				if (currentMaterial != mrc.material->pipeline) {
-					framebuffer->commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, mrc.material->pipeline);
-					framebuffer->commandBuffer.setViewport(0,
-					                                       vk::Viewport{
-					                                         .x        = 0.f,
-					                                         .y        = 0.f,
-					                                         .width    = static_cast<float>(framebuffer->spec.width),
-					                                         .height   = static_cast<float>(framebuffer->spec.height),
-					                                         .minDepth = 0.f,
-					                                         .maxDepth = 1.f,
-					                                       });
-					framebuffer->commandBuffer.setScissor(0,
-					                                      vk::Rect2D{
-					                                        .offset{0, 0},
-					                                        .extent = {framebuffer->spec.width, framebuffer->spec.height},
-					                                      });
-					framebuffer->commandBuffer.bindDescriptorSets(
-					  vk::PipelineBindPoint::eGraphics, mrc.material->pipelineLayout, 2, mrc.material->level2Descriptor, {});
-					currentMaterial = mrc.material->pipeline;
-				}
-
-				CameraData cameraData{
-				  .viewMatrix           = camera.getView(),
-				  .projectionMatrix     = camera.getProjection(),
-				  .viewProjectionMatrix = camera.getViewProjection(),
-				};
-				framebuffer->commandBuffer.pushConstants(
-				  mrc.material->pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0, sizeof(cameraData), &cameraData);
 
-				framebuffer->commandBuffer.bindDescriptorSets(
-				  vk::PipelineBindPoint::eGraphics, mrc.material->pipelineLayout, 3, mrc.level3Descriptor, {});
+			std::vector<vk::CommandBuffer> commandBuffers{};
+			std::vector<const Framebuffer*> sampledFramebuffers{};
+			const vk::Extent2D extent{framebuffer->spec.width, framebuffer->spec.height};
+			recordDraws<VertexType>(inheritanceInfo, registry, camera, extent, commandBuffers, &sampledFramebuffers);
 
-				framebuffer->commandBuffer.bindVertexBuffers(0, mrc.mesh->vertexBuffer.vkHandle, {0});
-				framebuffer->commandBuffer.draw(static_cast<uint32_t>(mrc.mesh->vertices.size()), 1, 0, 0);
-			}
-
-			framebuffer->commandBuffer.endRenderPass();
-			framebuffer->commandBuffer.end();
-
-			vk::SubmitInfo submitInfo{
-			  .commandBufferCount = 1,
-			  .pCommandBuffers    = &framebuffer->commandBuffer,
-			};
-			m_graphicsQueue.submit(submitInfo, framebuffer->renderFence);
-
-			// Very wasteful, but easy and guarantees render order
-			MRG_VK_CHECK_HPP(framebuffer->getVkDevice().waitForFences(framebuffer->renderFence, VK_TRUE, UINT64_MAX),
-			                 "failed to wait for the framebuffer's wait semaphore!")
-			framebuffer->getVkDevice().resetFences(framebuffer->renderFence);
+			m_renderGraph.addPass(framebuffer, std::move(commandBuffers), std::move(sampledFramebuffers));
 		}
 
 		RendererSpecification spec;
@@ -287,13 +304,31 @@ namespace MRG
 	private:
 		int m_frameNumber{0};
 
-		static const constexpr int FRAMES_IN_FLIGHT = 1;
-		std::array<FrameData, FRAMES_IN_FLIGHT> m_framesData{};
-		[[nodiscard]] FrameData& getCurrentFrameData() { return m_framesData[static_cast<std::size_t>(m_frameNumber % FRAMES_IN_FLIGHT)]; }
+		static const constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+		std::vector<FrameData> m_framesData{};
+		[[nodiscard]] uint32_t getCurrentFrameIndex() const
+		{
+			return static_cast<uint32_t>(m_frameNumber) % static_cast<uint32_t>(m_framesData.size());
+		}
+		[[nodiscard]] FrameData& getCurrentFrameData() { return m_framesData[getCurrentFrameIndex()]; }
+		[[nodiscard]] std::vector<vk::Buffer> getObjectUniformBuffers() const;
+		[[nodiscard]] vk::DeviceSize getInstanceDataRange() const { return m_maxInstancesPerDraw * sizeof(glm::mat4); }
+		[[nodiscard]] vk::CommandBufferInheritanceInfo getMainPassInheritanceInfo() const
+		{
+			return vk::CommandBufferInheritanceInfo{
+			  .renderPass  = m_renderPass,
+			  .subpass     = 0,
+			  .framebuffer = m_framebuffers[m_imageIndex],
+			};
+		}
 
 		vk::Instance m_instance{};
 		vk::DebugUtilsMessengerEXT m_debugMessenger{};
 		vk::PhysicalDevice m_GPU{};
+		// Set when both the specification and the device allow it
+		bool m_useCookedTextures{false};
+		// RendererSpecification::maxInstancesPerDraw, lowered to what the device supports
+		uint32_t m_maxInstancesPerDraw{};
 		vk::Device m_device{};
 		vk::SurfaceKHR m_surface{};
 
@@ -301,26 +336,68 @@ namespace MRG
 		vk::Format m_swapchainFormat{};
 		std::vector<vk::Image> m_swapchainImages{};
 		std::vector<vk::ImageView> m_swapchainImageViews{};
+		// Render fence of the last frame that used each swapchain image, as images can be acquired out of order
+		std::vector<vk::Fence> m_imagesInFlight{};
 		uint32_t m_imageIndex{};
 
 		AllocatedImage m_depthImage{};
 
 		vk::Queue m_graphicsQueue{};
 		std::uint32_t m_graphicsQueueIndex{};
+		vk::Queue m_transferQueue{};
+		std::uint32_t m_transferQueueIndex{};
 
 		vk::RenderPass m_renderPass{};
 		vk::RenderPass m_fbRenderPass{};
 		std::vector<vk::Framebuffer> m_framebuffers{};
 
-		vk::PipelineCache m_pipelineCache{};
+		// Shaders still in use, by source files
+		std::map<std::pair<std::string, std::string>, std::weak_ptr<Shader>> m_shaders{};
+		Scope<PipelineCache> m_pipelineCache{};
+		// Pipelines compiled by createMaterialAsync
+		JobCounter m_pipelineJobs{};
+
+		// Every sampler of the textures and framebuffers
+		Scope<SamplerCache> m_samplerCache{};
 
+		// Every descriptor set layout and pipeline layout, including the ones below
+		Scope<LayoutCache> m_layoutCache{};
 		vk::DescriptorSetLayout m_level0DSL{};
+		// Textures keep the table alive until they are destroyed
+		Ref<TextureTable> m_textureTable{};
 		vk::DescriptorSetLayout m_level1DSL{};
-		vk::DescriptorSet m_level1Descriptor{};
 		vk::DescriptorPool m_descriptorPool{};
+		// Pools of the level 3 descriptor sets. Materials keep the allocator alive until they are destroyed.
+		Ref<DescriptorSetAllocator> m_descriptorSetAllocator{};
 
 		VmaAllocator m_allocator{};
-		UploadContext m_uploadContext{};
+		Scope<StagingRingBuffer> m_stagingBuffer{};
+		Scope<UploadQueue> m_uploadQueue{};
+		Scope<TextureStreamer> m_textureStreamer{};
+		Scope<TextureLoader> m_textureLoader{};
+
+		RenderGraph m_renderGraph{};
+		RenderQueue m_renderQueue{};
+		CullingSpheres m_cullingSpheres{};
+		std::vector<uint32_t> m_visibility{};
+		FrameStatistics m_frameStatistics{};
+
+		// Consecutive render queue items sharing a mesh and a material
+		struct DrawBatch
+		{
+			std::size_t firstItem;
+			std::size_t itemCount;
+			// An instanced draw for instanceable materials, one draw per item otherwise
+			uint32_t drawCount;
+			vk::DescriptorSet level2Descriptor;
+			// Null if the mesh renderers each have their own level 3 descriptor set
+			vk::DescriptorSet sharedLevel3Descriptor;
+		};
+		std::vector<DrawBatch> m_drawBatches{};
+		// Index of the first batch of each group recorded by a single task
+		std::vector<std::size_t> m_recordingGroups{};
+		// Executed in order in the swapchain render pass at the end of the frame
+		std::vector<vk::CommandBuffer> m_mainPassCommandBuffers{};
 
 		// ImGui data
 		uint32_t m_imageCount{};
@@ -339,6 +416,314 @@ namespace MRG
 
 		void destroySwapchain();
 
+		// Mesh renderers whose bounding sphere is outside of the camera frustum are culled, and the visible ones are sorted by pipeline,
+		// material, mesh and depth (see RenderQueue), then grouped in batches sharing a mesh and a material. Batches of an instanceable
+		// material are drawn with a single instanced draw (split every RendererSpecification::maxInstancesPerDraw mesh renderers), their
+		// model matrices being written to the frame's object uniform buffer, and the others are drawn one mesh renderer at a time.
+		// Batches are split in contiguous groups recorded in parallel on the job system threads, each into its own secondary command
+		// buffer continuing the render pass described by inheritanceInfo. These are appended to commandBuffers in draw order.
+		// Framebuffers sampled by the drawn materials and mesh renderers are appended to sampledFramebuffers if it is not null.
+		template<Vertex VertexType>
+		void recordDraws(const vk::CommandBufferInheritanceInfo& inheritanceInfo,
+		                 const entt::registry& registry,
+		                 const Camera& camera,
+		                 vk::Extent2D extent,
+		                 std::vector<vk::CommandBuffer>& commandBuffers,
+		                 std::vector<const Framebuffer*>* sampledFramebuffers)
+		{
+			using MeshRendererType = Components::MeshRenderer<VertexType>;
+
+			const auto frameIndex  = getCurrentFrameIndex();
+			const auto frameNumber = static_cast<uint64_t>(m_frameNumber);
+			auto& frameData        = m_framesData[frameIndex];
+
+			std::vector<const MeshRendererType*> meshRenderers{};
+			m_cullingSpheres.clear();
+			auto view = registry.view<MeshRendererType>();
+			for (const auto& entity : view) {
+				const auto& [mrc] = view.get(entity);
+				if (!mrc.isVisible || !mrc.material->isReady()) { continue; }
+
+				meshRenderers.push_back(&mrc);
+				m_cullingSpheres.push(mrc.mesh->boundingSphere, mrc.getModelMatrix());
+			}
+
+			const auto visibleCount = cullSpheres(Frustum::fromViewProjection(camera.getViewProjection()), m_cullingSpheres, m_visibility);
+			m_frameStatistics.visibleObjects += static_cast<uint32_t>(visibleCount);
+			m_frameStatistics.culledObjects += static_cast<uint32_t>(meshRenderers.size() - visibleCount);
+			if (visibleCount == 0) { return; }
+
+			// Streamed textures are refined according to the on screen size of the bounding spheres they are drawn on
+			const auto& projection    = camera.getProjection();
+			const auto isPerspective  = projection[2][3] != 0.f;
+			const auto streamTextures = m_textureStreamer->hasTextures();
+
+			m_renderQueue.clear();
+			for (std::size_t i = 0; i < meshRenderers.size(); ++i) {
+				if (m_visibility[i] == 0) { continue; }
+
+				const auto* mrc      = meshRenderers[i];
+				const auto drawIndex = static_cast<uint32_t>(i);
+				if (streamTextures) {
+					const auto radius = m_cullingSpheres.radii[i];
+					const glm::vec4 center{m_cullingSpheres.centersX[i], m_cullingSpheres.centersY[i], m_cullingSpheres.centersZ[i], 1.f};
+					const auto distance   = isPerspective ? std::max(-(camera.getView() * center).z, radius) : 1.f;
+					const auto screenSize = radius * std::abs(projection[1][1]) * static_cast<float>(extent.height) / distance;
+					for (const auto& texture : mrc->sampledImages | std::views::values) {
+						m_textureStreamer->requestSize(*texture, screenSize);
+					}
+					for (const auto& texture : mrc->material->sampledImages | std::views::values) {
+						m_textureStreamer->requestSize(*texture, screenSize);
+					}
+				}
+				if (!spec.sortDraws) {
+					m_renderQueue.push(drawIndex, drawIndex);
+					continue;
+				}
+
+				const auto viewPosition = camera.getView() * mrc->getModelMatrix()[3];
+				m_renderQueue.push(RenderQueue::makeKey(m_renderQueue.getSortID(static_cast<VkPipeline>(mrc->material->pipeline)),
+				                                        m_renderQueue.getSortID(mrc->material.get()),
+				                                        m_renderQueue.getSortID(mrc->mesh.get()),
+				                                        -viewPosition.z),
+				                   drawIndex);
+			}
+			if (spec.sortDraws) { m_renderQueue.sort(); }
+
+			// Descriptor sets shared by several mesh renderers are written the first time a frame asks for them, so they are resolved
+			// here, before any recording thread starts: these only touch the descriptor sets owned by a single mesh renderer
+			const auto items = m_renderQueue.getItems();
+			m_drawBatches.clear();
+			uint32_t drawCount = 0;
+			for (std::size_t batchBegin = 0; batchBegin < items.size();) {
+				const auto& mesh     = meshRenderers[items[batchBegin].index]->mesh;
+				const auto& material = meshRenderers[items[batchBegin].index]->material;
+
+				// Instanced draws cannot read more model matrices than the instance data range holds
+				const auto maxBatchEnd =
+				  material->isInstanceable() ? std::min(items.size(), batchBegin + m_maxInstancesPerDraw) : items.size();
+				auto batchEnd = batchBegin + 1;
+				while (batchEnd < maxBatchEnd && meshRenderers[items[batchEnd].index]->mesh == mesh &&
+				       meshRenderers[items[batchEnd].index]->material == material) {
+					++batchEnd;
+				}
+
+				vk::DescriptorSet sharedLevel3Descriptor{};
+				if (material->hasSharedLevel3Descriptor()) {
+					sharedLevel3Descriptor = material->getSharedLevel3Descriptor(frameIndex, frameNumber);
+				}
+				m_drawBatches.push_back(DrawBatch{
+				  .firstItem              = batchBegin,
+				  .itemCount              = batchEnd - batchBegin,
+				  .drawCount              = material->isInstanceable() ? 1 : static_cast<uint32_t>(batchEnd - batchBegin),
+				  .level2Descriptor       = material->getLevel2Descriptor(frameIndex, frameNumber),
+				  .sharedLevel3Descriptor = sharedLevel3Descriptor,
+				});
+				drawCount += m_drawBatches.back().drawCount;
+
+				if (sampledFramebuffers != nullptr) {
+					const auto addSampledFramebuffers = [sampledFramebuffers](const std::map<uint32_t, Ref<Framebuffer>>& framebuffers) {
+						for (const auto& framebuffer : framebuffers | std::views::values) {
+							sampledFramebuffers->push_back(framebuffer.get());
+						}
+					};
+					addSampledFramebuffers(material->sampledFramebuffers);
+					for (const auto& item : items.subspan(batchBegin, batchEnd - batchBegin)) {
+						addSampledFramebuffers(meshRenderers[item.index]->sampledFramebuffers);
+					}
+				}
+
+				batchBegin = batchEnd;
+			}
+
+			// Each group costs a command buffer and the state setup that comes with it, so small draw lists are not split
+			const auto threadCount   = Jobs::getThreadCount();
+			const auto drawsPerGroup = std::max(spec.minDrawsPerRecordingGroup, (drawCount + threadCount - 1) / threadCount);
+			m_recordingGroups.clear();
+			m_recordingGroups.push_back(0);
+			uint32_t groupDrawCount = 0;
+			for (std::size_t batchIndex = 0; batchIndex < m_drawBatches.size(); ++batchIndex) {
+				if (groupDrawCount >= drawsPerGroup) {
+					m_recordingGroups.push_back(batchIndex);
+					groupDrawCount = 0;
+				}
+				groupDrawCount += m_drawBatches[batchIndex].drawCount;
+			}
+
+			const CameraData cameraData{
+			  .viewMatrix           = camera.getView(),
+			  .projectionMatrix     = camera.getProjection(),
+			  .viewProjectionMatrix = camera.getViewProjection(),
+			};
+
+			const auto groupCount         = m_recordingGroups.size();
+			const auto firstCommandBuffer = commandBuffers.size();
+			commandBuffers.resize(firstCommandBuffer + groupCount);
+			std::vector<FrameStatistics> groupStatistics(groupCount);
+			Jobs::parallelFor(groupCount, 1, [&](std::size_t groupIndex) {
+				const auto firstBatch = m_recordingGroups[groupIndex];
+				const auto lastBatch  = groupIndex + 1 < groupCount ? m_recordingGroups[groupIndex + 1] : m_drawBatches.size();
+
+				const auto commandBuffer = frameData.recordingPools[Jobs::getThreadIndex()]->acquire();
+				vk::CommandBufferBeginInfo beginInfo{
+				  .flags            = vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+				  .pInheritanceInfo = &inheritanceInfo,
+				};
+				commandBuffer.begin(beginInfo);
+				recordBatches<VertexType>(commandBuffer,
+				                          std::span{m_drawBatches}.subspan(firstBatch, lastBatch - firstBatch),
+				                          meshRenderers,
+				                          items,
+				                          cameraData,
+				                          extent,
+				                          groupStatistics[groupIndex]);
+				commandBuffer.end();
+
+				commandBuffers[firstCommandBuffer + groupIndex] = commandBuffer;
+			});
+
+			for (const auto& statistics : groupStatistics) { m_frameStatistics += statistics; }
+		}
+
+		// Records the given batches into a secondary command buffer. Called from the job system threads: every resource shared between
+		// batches is only read here.
+		template<Vertex VertexType>
+		void recordBatches(vk::CommandBuffer commandBuffer,
+		                   std::span<const DrawBatch> batches,
+		                   std::span<const Components::MeshRenderer<VertexType>* const> meshRenderers,
+		                   std::span<const RenderQueue::Item> items,
+		                   const CameraData& cameraData,
+		                   vk::Extent2D extent,
+		                   FrameStatistics& statistics)
+		{
+			const auto frameIndex  = getCurrentFrameIndex();
+			const auto frameNumber = static_cast<uint64_t>(m_frameNumber);
+			const auto& frameData  = m_framesData[frameIndex];
+
+			// Secondary command buffers do not inherit any state
+			commandBuffer.setViewport(0,
+			                          vk::Viewport{
+			                            .x        = 0.f,
+			                            .y        = 0.f,
+			                            .width    = static_cast<float>(extent.width),
+			                            .height   = static_cast<float>(extent.height),
+			                            .minDepth = 0.f,
+			                            .maxDepth = 1.f,
+			                          });
+			commandBuffer.setScissor(0,
+			                         vk::Rect2D{
+			                           .offset{0, 0},
+			                           .extent = extent,
+			                         });
+
+			std::vector<uint32_t> dynamicOffsets{};
+			std::vector<glm::mat4> instanceMatrices{};
+			vk::Pipeline currentPipeline{};
+			vk::DescriptorSet currentLevel2Descriptor{};
+			const Mesh<VertexType>* currentMesh{nullptr};
+			bool isFirst = true;
+
+			for (const auto& batchInfo : batches) {
+				const auto batch     = items.subspan(batchInfo.firstItem, batchInfo.itemCount);
+				const auto& mesh     = meshRenderers[batch.front().index]->mesh;
+				const auto& material = meshRenderers[batch.front().index]->material;
+
+				// All pipeline layouts share the layouts of sets 0 and 1 and the push constant range (see LayoutCache), so these stay
+				// valid across pipeline switches and are only bound once
+				if (isFirst) {
+					commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+					                                 material->pipelineLayout,
+					                                 0,
+					                                 {frameData.level0Descriptor, m_textureTable->getDescriptorSet(frameIndex)},
+					                                 {});
+					commandBuffer.pushConstants(
+					  material->pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0, sizeof(cameraData), &cameraData);
+					++statistics.descriptorSetBinds;
+					isFirst = false;
+				}
+				if (currentPipeline != material->pipeline) {
+					commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, material->pipeline);
+					currentPipeline = material->pipeline;
+					++statistics.pipelineBinds;
+				}
+				if (currentLevel2Descriptor != batchInfo.level2Descriptor) {
+					commandBuffer.bindDescriptorSets(
+					  vk::PipelineBindPoint::eGraphics, material->pipelineLayout, 2, batchInfo.level2Descriptor, {});
+					currentLevel2Descriptor = batchInfo.level2Descriptor;
+					++statistics.descriptorSetBinds;
+				}
+				if (currentMesh != mesh.get()) {
+					commandBuffer.bindVertexBuffers(0, mesh->vertexBuffer.vkHandle, {0});
+					commandBuffer.bindIndexBuffer(mesh->indexBuffer.vkHandle, 0, vk::IndexType::eUint32);
+					currentMesh = mesh.get();
+					++statistics.vertexBufferBinds;
+				}
+
+				if (material->isInstanceable()) {
+					instanceMatrices.clear();
+					for (const auto& item : batch) { instanceMatrices.push_back(meshRenderers[item.index]->getModelMatrix()); }
+					const auto instanceOffset = frameData.objectUniformBuffer->push(std::as_bytes(std::span{instanceMatrices}));
+
+					commandBuffer.bindDescriptorSets(
+					  vk::PipelineBindPoint::eGraphics, material->pipelineLayout, 3, batchInfo.sharedLevel3Descriptor, instanceOffset);
+					commandBuffer.drawIndexed(mesh->indexCount, static_cast<uint32_t>(instanceMatrices.size()), 0, 0, 0);
+					++statistics.descriptorSetBinds;
+					++statistics.drawCalls;
+					statistics.instances += static_cast<uint32_t>(instanceMatrices.size());
+					continue;
+				}
+
+				for (const auto& item : batch) {
+					const auto* mrc = meshRenderers[item.index];
+
+					dynamicOffsets.clear();
+					// Dynamic offsets are given in binding order, and the instance data is always at slot 0
+					if (material->shader->isInstanced) {
+						dynamicOffsets.push_back(frameData.objectUniformBuffer->push(std::as_bytes(std::span{&mrc->getModelMatrix(), 1})));
+					}
+					mrc->pushUniforms(*frameData.objectUniformBuffer, dynamicOffsets);
+					auto level3Descriptor = batchInfo.sharedLevel3Descriptor;
+					if (level3Descriptor == vk::DescriptorSet{}) { level3Descriptor = mrc->getLevel3Descriptor(frameIndex, frameNumber); }
+					commandBuffer.bindDescriptorSets(
+					  vk::PipelineBindPoint::eGraphics, material->pipelineLayout, 3, level3Descriptor, dynamicOffsets);
+
+					commandBuffer.drawIndexed(mesh->indexCount, 1, 0, 0, 0);
+					++statistics.descriptorSetBinds;
+					++statistics.drawCalls;
+					++statistics.instances;
+				}
+			}
+		}
+
+		template<Vertex VertexType>
+		UploadTicket uploadMeshData(Mesh<VertexType>& mesh, std::span<const std::byte> vertexData, std::span<const std::byte> indexData)
+		{
+			// Vulkan does not allow empty buffers
+			MRG_ENGINE_ASSERT(!vertexData.empty() && !indexData.empty(), "Cannot upload a mesh without vertices or indices!")
+
+			// mesh vertex buffer
+			mesh.vertexBuffer = AllocatedBuffer{m_allocator,
+			                                    vertexData.size(),
+			                                    vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
+			                                    VMA_MEMORY_USAGE_GPU_ONLY};
+			// mesh index buffer
+			mesh.indexBuffer = AllocatedBuffer{m_allocator,
+			                                   indexData.size(),
+			                                   vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer,
+			                                   VMA_MEMORY_USAGE_GPU_ONLY};
+			mesh.indexCount     = static_cast<uint32_t>(indexData.size() / sizeof(uint32_t));
+			mesh.bounds         = computeBounds<VertexType>(vertexData);
+			mesh.boundingSphere = BoundingSphere::fromBox(mesh.bounds);
+
+			m_uploadQueue->enqueueBufferUpload(vertexData,
+			                                   mesh.vertexBuffer.vkHandle,
+			                                   0,
+			                                   vk::PipelineStageFlagBits::eVertexInput,
+			                                   vk::AccessFlagBits::eVertexAttributeRead);
+			return m_uploadQueue->enqueueBufferUpload(
+			  indexData, mesh.indexBuffer.vkHandle, 0, vk::PipelineStageFlagBits::eVertexInput, vk::AccessFlagBits::eIndexRead);
+		}
+
 		/// Methods called by the application class
 		friend class Application;
 
@@ -4,17 +4,23 @@
 
 #include "RendererTypes.h"
 
-#include "Utils/Commands.h"
+#include "Rendering/MipChain.h"
+#include "Rendering/UploadQueue.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 namespace MRG
 {
 	AllocatedBuffer::AllocatedBuffer(VmaAllocator newAllocator,
 	                                 std::size_t allocSize,
 	                                 vk::BufferUsageFlags bufferUsage,
-	                                 VmaMemoryUsage memoryUsage)
+	                                 VmaMemoryUsage memoryUsage,
+	                                 VmaAllocationCreateFlags allocationFlags)
 	    : allocator{newAllocator}
 	{
 		VkBufferCreateInfo bufferInfo{
@@ -29,7 +35,7 @@ namespace MRG
 		};
 
 		VmaAllocationCreateInfo allocationInfo{
-		  .flags          = 0,
+		  .flags          = allocationFlags,
 		  .usage          = memoryUsage,
 		  .requiredFlags  = 0,
 		  .preferredFlags = 0,
@@ -39,9 +45,11 @@ namespace MRG
 		};
 
 		VkBuffer newRawBuffer;
-		MRG_VK_CHECK(vmaCreateBuffer(allocator, &bufferInfo, &allocationInfo, &newRawBuffer, &allocation, nullptr),
+		VmaAllocationInfo allocationResult;
+		MRG_VK_CHECK(vmaCreateBuffer(allocator, &bufferInfo, &allocationInfo, &newRawBuffer, &allocation, &allocationResult),
 		             "Failed to allocate new buffer!")
-		vkHandle = newRawBuffer;
+		vkHandle   = newRawBuffer;
+		mappedData = allocationResult.pMappedData;
 	}
 
 	AllocatedBuffer::AllocatedBuffer(AllocatedBuffer&& other) noexcept
@@ -49,6 +57,7 @@ namespace MRG
 		allocator  = other.allocator;
 		vkHandle   = other.vkHandle;
 		allocation = other.allocation;
+		mappedData = other.mappedData;
 
 		// necessary to indicate we've taken ownership
 		other.allocator = nullptr;
@@ -66,6 +75,7 @@ namespace MRG
 		allocator  = other.allocator;
 		vkHandle   = other.vkHandle;
 		allocation = other.allocation;
+		mappedData = other.mappedData;
 
 		// necessary to indicate we've taken ownership
 		other.allocator = nullptr;
@@ -73,9 +83,21 @@ namespace MRG
 		return *this;
 	}
 
+	void AllocatedBuffer::write(const void* data, std::size_t size, std::size_t offset) const
+	{
+		MRG_ENGINE_ASSERT(mappedData != nullptr, "Only persistently mapped buffers can be written to directly!")
+		memcpy(static_cast<std::byte*>(mappedData) + offset, data, size);
+		vmaFlushAllocation(allocator, allocation, offset, size);
+	}
+
 	AllocatedImage::AllocatedImage(const AllocatedImageSpecification& specification) : spec{specification}
 	{
-		if (spec.file != nullptr) {
+		if (!spec.levels.empty()) {
+			initFromLevels(spec.levelData, spec.levels, spec.firstMipLevel);
+		} else if (spec.file != nullptr && spec.generateMips) {
+			const auto mipChain = loadMipChain(spec.file, spec.format == vk::Format::eR8G8B8A8Srgb);
+			initFromLevels(mipChain.data, mipChain.levels, 0);
+		} else if (spec.file != nullptr) {
 			int texWidth, texHeight, texChannels;
 			auto* pixels = stbi_load(spec.file, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
 			MRG_ENGINE_ASSERT(pixels != nullptr, "Failed to load image from file: {}", spec.file)
@@ -89,6 +111,72 @@ namespace MRG
 	}
 
 	void AllocatedImage::initFromData(void* imageData, uint32_t imageWidth, uint32_t imageHeight)
+	{
+		mipLevels = 1;
+		createImage(imageWidth, imageHeight);
+
+		vk::ImageSubresourceRange range{
+		  .aspectMask     = vk::ImageAspectFlagBits::eColor,
+		  .baseMipLevel   = 0,
+		  .levelCount     = 1,
+		  .baseArrayLayer = 0,
+		  .layerCount     = 1,
+		};
+		if (imageData != nullptr) {
+			const auto imageSize = static_cast<std::size_t>(imageWidth) * imageHeight * 4;
+			spec.uploadQueue->enqueueImageUpload(std::span{static_cast<const std::byte*>(imageData), imageSize},
+			                                     vkHandle,
+			                                     vk::Extent3D{.width = imageWidth, .height = imageHeight, .depth = 1},
+			                                     range);
+		} else {
+			spec.uploadQueue->enqueueImageInitialisation(vkHandle, range);
+		}
+	}
+
+	void AllocatedImage::initFromLevels(std::span<const std::byte> levelData, std::span<const MipLevel> levels, uint32_t firstMipLevel)
+	{
+		MRG_ENGINE_ASSERT(firstMipLevel < levels.size(), "Invalid first mip level!")
+
+		const auto usedLevels = levels.subspan(firstMipLevel);
+		mipLevels             = static_cast<uint32_t>(usedLevels.size());
+		createImage(usedLevels.front().width, usedLevels.front().height);
+
+		// Every level is uploaded at once, straight from the level data. Files can store the smallest levels first (KTX2 does), so the
+		// range uploaded goes from the first to the last level in memory.
+		std::size_t dataBegin = usedLevels.front().offset;
+		std::size_t dataEnd   = 0;
+		for (const auto& level : usedLevels) {
+			dataBegin = std::min(dataBegin, level.offset);
+			dataEnd   = std::max(dataEnd, level.offset + level.size);
+		}
+		std::vector<vk::BufferImageCopy> regions{};
+		regions.reserve(mipLevels);
+		for (uint32_t level = 0; level < mipLevels; ++level) {
+			const auto& mipLevel = usedLevels[level];
+			regions.push_back(vk::BufferImageCopy{
+			  .bufferOffset = mipLevel.offset - dataBegin,
+			  .imageSubresource =
+			    {
+			      .aspectMask     = vk::ImageAspectFlagBits::eColor,
+			      .mipLevel       = level,
+			      .baseArrayLayer = 0,
+			      .layerCount     = 1,
+			    },
+			  .imageExtent = {.width = mipLevel.width, .height = mipLevel.height, .depth = 1},
+			});
+		}
+
+		vk::ImageSubresourceRange range{
+		  .aspectMask     = vk::ImageAspectFlagBits::eColor,
+		  .baseMipLevel   = 0,
+		  .levelCount     = mipLevels,
+		  .baseArrayLayer = 0,
+		  .layerCount     = 1,
+		};
+		spec.uploadQueue->enqueueImageUpload(levelData.subspan(dataBegin, dataEnd - dataBegin), vkHandle, regions, range);
+	}
+
+	void AllocatedImage::createImage(uint32_t imageWidth, uint32_t imageHeight)
 	{
 		vk::Extent3D imageExtent{
 		  .width  = imageWidth,
@@ -99,7 +187,7 @@ namespace MRG
 		  .imageType   = vk::ImageType::e2D,
 		  .format      = spec.format,
 		  .extent      = imageExtent,
-		  .mipLevels   = 1,
+		  .mipLevels   = mipLevels,
 		  .arrayLayers = 1,
 		  .samples     = vk::SampleCountFlagBits::e1,
 		  .tiling      = vk::ImageTiling::eOptimal,
@@ -119,83 +207,6 @@ namespace MRG
 		vmaCreateImage(spec.allocator, &imageInfo, &imageAllocationInfo, &newRawImage, &allocation, nullptr);
 		vkHandle = newRawImage;
 
-		if (imageData != nullptr) {
-			const auto imageSize = imageWidth * imageHeight * 4;
-			AllocatedBuffer stagingBuffer{spec.allocator, imageSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY};
-
-			void* data;
-			vmaMapMemory(spec.allocator, stagingBuffer.allocation, &data);
-			memcpy(data, imageData, static_cast<std::size_t>(imageSize));
-			vmaUnmapMemory(spec.allocator, stagingBuffer.allocation);
-
-			Utils::Commands::immediateSubmit(spec.device, spec.graphicsQueue, spec.uploadContext, [&](vk::CommandBuffer cmdBuffer) {
-				vk::ImageSubresourceRange range{
-				  .aspectMask     = vk::ImageAspectFlagBits::eColor,
-				  .baseMipLevel   = 0,
-				  .levelCount     = 1,
-				  .baseArrayLayer = 0,
-				  .layerCount     = 1,
-				};
-				vk::ImageMemoryBarrier barrierToTransfer{
-				  .srcAccessMask    = {},
-				  .dstAccessMask    = vk::AccessFlagBits::eTransferWrite,
-				  .oldLayout        = vk::ImageLayout::eUndefined,
-				  .newLayout        = vk::ImageLayout::eTransferDstOptimal,
-				  .image            = vkHandle,
-				  .subresourceRange = range,
-				};
-
-				cmdBuffer.pipelineBarrier(
-				  vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrierToTransfer);
-
-				vk::BufferImageCopy copyRegion{
-				  .imageSubresource =
-				    {
-				      .aspectMask     = vk::ImageAspectFlagBits::eColor,
-				      .mipLevel       = 0,
-				      .baseArrayLayer = 0,
-				      .layerCount     = 1,
-				    },
-				  .imageExtent = imageExtent,
-				};
-				cmdBuffer.copyBufferToImage(stagingBuffer.vkHandle, vkHandle, vk::ImageLayout::eTransferDstOptimal, copyRegion);
-
-				vk::ImageMemoryBarrier barrierToShaders{
-				  .srcAccessMask    = vk::AccessFlagBits::eTransferWrite,
-				  .dstAccessMask    = vk::AccessFlagBits::eShaderRead,
-				  .oldLayout        = vk::ImageLayout::eTransferDstOptimal,
-				  .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
-				  .image            = vkHandle,
-				  .subresourceRange = range,
-				};
-
-				cmdBuffer.pipelineBarrier(
-				  vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrierToShaders);
-			});
-		} else {
-			Utils::Commands::immediateSubmit(spec.device, spec.graphicsQueue, spec.uploadContext, [&](vk::CommandBuffer cmdBuffer) {
-				vk::ImageSubresourceRange range{
-				  .aspectMask     = vk::ImageAspectFlagBits::eColor,
-				  .baseMipLevel   = 0,
-				  .levelCount     = 1,
-				  .baseArrayLayer = 0,
-				  .layerCount     = 1,
-				};
-
-				vk::ImageMemoryBarrier barrierToShaders{
-				  .srcAccessMask    = vk::AccessFlagBits::eTransferWrite,
-				  .dstAccessMask    = vk::AccessFlagBits::eShaderRead,
-				  .oldLayout        = vk::ImageLayout::eUndefined,
-				  .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
-				  .image            = vkHandle,
-				  .subresourceRange = range,
-				};
-
-				cmdBuffer.pipelineBarrier(
-				  vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrierToShaders);
-			});
-		}
-
 		vk::ImageViewCreateInfo imageViewInfo{
 		  .image    = vkHandle,
 		  .viewType = vk::ImageViewType::e2D,
@@ -204,7 +215,7 @@ namespace MRG
 		    {
 		      .aspectMask     = vk::ImageAspectFlagBits::eColor,
 		      .baseMipLevel   = 0,
-		      .levelCount     = 1,
+		      .levelCount     = mipLevels,
 		      .baseArrayLayer = 0,
 		      .layerCount     = 1,
 		    },
@@ -218,6 +229,7 @@ namespace MRG
 		allocation = other.allocation;
 		vkHandle   = other.vkHandle;
 		view       = other.view;
+		mipLevels  = other.mipLevels;
 
 		// necessary to indicate we've taken ownership
 		other.spec.allocator = nullptr;
@@ -242,6 +254,7 @@ namespace MRG
 		allocation = other.allocation;
 		vkHandle   = other.vkHandle;
 		view       = other.view;
+		mipLevels  = other.mipLevels;
 
 		// necessary to indicate we've taken ownership
 		other.spec.allocator = nullptr;
@@ -6,6 +6,7 @@
 #define MORRIGU_RENDERERTYPES_H
 
 #include "Core/Core.h"
+#include "Rendering/MipChain.h"
 #include "Utils/GLMIncludeHelper.h"
 #include "Utils/VMAIncludeHelper.h"
 
@@ -13,25 +14,27 @@
 #include <vulkan/vulkan.hpp>
 
 #include <exception>
+#include <span>
 
 namespace MRG
 {
+	class UploadQueue;
+
 	struct TimeData
 	{
 		glm::vec4 time;
 	};
 
-	struct UploadContext
-	{
-		vk::Fence uploadFence;
-		vk::CommandPool commandPool;
-	};
-
 	class AllocatedBuffer
 	{
 	public:
 		AllocatedBuffer() = default;
-		AllocatedBuffer(VmaAllocator allocator, std::size_t allocSize, vk::BufferUsageFlags bufferUsage, VmaMemoryUsage memoryUsage);
+		// Passing VMA_ALLOCATION_CREATE_MAPPED_BIT keeps the buffer mapped for its whole lifetime
+		AllocatedBuffer(VmaAllocator allocator,
+		                std::size_t allocSize,
+		                vk::BufferUsageFlags bufferUsage,
+		                VmaMemoryUsage memoryUsage,
+		                VmaAllocationCreateFlags allocationFlags = 0);
 		AllocatedBuffer(const AllocatedBuffer&) = delete;
 		AllocatedBuffer(AllocatedBuffer&& other) noexcept;
 		~AllocatedBuffer();
@@ -40,27 +43,39 @@ namespace MRG
 
 		AllocatedBuffer& operator=(AllocatedBuffer&& other) noexcept;
 
+		// Copies the data into the persistently mapped buffer, and flushes it (memory that is not host coherent needs it)
+		void write(const void* data, std::size_t size, std::size_t offset = 0) const;
+
 		VmaAllocator allocator{};
 		vk::Buffer vkHandle{};
 		VmaAllocation allocation{};
+		// Only set for persistently mapped buffers, and stable for their whole lifetime
+		void* mappedData{nullptr};
 	};
 
 	struct AllocatedImageSpecification
 	{
 		vk::Device device;
-		vk::Queue graphicsQueue;
-		UploadContext uploadContext;
-		VmaAllocator allocator = nullptr;
+		UploadQueue* uploadQueue = nullptr;
+		VmaAllocator allocator   = nullptr;
 		vk::ImageUsageFlags usage;
 		vk::Format format = vk::Format::eR8G8B8A8Srgb;
 
 		// From file
 		const char* file = nullptr;
+		// Generates every mip level on the CPU (see generateMipChain)
+		bool generateMips = false;
 
 		// Fropm data
 		void* data      = nullptr;
 		uint32_t width  = 0;
 		uint32_t height = 0;
+
+		// From mip levels already in the image format (a generated mip chain or block compressed data for example), only holding the
+		// levels from firstMipLevel on. Level offsets are relative to levelData, and levels can be stored in any order.
+		std::span<const std::byte> levelData{};
+		std::span<const MipLevel> levels{};
+		uint32_t firstMipLevel = 0;
 	};
 
 	class AllocatedImage
@@ -81,9 +96,13 @@ namespace MRG
 		VmaAllocation allocation{};
 		vk::Image vkHandle{};
 		vk::ImageView view{};
+		uint32_t mipLevels{1};
 
 	private:
 		void initFromData(void* imageData, uint32_t imageWidth, uint32_t imageHeight);
+		void initFromLevels(std::span<const std::byte> levelData, std::span<const MipLevel> levels, uint32_t firstMipLevel);
+		// Creates the image and its view, with mipLevels levels
+		void createImage(uint32_t imageWidth, uint32_t imageHeight);
 	};
 }  // namespace MRG
 
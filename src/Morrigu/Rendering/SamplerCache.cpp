@@ -0,0 +1,74 @@
+#include "SamplerCache.h"
+
+#include "Utils/Hashing.h"
+
+#include <functional>
+
+namespace MRG
+{
+	SamplerCache::SamplerCache(vk::Device device, float maxAnisotropy) : m_device{device}, m_maxAnisotropy{maxAnisotropy} {}
+
+	SamplerCache::~SamplerCache()
+	{
+		for (const auto& [samplerInfo, sampler] : m_samplers) { m_device.destroySampler(sampler); }
+	}
+
+	vk::Sampler SamplerCache::getSampler(const vk::SamplerCreateInfo& samplerInfo)
+	{
+		MRG_ENGINE_ASSERT(samplerInfo.pNext == nullptr, "Extension structures are not supported by the sampler cache!")
+
+		std::lock_guard lock{m_mutex};
+		const auto it = m_samplers.find(samplerInfo);
+		if (it != m_samplers.end()) { return it->second; }
+
+		const auto sampler = m_device.createSampler(samplerInfo);
+		m_samplers.insert(std::make_pair(samplerInfo, sampler));
+		return sampler;
+	}
+
+	vk::Sampler SamplerCache::getSampler(SamplerPreset preset, vk::SamplerAddressMode addressMode)
+	{
+		vk::SamplerCreateInfo samplerInfo{
+		  .magFilter    = vk::Filter::eNearest,
+		  .minFilter    = vk::Filter::eNearest,
+		  .mipmapMode   = vk::SamplerMipmapMode::eNearest,
+		  .addressModeU = addressMode,
+		  .addressModeV = addressMode,
+		  .addressModeW = addressMode,
+		  .maxLod       = VK_LOD_CLAMP_NONE,
+		};
+		if (preset != SamplerPreset::Nearest) {
+			samplerInfo.magFilter  = vk::Filter::eLinear;
+			samplerInfo.minFilter  = vk::Filter::eLinear;
+			samplerInfo.mipmapMode = vk::SamplerMipmapMode::eLinear;
+		}
+		if (preset == SamplerPreset::Anisotropic && m_maxAnisotropy > 1.f) {
+			samplerInfo.anisotropyEnable = VK_TRUE;
+			samplerInfo.maxAnisotropy    = m_maxAnisotropy;
+		}
+
+		return getSampler(samplerInfo);
+	}
+
+	std::size_t SamplerCache::SamplerInfoHash::operator()(const vk::SamplerCreateInfo& samplerInfo) const
+	{
+		std::size_t seed = 0;
+		Utils::Hashing::hashCombine(seed, std::hash<VkSamplerCreateFlags>{}(static_cast<VkSamplerCreateFlags>(samplerInfo.flags)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.magFilter)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.minFilter)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.mipmapMode)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.addressModeU)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.addressModeV)));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.addressModeW)));
+		Utils::Hashing::hashCombine(seed, std::hash<float>{}(samplerInfo.mipLodBias));
+		Utils::Hashing::hashCombine(seed, std::hash<VkBool32>{}(samplerInfo.anisotropyEnable));
+		Utils::Hashing::hashCombine(seed, std::hash<float>{}(samplerInfo.maxAnisotropy));
+		Utils::Hashing::hashCombine(seed, std::hash<VkBool32>{}(samplerInfo.compareEnable));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.compareOp)));
+		Utils::Hashing::hashCombine(seed, std::hash<float>{}(samplerInfo.minLod));
+		Utils::Hashing::hashCombine(seed, std::hash<float>{}(samplerInfo.maxLod));
+		Utils::Hashing::hashCombine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(samplerInfo.borderColor)));
+		Utils::Hashing::hashCombine(seed, std::hash<VkBool32>{}(samplerInfo.unnormalizedCoordinates));
+		return seed;
+	}
+}  // namespace MRG
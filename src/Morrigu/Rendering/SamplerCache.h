@@ -0,0 +1,59 @@
+#ifndef MORRIGU_SAMPLERCACHE_H
+#define MORRIGU_SAMPLERCACHE_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace MRG
+{
+	// Filtering of the samplers textures use. Every preset samples the whole mip chain of the texture.
+	enum class SamplerPreset
+	{
+		// No filtering at all, for pixel art and data textures that must not be interpolated
+		Nearest,
+		// Linear filtering between texels and between mip levels
+		Trilinear,
+		// Trilinear filtering that also takes more samples along the axis the texture is stretched on, for surfaces seen at grazing
+		// angles. Same as Trilinear when the device does not support anisotropic filtering.
+		Anisotropic,
+	};
+
+	// Owns every sampler of the renderer, and returns the existing one when asked for an identical sampler, as the number of samplers alive
+	// at the same time is limited (see maxSamplerAllocationCount, which can be as low as 4000).
+	// Samplers live as long as the cache. Can be used from any thread.
+	class SamplerCache
+	{
+	public:
+		// Anisotropic filtering is disabled when maxAnisotropy is 1 or less
+		SamplerCache(vk::Device device, float maxAnisotropy);
+		SamplerCache(const SamplerCache&) = delete;
+		SamplerCache(SamplerCache&&)      = delete;
+		~SamplerCache();
+
+		SamplerCache& operator=(const SamplerCache&) = delete;
+		SamplerCache& operator=(SamplerCache&&) = delete;
+
+		// Extension structures (pNext) are not supported
+		[[nodiscard]] vk::Sampler getSampler(const vk::SamplerCreateInfo& samplerInfo);
+		[[nodiscard]] vk::Sampler getSampler(SamplerPreset preset, vk::SamplerAddressMode addressMode);
+
+		[[nodiscard]] float getMaxAnisotropy() const { return m_maxAnisotropy; }
+
+	private:
+		struct SamplerInfoHash
+		{
+			std::size_t operator()(const vk::SamplerCreateInfo& samplerInfo) const;
+		};
+
+		vk::Device m_device;
+		float m_maxAnisotropy;
+
+		std::mutex m_mutex{};
+		std::unordered_map<vk::SamplerCreateInfo, vk::Sampler, SamplerInfoHash> m_samplers{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_SAMPLERCACHE_H
@@ -0,0 +1,35 @@
+#include "SecondaryCommandPool.h"
+
+namespace MRG
+{
+	SecondaryCommandPool::SecondaryCommandPool(vk::Device device, uint32_t queueFamilyIndex) : m_device{device}
+	{
+		vk::CommandPoolCreateInfo poolInfo{
+		  .flags            = vk::CommandPoolCreateFlagBits::eTransient,
+		  .queueFamilyIndex = queueFamilyIndex,
+		};
+		m_commandPool = m_device.createCommandPool(poolInfo);
+	}
+
+	SecondaryCommandPool::~SecondaryCommandPool() { m_device.destroyCommandPool(m_commandPool); }
+
+	vk::CommandBuffer SecondaryCommandPool::acquire()
+	{
+		if (m_usedCount == m_commandBuffers.size()) {
+			vk::CommandBufferAllocateInfo allocInfo{
+			  .commandPool        = m_commandPool,
+			  .level              = vk::CommandBufferLevel::eSecondary,
+			  .commandBufferCount = 1,
+			};
+			m_commandBuffers.push_back(m_device.allocateCommandBuffers(allocInfo)[0]);
+		}
+
+		return m_commandBuffers[m_usedCount++];
+	}
+
+	void SecondaryCommandPool::reset()
+	{
+		m_device.resetCommandPool(m_commandPool);
+		m_usedCount = 0;
+	}
+}  // namespace MRG
@@ -0,0 +1,36 @@
+#ifndef MORRIGU_SECONDARYCOMMANDPOOL_H
+#define MORRIGU_SECONDARYCOMMANDPOOL_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <vector>
+
+namespace MRG
+{
+	// A command pool owned by a single recording thread for a single frame in flight. Secondary command buffers are allocated on demand,
+	// and all recycled at once by resetting the pool when the GPU is done with the frame.
+	class SecondaryCommandPool
+	{
+	public:
+		SecondaryCommandPool(vk::Device device, uint32_t queueFamilyIndex);
+		SecondaryCommandPool(const SecondaryCommandPool&) = delete;
+		SecondaryCommandPool(SecondaryCommandPool&&)      = delete;
+		~SecondaryCommandPool();
+
+		SecondaryCommandPool& operator=(const SecondaryCommandPool&) = delete;
+		SecondaryCommandPool& operator=(SecondaryCommandPool&&) = delete;
+
+		// Returns a secondary command buffer that is not used by anything else until the next reset
+		[[nodiscard]] vk::CommandBuffer acquire();
+		void reset();
+
+	private:
+		vk::Device m_device;
+		vk::CommandPool m_commandPool;
+
+		std::vector<vk::CommandBuffer> m_commandBuffers{};
+		std::size_t m_usedCount{0};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_SECONDARYCOMMANDPOOL_H
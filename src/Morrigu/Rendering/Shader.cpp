@@ -5,20 +5,298 @@
 #include "Shader.h"
 
 #include "Core/FileNames.h"
+#include "Utils/Hashing.h"
+#include "Utils/MappedFile.h"
 
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <span>
+#include <thread>
+#include <type_traits>
+
+namespace
+{
+	struct ReflectionCacheHeader
+	{
+		static constexpr std::array<char, 4> expectedMagic{'M', 'R', 'G', 'R'};
+		// Increment this whenever the layout of the file changes
+		static constexpr uint16_t currentVersion = 2;
+		// Caches are looked up by the hash of the SPIR-V alone, so increment this whenever what Shader::reflect extracts changes, or when
+		// the types it fills in (Shader::Root, Shader::Node, Shader::TextureBindingInfo, ...) do, even if the file layout stays the same.
+		// Caches made by an older engine would be trusted otherwise.
+		static constexpr uint16_t currentReflectionVersion = 1;
+
+		std::array<char, 4> magic{expectedMagic};
+		uint16_t version{currentVersion};
+		uint16_t reflectionVersion{currentReflectionVersion};
+		uint64_t sourceHash{};
+	};
+
+	class BlobWriter
+	{
+	public:
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		void write(const T& value)
+		{
+			const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+			m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+		}
+		void write(const std::string& value)
+		{
+			write(static_cast<uint32_t>(value.size()));
+			const auto* bytes = reinterpret_cast<const std::byte*>(value.data());
+			m_data.insert(m_data.end(), bytes, bytes + value.size());
+		}
+
+		[[nodiscard]] const std::vector<std::byte>& getData() const { return m_data; }
+
+	private:
+		std::vector<std::byte> m_data{};
+	};
+
+	// Every read fails instead of going past the end of the data, so truncated files are simply rejected
+	class BlobReader
+	{
+	public:
+		explicit BlobReader(std::span<const std::byte> data) : m_data{data} {}
+
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		[[nodiscard]] bool read(T& value)
+		{
+			if (m_data.size() - m_offset < sizeof(T)) { return false; }
+			std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+		[[nodiscard]] bool read(std::string& value)
+		{
+			uint32_t size = 0;
+			if (!read(size) || m_data.size() - m_offset < size) { return false; }
+			value.assign(reinterpret_cast<const char*>(m_data.data() + m_offset), size);
+			m_offset += size;
+			return true;
+		}
+
+		[[nodiscard]] bool isAtEnd() const { return m_offset == m_data.size(); }
+
+	private:
+		std::span<const std::byte> m_data;
+		std::size_t m_offset{0};
+	};
+
+	void writeBindings(BlobWriter& writer, const std::vector<vk::DescriptorSetLayoutBinding>& bindings)
+	{
+		writer.write(static_cast<uint32_t>(bindings.size()));
+		for (const auto& binding : bindings) {
+			writer.write(binding.binding);
+			writer.write(static_cast<uint32_t>(binding.descriptorType));
+			writer.write(binding.descriptorCount);
+			writer.write(static_cast<VkShaderStageFlags>(binding.stageFlags));
+		}
+	}
+
+	[[nodiscard]] bool readBindings(BlobReader& reader, std::vector<vk::DescriptorSetLayoutBinding>& bindings)
+	{
+		uint32_t bindingCount = 0;
+		if (!reader.read(bindingCount)) { return false; }
+		for (uint32_t i = 0; i < bindingCount; ++i) {
+			uint32_t binding         = 0;
+			uint32_t descriptorType  = 0;
+			uint32_t descriptorCount = 0;
+			VkShaderStageFlags stageFlags{};
+			if (!reader.read(binding) || !reader.read(descriptorType) || !reader.read(descriptorCount) || !reader.read(stageFlags)) {
+				return false;
+			}
+			bindings.push_back(vk::DescriptorSetLayoutBinding{
+			  .binding         = binding,
+			  .descriptorType  = static_cast<vk::DescriptorType>(descriptorType),
+			  .descriptorCount = descriptorCount,
+			  .stageFlags      = vk::ShaderStageFlags{stageFlags},
+			});
+		}
+		return true;
+	}
+
+	void writeNode(BlobWriter& writer, const MRG::Shader::Node& node)
+	{
+		writer.write(node.name);
+		writer.write(static_cast<uint32_t>(node.type.basetype));
+		writer.write(node.type.width);
+		writer.write(node.type.vecsize);
+		writer.write(node.type.columns);
+		writer.write(static_cast<uint32_t>(node.type.array.size()));
+		for (const auto arraySize : node.type.array) { writer.write(arraySize); }
+
+		writer.write(static_cast<uint32_t>(node.members.size()));
+		for (const auto& member : node.members) { writeNode(writer, member); }
+	}
+
+	[[nodiscard]] bool readNode(BlobReader& reader, MRG::Shader::Node& node)
+	{
+		uint32_t baseType   = 0;
+		uint32_t arrayCount = 0;
+		if (!reader.read(node.name) || !reader.read(baseType) || !reader.read(node.type.width) || !reader.read(node.type.vecsize) ||
+		    !reader.read(node.type.columns) || !reader.read(arrayCount)) {
+			return false;
+		}
+		node.type.basetype = static_cast<spirv_cross::SPIRType::BaseType>(baseType);
+		for (uint32_t i = 0; i < arrayCount; ++i) {
+			uint32_t arraySize = 0;
+			if (!reader.read(arraySize)) { return false; }
+			node.type.array.push_back(arraySize);
+			node.type.array_size_literal.push_back(true);
+		}
+
+		uint32_t memberCount = 0;
+		if (!reader.read(memberCount)) { return false; }
+		for (uint32_t i = 0; i < memberCount; ++i) {
+			MRG::Shader::Node member{};
+			if (!readNode(reader, member)) { return false; }
+			node.members.push_back(std::move(member));
+		}
+		return true;
+	}
+
+	void writeUBOData(BlobWriter& writer, const std::map<uint32_t, MRG::Shader::Root>& uboData)
+	{
+		writer.write(static_cast<uint32_t>(uboData.size()));
+		for (const auto& [bindingSlot, root] : uboData) {
+			const uint64_t size = root.size;
+			writer.write(bindingSlot);
+			writer.write(size);
+			writeNode(writer, root);
+		}
+	}
+
+	[[nodiscard]] bool readUBOData(BlobReader& reader, std::map<uint32_t, MRG::Shader::Root>& uboData)
+	{
+		uint32_t uboCount = 0;
+		if (!reader.read(uboCount)) { return false; }
+		for (uint32_t i = 0; i < uboCount; ++i) {
+			uint32_t bindingSlot = 0;
+			uint64_t size        = 0;
+			if (!reader.read(bindingSlot) || !reader.read(size)) { return false; }
+			MRG::Shader::Root root{size};
+			if (!readNode(reader, root)) { return false; }
+			uboData.insert(std::make_pair(bindingSlot, std::move(root)));
+		}
+		return true;
+	}
+
+	void writeImageBindings(BlobWriter& writer, const std::map<uint32_t, MRG::Shader::TextureBindingInfo>& imageBindings)
+	{
+		writer.write(static_cast<uint32_t>(imageBindings.size()));
+		for (const auto& [bindingSlot, bindingInfo] : imageBindings) {
+			writer.write(bindingSlot);
+			writer.write(bindingInfo.name);
+		}
+	}
+
+	[[nodiscard]] bool readImageBindings(BlobReader& reader, std::map<uint32_t, MRG::Shader::TextureBindingInfo>& imageBindings)
+	{
+		uint32_t imageCount = 0;
+		if (!reader.read(imageCount)) { return false; }
+		for (uint32_t i = 0; i < imageCount; ++i) {
+			uint32_t bindingSlot = 0;
+			MRG::Shader::TextureBindingInfo bindingInfo{};
+			if (!reader.read(bindingSlot) || !reader.read(bindingInfo.name)) { return false; }
+			imageBindings.insert(std::make_pair(bindingSlot, std::move(bindingInfo)));
+		}
+		return true;
+	}
+
+	[[nodiscard]] std::string getReflectionCachePath(uint64_t sourceHash)
+	{
+		return fmt::format("{}{:016x}{}",
+		                   MRG::Folders::Rendering::shaderReflectionCacheFolder,
+		                   sourceHash,
+		                   MRG::Files::Rendering::shaderReflectionExtension);
+	}
+}  // namespace
 
 namespace MRG
 {
-	Shader::Shader(vk::Device device, const char* vertexShaderName, const char* fragmentShaderName) : m_device(device)
+	Shader::Shader(vk::Device device, LayoutCache& layoutCache, const char* vertexShaderName, const char* fragmentShaderName)
+	    : m_device(device)
 	{
-		auto vertSrc = readSource(vertexShaderName);
-		auto fragSrc = readSource(fragmentShaderName);
+		const auto vertSrc = readSource(vertexShaderName);
+		const auto fragSrc = readSource(fragmentShaderName);
 
 		vertexShaderModule   = loadShaderModule(vertSrc);
 		fragmentShaderModule = loadShaderModule(fragSrc);
 
+		// Reflection only depends on the SPIR-V, so it is done once per pair of sources and then read back from the cache
+		const auto sourceHash = hashSources(vertSrc, fragSrc);
+		auto reflection       = loadCachedReflection(sourceHash);
+		if (!reflection.has_value()) {
+			MRG_ENGINE_TRACE("Reflecting shader \"{}\"/\"{}\".", vertexShaderName, fragmentShaderName)
+			reflection = reflect(vertSrc, fragSrc);
+			saveCachedReflection(sourceHash, *reflection);
+		}
+
+		l2UBOData       = std::move(reflection->l2UBOData);
+		l2ImageBindings = std::move(reflection->l2ImageBindings);
+		l3UBOData       = std::move(reflection->l3UBOData);
+		l3ImageBindings = std::move(reflection->l3ImageBindings);
+		isInstanced     = reflection->isInstanced;
+
+		for (const auto& [bindingSlot, uniformData] : l2UBOData) {
+			if (isTextureIndex(uniformData)) { l2TextureIndices.insert(std::make_pair(bindingSlot, TextureBindingInfo{uniformData.name})); }
+		}
+		for (const auto& [bindingSlot, uniformData] : l3UBOData) {
+			if (isTextureIndex(uniformData)) { l3TextureIndices.insert(std::make_pair(bindingSlot, TextureBindingInfo{uniformData.name})); }
+		}
+
+		level2DSL = layoutCache.getDescriptorSetLayout(reflection->level2Bindings);
+		level3DSL = layoutCache.getDescriptorSetLayout(reflection->level3Bindings);
+	}
+
+	Shader::~Shader()
+	{
+		m_device.destroyShaderModule(vertexShaderModule);
+		m_device.destroyShaderModule(fragmentShaderModule);
+	}
+
+	std::vector<std::uint32_t> Shader::readSource(const char* filePath)
+	{
+		const auto completePath = Folders::Rendering::shadersFolder + filePath;
+		MRG_ENGINE_ASSERT(std::filesystem::exists(completePath), "Shader file \"{}\" does not exists!", completePath)
+		std::ifstream file{completePath, std::ios::binary | std::ios::ate};
+		const auto fileSize = static_cast<std::size_t>(file.tellg());
+		std::vector<std::uint32_t> buffer(fileSize / sizeof(std::uint32_t));
+		file.seekg(std::ios::beg);
+		file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(fileSize));
+		file.close();
+
+		return buffer;
+	}
+
+	vk::ShaderModule Shader::loadShaderModule(const std::vector<uint32_t>& src)
+	{
+		vk::ShaderModuleCreateInfo moduleInfo{
+		  .codeSize = static_cast<std::uint32_t>(src.size() * sizeof(std::uint32_t)),
+		  .pCode    = src.data(),
+		};
+		return m_device.createShaderModule(moduleInfo);
+	}
+
+	bool Shader::isTextureIndex(const Root& uniformData)
+	{
+		if (uniformData.members.size() != 1) { return false; }
+		const auto& member = uniformData.members.front();
+		return member.name == "textureIndex" && member.type.basetype == spirv_cross::SPIRType::BaseType::UInt &&
+		       member.type.vecsize == 1 && member.type.columns == 1 && member.type.array.empty();
+	}
+
+	Shader::Reflection Shader::reflect(const std::vector<uint32_t>& vertSrc, const std::vector<uint32_t>& fragSrc)
+	{
+		Reflection reflection{};
+
 		const auto vertexCompiler   = spirv_cross::Compiler{vertSrc};
 		const auto fragmentCompiler = spirv_cross::Compiler{fragSrc};
 
@@ -42,12 +320,14 @@ namespace MRG
 			// We are only interested in DS level 2 and 3: levels 0 and 1 do not vary by material
 			if (setLevel >= 2) {
 				auto& bindingsMap = (setLevel == 2) ? level2UBOBindings : level3UBOBindings;
-				auto& sizeMap     = (setLevel == 2) ? l2UBOData : l3UBOData;
+				auto& sizeMap     = (setLevel == 2) ? reflection.l2UBOData : reflection.l3UBOData;
+				// Per object uniforms all live in a single per frame buffer, and are selected with dynamic offsets when drawing
+				const auto uboType = (setLevel == 2) ? vk::DescriptorType::eUniformBuffer : vk::DescriptorType::eUniformBufferDynamic;
 
 				bindingsMap.insert(std::make_pair(bindingSlot,
 				                                  vk::DescriptorSetLayoutBinding{
 				                                    .binding         = bindingSlot,
-				                                    .descriptorType  = vk::DescriptorType::eUniformBuffer,
+				                                    .descriptorType  = uboType,
 				                                    .descriptorCount = 1,
 				                                    .stageFlags      = vk::ShaderStageFlagBits::eVertex,
 				                                  }));
@@ -67,7 +347,7 @@ namespace MRG
 			// We are only interested in DS level 2 and 3: levels 0 and 1 do not vary by material
 			if (setLevel >= 2) {
 				auto& bindingsMap = (setLevel == 2) ? level2SampledImagesBindings : level3SampledImagesBindings;
-				auto& sizeMap     = (setLevel == 2) ? l2ImageBindings : l3ImageBindings;
+				auto& sizeMap     = (setLevel == 2) ? reflection.l2ImageBindings : reflection.l3ImageBindings;
 
 				bindingsMap.insert(std::make_pair(bindingSlot,
 				                                  vk::DescriptorSetLayoutBinding{
@@ -80,6 +360,24 @@ namespace MRG
 			}
 		}
 
+		// storage buffers (only used for instanced model data)
+		for (const auto& storageBuffer : vertResources.storage_buffers) {
+			const auto setLevel    = vertexCompiler.get_decoration(storageBuffer.id, spv::DecorationDescriptorSet);
+			const auto bindingSlot = vertexCompiler.get_decoration(storageBuffer.id, spv::DecorationBinding);
+
+			MRG_ENGINE_ASSERT(setLevel == 3 && bindingSlot == 0,
+			                  "Invalid shader detected: storage buffers are only allowed for instanced model data (set 3, binding 0)!")
+
+			level3UBOBindings.insert(std::make_pair(bindingSlot,
+			                                        vk::DescriptorSetLayoutBinding{
+			                                          .binding         = bindingSlot,
+			                                          .descriptorType  = vk::DescriptorType::eStorageBufferDynamic,
+			                                          .descriptorCount = 1,
+			                                          .stageFlags      = vk::ShaderStageFlagBits::eVertex,
+			                                        }));
+			reflection.isInstanced = true;
+		}
+
 		//// fragment shader
 		const auto& fragResources = fragmentCompiler.get_shader_resources();
 
@@ -94,7 +392,8 @@ namespace MRG
 			// We are only interested in DS level 2 and 3: levels 0 and 1 do not vary by material
 			if (setLevel >= 2) {
 				auto& bindingsMap = (setLevel == 2) ? level2UBOBindings : level3UBOBindings;
-				auto& sizeMap     = (setLevel == 2) ? l2UBOData : l3UBOData;
+				auto& sizeMap     = (setLevel == 2) ? reflection.l2UBOData : reflection.l3UBOData;
+				const auto uboType = (setLevel == 2) ? vk::DescriptorType::eUniformBuffer : vk::DescriptorType::eUniformBufferDynamic;
 
 				if (bindingsMap.contains(bindingSlot)) {
 					bindingsMap.at(bindingSlot).stageFlags |= vk::ShaderStageFlagBits::eFragment;
@@ -102,7 +401,7 @@ namespace MRG
 					bindingsMap.insert(std::make_pair(bindingSlot,
 					                                  vk::DescriptorSetLayoutBinding{
 					                                    .binding         = bindingSlot,
-					                                    .descriptorType  = vk::DescriptorType::eUniformBuffer,
+					                                    .descriptorType  = uboType,
 					                                    .descriptorCount = 1,
 					                                    .stageFlags      = vk::ShaderStageFlagBits::eFragment,
 					                                  }));
@@ -122,7 +421,7 @@ namespace MRG
 			// We are only interested in DS level 2 and 3: levels 0 and 1 do not vary by material
 			if (setLevel >= 2) {
 				auto& bindingsMap = (setLevel == 2) ? level2SampledImagesBindings : level3SampledImagesBindings;
-				auto& sizeMap     = (setLevel == 2) ? l2ImageBindings : l3ImageBindings;
+				auto& sizeMap     = (setLevel == 2) ? reflection.l2ImageBindings : reflection.l3ImageBindings;
 
 				if (bindingsMap.contains(bindingSlot)) {
 					bindingsMap.at(bindingSlot).stageFlags |= vk::ShaderStageFlagBits::eFragment;
@@ -139,62 +438,27 @@ namespace MRG
 			}
 		}
 
-		MRG_ENGINE_ASSERT(level3UBOBindings.contains(0), "Descriptor set level 3 MUST have a model data uniform at slot 0!")
+		// Model data is read in the vertex shader, the fragment shader cannot declare it alone
+		for (const auto& storageBuffer : fragResources.storage_buffers) {
+			const auto setLevel    = fragmentCompiler.get_decoration(storageBuffer.id, spv::DecorationDescriptorSet);
+			const auto bindingSlot = fragmentCompiler.get_decoration(storageBuffer.id, spv::DecorationBinding);
 
-		std::vector<vk::DescriptorSetLayoutBinding> finalBindings(level2UBOBindings.size() + level2SampledImagesBindings.size());
-		std::size_t index = 0;
-		for (const auto& ubo : level2UBOBindings) { finalBindings[index++] = ubo.second; }
-		for (const auto& sampledImage : level2SampledImagesBindings) { finalBindings[index++] = sampledImage.second; }
-
-		vk::DescriptorSetLayoutCreateInfo setInfo{
-		  .bindingCount = static_cast<uint32_t>(finalBindings.size()),
-		  .pBindings    = finalBindings.data(),
-		};
-
-		level2DSL = m_device.createDescriptorSetLayout(setInfo);
+			MRG_ENGINE_ASSERT(setLevel == 3 && bindingSlot == 0 && reflection.isInstanced,
+			                  "Invalid shader detected: storage buffers are only allowed for instanced model data (set 3, binding 0)!")
+			level3UBOBindings.at(bindingSlot).stageFlags |= vk::ShaderStageFlagBits::eFragment;
+		}
 
-		finalBindings.resize(level3UBOBindings.size() + level3SampledImagesBindings.size());
-		index = 0;
-		for (const auto& ubo : level3UBOBindings) { finalBindings[index++] = ubo.second; }
-		for (const auto& sampledImage : level3SampledImagesBindings) { finalBindings[index++] = sampledImage.second; }
+		MRG_ENGINE_ASSERT(level3UBOBindings.contains(0), "Descriptor set level 3 MUST have model data at slot 0!")
 
-		setInfo = vk::DescriptorSetLayoutCreateInfo{
-		  .bindingCount = static_cast<uint32_t>(finalBindings.size()),
-		  .pBindings    = finalBindings.data(),
-		};
+		reflection.level2Bindings.reserve(level2UBOBindings.size() + level2SampledImagesBindings.size());
+		for (const auto& ubo : level2UBOBindings) { reflection.level2Bindings.push_back(ubo.second); }
+		for (const auto& sampledImage : level2SampledImagesBindings) { reflection.level2Bindings.push_back(sampledImage.second); }
 
-		level3DSL = m_device.createDescriptorSetLayout(setInfo);
-	}
+		reflection.level3Bindings.reserve(level3UBOBindings.size() + level3SampledImagesBindings.size());
+		for (const auto& ubo : level3UBOBindings) { reflection.level3Bindings.push_back(ubo.second); }
+		for (const auto& sampledImage : level3SampledImagesBindings) { reflection.level3Bindings.push_back(sampledImage.second); }
 
-	Shader::~Shader()
-	{
-		m_device.destroyDescriptorSetLayout(level3DSL);
-		m_device.destroyDescriptorSetLayout(level2DSL);
-		m_device.destroyShaderModule(vertexShaderModule);
-		m_device.destroyShaderModule(fragmentShaderModule);
-	}
-
-	std::vector<std::uint32_t> Shader::readSource(const char* filePath)
-	{
-		const auto completePath = Folders::Rendering::shadersFolder + filePath;
-		MRG_ENGINE_ASSERT(std::filesystem::exists(completePath), "Shader file \"{}\" does not exists!", completePath)
-		std::ifstream file{completePath, std::ios::binary | std::ios::ate};
-		const auto fileSize = static_cast<std::size_t>(file.tellg());
-		std::vector<std::uint32_t> buffer(fileSize / sizeof(std::uint32_t));
-		file.seekg(std::ios::beg);
-		file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(fileSize));
-		file.close();
-
-		return buffer;
-	}
-
-	vk::ShaderModule Shader::loadShaderModule(const std::vector<uint32_t>& src)
-	{
-		vk::ShaderModuleCreateInfo moduleInfo{
-		  .codeSize = static_cast<std::uint32_t>(src.size() * sizeof(std::uint32_t)),
-		  .pCode    = src.data(),
-		};
-		return m_device.createShaderModule(moduleInfo);
+		return reflection;
 	}
 
 	Shader::Root Shader::populateUniformData(const spirv_cross::Compiler& compiler, const spirv_cross::Resource& uniform)
@@ -227,4 +491,82 @@ namespace MRG
 
 		return currentNode;
 	}
+
+	uint64_t Shader::hashSources(const std::vector<uint32_t>& vertSrc, const std::vector<uint32_t>& fragSrc)
+	{
+		// The size of the vertex source is hashed first, so that moving code from one stage to the other changes the hash
+		uint64_t hash = Utils::Hashing::fnv1aOffsetBasis;
+		Utils::Hashing::fnv1a(hash, static_cast<uint64_t>(vertSrc.size()));
+		Utils::Hashing::fnv1a(hash, std::as_bytes(std::span{vertSrc}));
+		Utils::Hashing::fnv1a(hash, std::as_bytes(std::span{fragSrc}));
+
+		return hash;
+	}
+
+	std::optional<Shader::Reflection> Shader::loadCachedReflection(uint64_t sourceHash)
+	{
+		const auto cachePath = getReflectionCachePath(sourceHash);
+		Utils::MappedFile file{cachePath};
+		if (!file.isValid()) { return std::nullopt; }
+
+		BlobReader reader{file.getData()};
+		ReflectionCacheHeader header;
+		if (!reader.read(header) || header.magic != ReflectionCacheHeader::expectedMagic ||
+		    header.version != ReflectionCacheHeader::currentVersion ||
+		    header.reflectionVersion != ReflectionCacheHeader::currentReflectionVersion || header.sourceHash != sourceHash) {
+			MRG_ENGINE_WARN("Shader reflection cache \"{}\" is outdated, ignoring it", cachePath)
+			return std::nullopt;
+		}
+
+		Reflection reflection{};
+		uint32_t isInstanced = 0;
+		if (!readBindings(reader, reflection.level2Bindings) || !readBindings(reader, reflection.level3Bindings) ||
+		    !readUBOData(reader, reflection.l2UBOData) || !readImageBindings(reader, reflection.l2ImageBindings) ||
+		    !readUBOData(reader, reflection.l3UBOData) || !readImageBindings(reader, reflection.l3ImageBindings) ||
+		    !reader.read(isInstanced) || !reader.isAtEnd()) {
+			MRG_ENGINE_WARN("Shader reflection cache \"{}\" is corrupted, ignoring it", cachePath)
+			return std::nullopt;
+		}
+		reflection.isInstanced = (isInstanced != 0);
+
+		return reflection;
+	}
+
+	void Shader::saveCachedReflection(uint64_t sourceHash, const Reflection& reflection)
+	{
+		BlobWriter writer{};
+		writer.write(ReflectionCacheHeader{.sourceHash = sourceHash});
+		writeBindings(writer, reflection.level2Bindings);
+		writeBindings(writer, reflection.level3Bindings);
+		writeUBOData(writer, reflection.l2UBOData);
+		writeImageBindings(writer, reflection.l2ImageBindings);
+		writeUBOData(writer, reflection.l3UBOData);
+		writeImageBindings(writer, reflection.l3ImageBindings);
+		writer.write(static_cast<uint32_t>(reflection.isInstanced));
+
+		// A cache that cannot be written only means the shader is reflected again next time
+		std::error_code error{};
+		std::filesystem::create_directories(Folders::Rendering::shaderReflectionCacheFolder, error);
+		const auto cachePath = getReflectionCachePath(sourceHash);
+		// Several threads may write the same cache at once, so each one has its own temporary file
+		const auto tempFilePath = fmt::format("{}.{}.tmp", cachePath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			std::ofstream file{tempFilePath, std::ios::binary | std::ios::trunc};
+			const auto& data = writer.getData();
+			file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			if (!file) {
+				MRG_ENGINE_WARN("Failed to write shader reflection cache \"{}\"", tempFilePath)
+				file.close();
+				std::filesystem::remove(tempFilePath, error);
+				return;
+			}
+		}
+
+		// Renaming over an existing file is atomic, so readers (and crashes) never see a partially written cache
+		std::filesystem::rename(tempFilePath, cachePath, error);
+		if (error) {
+			MRG_ENGINE_WARN("Failed to replace shader reflection cache \"{}\": {}", cachePath, error.message())
+			std::filesystem::remove(tempFilePath, error);
+		}
+	}
 }  // namespace MRG
@@ -5,11 +5,14 @@
 #ifndef MORRIGU_SHADER_H
 #define MORRIGU_SHADER_H
 
+#include "Rendering/LayoutCache.h"
 #include "Rendering/RendererTypes.h"
 
 #include <spirv_cross/spirv_reflect.hpp>
 
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace MRG
 {
@@ -34,29 +37,60 @@ namespace MRG
 			std::size_t size{};
 		};
 
-		explicit Shader(vk::Device device, const char* vertexShaderName, const char* fragmentShaderName);
+		explicit Shader(vk::Device device, LayoutCache& layoutCache, const char* vertexShaderName, const char* fragmentShaderName);
 		~Shader();
 
 		vk::ShaderModule vertexShaderModule;
 		vk::ShaderModule fragmentShaderModule;
 
+		// Both owned by the layout cache, so shaders with the same bindings share them
 		vk::DescriptorSetLayout level2DSL;
 		vk::DescriptorSetLayout level3DSL;
 
 		// level 2 bindings
 		std::map<uint32_t, Root> l2UBOData;
 		std::map<uint32_t, TextureBindingInfo> l2ImageBindings;
+		// Subset of l2UBOData holding the index of a texture of the texture table (see isTextureIndex)
+		std::map<uint32_t, TextureBindingInfo> l2TextureIndices;
 		// level 3 bindings
 		std::map<uint32_t, Root> l3UBOData;
 		std::map<uint32_t, TextureBindingInfo> l3ImageBindings;
+		std::map<uint32_t, TextureBindingInfo> l3TextureIndices;
+		// Set when the level 3 model data (slot 0) is a storage buffer of model matrices indexed with gl_InstanceIndex instead of a
+		// uniform buffer. It is then not part of l3UBOData.
+		bool isInstanced{false};
 
 	private:
+		// Everything extracted from the SPIR-V of both stages. Only the type fields the engine uses (base type, width, vector size,
+		// columns and array sizes) survive a round trip through the on disk cache.
+		struct Reflection
+		{
+			std::vector<vk::DescriptorSetLayoutBinding> level2Bindings{};
+			std::vector<vk::DescriptorSetLayoutBinding> level3Bindings{};
+			std::map<uint32_t, Root> l2UBOData{};
+			std::map<uint32_t, TextureBindingInfo> l2ImageBindings{};
+			std::map<uint32_t, Root> l3UBOData{};
+			std::map<uint32_t, TextureBindingInfo> l3ImageBindings{};
+			bool isInstanced{false};
+		};
+
 		[[nodiscard]] static std::vector<std::uint32_t> readSource(const char* filePath);
 		[[nodiscard]] vk::ShaderModule loadShaderModule(const std::vector<uint32_t>& src);
+
+		// Uniform blocks made of a single uint named "textureIndex" select a texture of the texture table:
+		//     layout(set = 3, binding = 1) uniform TextureData { uint textureIndex; } u_TextureData;
+		// Materials and mesh renderers then fill them in when binding a texture to their slot.
+		[[nodiscard]] static bool isTextureIndex(const Root& uniformData);
+		[[nodiscard]] static Reflection reflect(const std::vector<uint32_t>& vertSrc, const std::vector<uint32_t>& fragSrc);
 		[[nodiscard]] static Root populateUniformData(const spirv_cross::Compiler& compiler, const spirv_cross::Resource& uniform);
 		[[nodiscard]] static Node
 		getShaderStructData(const spirv_cross::Compiler& compiler, spirv_cross::TypeID baseType, uint32_t memberIndex);
 
+		// The reflection cache holds one file per pair of sources, named after the hash of their content
+		[[nodiscard]] static uint64_t hashSources(const std::vector<uint32_t>& vertSrc, const std::vector<uint32_t>& fragSrc);
+		[[nodiscard]] static std::optional<Reflection> loadCachedReflection(uint64_t sourceHash);
+		static void saveCachedReflection(uint64_t sourceHash, const Reflection& reflection);
+
 		vk::Device m_device;
 	};
 }  // namespace MRG
@@ -0,0 +1,74 @@
+#include "StagingRingBuffer.h"
+
+#include <cstring>
+
+namespace MRG
+{
+	// CPU only memory is always host coherent, so the buffer can stay mapped for its whole lifetime without any flush
+	StagingRingBuffer::StagingRingBuffer(VmaAllocator allocator, std::size_t capacity)
+	    : m_buffer{allocator, capacity, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT},
+	      m_mappedData{static_cast<std::byte*>(m_buffer.mappedData)},
+	      m_capacity{capacity}
+	{}
+
+	std::optional<StagingAllocation> StagingRingBuffer::push(std::span<const std::byte> data, vk::DeviceSize alignment)
+	{
+		const auto size         = data.size();
+		const auto rawAlignment = static_cast<std::size_t>(alignment);
+		if (size > m_capacity - m_usedSize) { return std::nullopt; }
+		if (m_usedSize == 0) {
+			m_head = 0;
+			m_tail = 0;
+		}
+
+		auto offset = (m_tail + rawAlignment - 1) / rawAlignment * rawAlignment;
+		std::size_t consumedSize;
+		if (m_tail >= m_head) {
+			// Free space is [tail, capacity) followed by [0, head)
+			if (offset + size <= m_capacity) {
+				consumedSize = offset - m_tail + size;
+			} else if (size <= m_head) {
+				offset       = 0;
+				consumedSize = m_capacity - m_tail + size;
+			} else {
+				return std::nullopt;
+			}
+		} else {
+			// Free space is [tail, head)
+			if (offset + size > m_head) { return std::nullopt; }
+			consumedSize = offset - m_tail + size;
+		}
+
+		memcpy(m_mappedData + offset, data.data(), size);
+
+		m_tail = offset + size;
+		m_usedSize += consumedSize;
+		m_openRegionSize += consumedSize;
+
+		return StagingAllocation{
+		  .buffer = m_buffer.vkHandle,
+		  .offset = offset,
+		};
+	}
+
+	void StagingRingBuffer::closeRegion(uint64_t batchID)
+	{
+		if (m_openRegionSize == 0) { return; }
+
+		m_regions.push_back(Region{
+		  .batchID = batchID,
+		  .end     = m_tail,
+		  .size    = m_openRegionSize,
+		});
+		m_openRegionSize = 0;
+	}
+
+	void StagingRingBuffer::release(uint64_t completedBatchID)
+	{
+		while (!m_regions.empty() && m_regions.front().batchID <= completedBatchID) {
+			m_head = m_regions.front().end;
+			m_usedSize -= m_regions.front().size;
+			m_regions.pop_front();
+		}
+	}
+}  // namespace MRG
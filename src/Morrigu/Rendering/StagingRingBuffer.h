@@ -0,0 +1,66 @@
+#ifndef MORRIGU_STAGINGRINGBUFFER_H
+#define MORRIGU_STAGINGRINGBUFFER_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <deque>
+#include <optional>
+#include <span>
+
+namespace MRG
+{
+	struct StagingAllocation
+	{
+		vk::Buffer buffer;
+		vk::DeviceSize offset;
+	};
+
+	// A single persistently mapped CPU buffer that staging data is sub-allocated from, in a FIFO way.
+	// Allocations are grouped into regions, each tagged with the id of the upload batch using it. Regions are then reclaimed in order
+	// once their batch is known to be complete.
+	class StagingRingBuffer
+	{
+	public:
+		StagingRingBuffer(VmaAllocator allocator, std::size_t capacity);
+		StagingRingBuffer(const StagingRingBuffer&) = delete;
+		StagingRingBuffer(StagingRingBuffer&&)      = delete;
+		~StagingRingBuffer() = default;
+
+		StagingRingBuffer& operator=(const StagingRingBuffer&) = delete;
+		StagingRingBuffer& operator=(StagingRingBuffer&&) = delete;
+
+		// Copies the data into the ring, returns an empty optional if there is not enough free space left
+		[[nodiscard]] std::optional<StagingAllocation> push(std::span<const std::byte> data, vk::DeviceSize alignment);
+
+		// Tags every allocation made since the last call with the given batch id
+		void closeRegion(uint64_t batchID);
+		// Reclaims the space of every region whose batch id is lower or equal to the given one
+		void release(uint64_t completedBatchID);
+
+		[[nodiscard]] std::size_t getCapacity() const { return m_capacity; }
+		[[nodiscard]] std::size_t getUsedSize() const { return m_usedSize; }
+
+	private:
+		struct Region
+		{
+			uint64_t batchID;
+			std::size_t end;
+			std::size_t size;
+		};
+
+		AllocatedBuffer m_buffer;
+		std::byte* m_mappedData{nullptr};
+		std::size_t m_capacity;
+
+		// Oldest byte still in use, and where the next allocation starts
+		std::size_t m_head{0};
+		std::size_t m_tail{0};
+		// Includes alignment padding and the space lost at the end of the buffer when wrapping around
+		std::size_t m_usedSize{0};
+
+		std::size_t m_openRegionSize{0};
+		std::deque<Region> m_regions{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_STAGINGRINGBUFFER_H
@@ -6,67 +6,100 @@
 
 #include "Core/FileNames.h"
 #include "Rendering/RendererTypes.h"
+#include "Utils/Textures.h"
 #include "Vendor/ImGui/bindings/imgui_impl_vulkan.h"
 
 namespace MRG
 {
-	Texture::Texture(
-	  vk::Device device, vk::Queue graphicsQueue, UploadContext uploadContext, VmaAllocator allocator, const std::string& file)
-	    : path{file}, m_device{device}
+	Texture::Texture(vk::Device device,
+	                 UploadQueue& uploadQueue,
+	                 VmaAllocator allocator,
+	                 const std::string& file,
+	                 bool useCookedTexture,
+	                 vk::Sampler textureSampler)
+	    : path{file}, sampler{textureSampler}
 	{
-		image = AllocatedImage{AllocatedImageSpecification{
-		  .device        = device,
-		  .graphicsQueue = graphicsQueue,
-		  .uploadContext = uploadContext,
-		  .allocator     = allocator,
-		  .usage         = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
-		  .file          = (Folders::Rendering::texturesFolder + file).c_str(),
-		}};
+		std::optional<Utils::Textures::CookedTexture> cookedTexture{};
+		if (useCookedTexture) { cookedTexture = Utils::Textures::loadCookedTexture(file.c_str()); }
 
-		vk::SamplerCreateInfo samplerInfo{
-		  .magFilter    = vk::Filter::eNearest,
-		  .minFilter    = vk::Filter::eNearest,
-		  .addressModeU = vk::SamplerAddressMode::eRepeat,
-		  .addressModeV = vk::SamplerAddressMode::eRepeat,
-		  .addressModeW = vk::SamplerAddressMode::eRepeat,
-		};
-		sampler = device.createSampler(samplerInfo);
+		if (cookedTexture.has_value()) {
+			image = AllocatedImage{AllocatedImageSpecification{
+			  .device      = device,
+			  .uploadQueue = &uploadQueue,
+			  .allocator   = allocator,
+			  .usage       = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+			  .format      = cookedTexture->format,
+			  .levelData   = cookedTexture->file.getData(),
+			  .levels      = cookedTexture->levels,
+			}};
+		} else {
+			image = AllocatedImage{AllocatedImageSpecification{
+			  .device       = device,
+			  .uploadQueue  = &uploadQueue,
+			  .allocator    = allocator,
+			  .usage        = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+			  .file         = (Folders::Rendering::texturesFolder + file).c_str(),
+			  .generateMips = true,
+			}};
+		}
 	}
 
 	Texture::Texture(vk::Device device,
-	                 vk::Queue graphicsQueue,
-	                 UploadContext uploadContext,
+	                 UploadQueue& uploadQueue,
 	                 VmaAllocator allocator,
 	                 void* data,
 	                 uint32_t width,
-	                 uint32_t height)
-	    : m_device{device}
+	                 uint32_t height,
+	                 vk::Sampler textureSampler)
+	    : sampler{textureSampler}
+	{
+		image = AllocatedImage{AllocatedImageSpecification{
+		  .device      = device,
+		  .uploadQueue = &uploadQueue,
+		  .allocator   = allocator,
+		  .usage       = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+		  .data        = data,
+		  .width       = width,
+		  .height      = height,
+		}};
+	}
+
+	Texture::Texture(const std::string& file, Ref<Texture> placeholder, vk::Sampler textureSampler)
+	    : path{file}, sampler{textureSampler}, m_placeholder{std::move(placeholder)}
+	{
+		MRG_ENGINE_ASSERT(m_placeholder != nullptr && m_placeholder->isLoaded(), "Invalid texture placeholder!")
+	}
+
+	Texture::Texture(vk::Device device,
+	                 UploadQueue& uploadQueue,
+	                 VmaAllocator allocator,
+	                 const std::string& file,
+	                 TextureStreamingState streamingState,
+	                 vk::Sampler textureSampler)
+	    : path{file}, sampler{textureSampler}, m_streamingState{createScope<TextureStreamingState>(std::move(streamingState))}
 	{
 		image = AllocatedImage{AllocatedImageSpecification{
 		  .device        = device,
-		  .graphicsQueue = graphicsQueue,
-		  .uploadContext = uploadContext,
+		  .uploadQueue   = &uploadQueue,
 		  .allocator     = allocator,
 		  .usage         = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
-		  .data          = data,
-		  .width         = width,
-		  .height        = height,
+		  .format        = m_streamingState->format,
+		  .levelData     = m_streamingState->mipChain.data,
+		  .levels        = m_streamingState->mipChain.levels,
+		  .firstMipLevel = m_streamingState->residentMip,
 		}};
-
-		vk::SamplerCreateInfo samplerInfo{
-		  .magFilter    = vk::Filter::eNearest,
-		  .minFilter    = vk::Filter::eNearest,
-		  .addressModeU = vk::SamplerAddressMode::eClampToEdge,
-		  .addressModeV = vk::SamplerAddressMode::eClampToEdge,
-		  .addressModeW = vk::SamplerAddressMode::eClampToEdge,
-		};
-		sampler = device.createSampler(samplerInfo);
 	}
 
-	Texture::~Texture() { m_device.destroySampler(sampler); }
+	Texture::~Texture()
+	{
+		if (m_textureTable != nullptr) { m_textureTable->release(m_bindlessIndex, std::move(image)); }
+	}
 
 	ImTextureID Texture::getImTexID()
 	{
+		MRG_ENGINE_ASSERT(!isStreamed(), "Streamed textures cannot be displayed with ImGui, as their image view changes!")
+		if (!isLoaded()) { return m_placeholder->getImTexID(); }
+
 		if (m_imTexID == nullptr) {
 			m_imTexID = ImGui_ImplVulkan_AddTexture(sampler, image.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		}
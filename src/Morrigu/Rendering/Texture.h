@@ -5,36 +5,93 @@
 #ifndef MORRIGU_TEXTURE_H
 #define MORRIGU_TEXTURE_H
 
+#include "Rendering/MipChain.h"
 #include "Rendering/RendererTypes.h"
+#include "Rendering/TextureTable.h"
 
 #include <imgui.h>
 
 namespace MRG
 {
+	// Everything needed to change the mip levels a streamed texture holds in VRAM (see TextureStreamer)
+	struct TextureStreamingState
+	{
+		// Levels of the chain are in this format
+		vk::Format format;
+		MipChain mipChain;
+		// First mip level held by the image, which also holds every smaller level
+		uint32_t residentMip;
+		// The image always holds at least the levels from this one on
+		uint32_t minResidentMip;
+		// Biggest size the texture was drawn at on screen during lastRequestFrame, in pixels
+		float requestedSize{0.f};
+		uint64_t lastRequestFrame{0};
+	};
+
 	class Texture
 	{
 	public:
-		Texture(vk::Device device, vk::Queue graphicsQueue, UploadContext uploadContext, VmaAllocator allocator, const std::string& file);
+		// Files get their whole mip chain, straight from their cooked version when allowed and when there is one (see
+		// Utils::Textures::loadCookedTexture)
 		Texture(vk::Device device,
-		        vk::Queue graphicsQueue,
-		        UploadContext uploadContext,
+		        UploadQueue& uploadQueue,
+		        VmaAllocator allocator,
+		        const std::string& file,
+		        bool useCookedTexture,
+		        vk::Sampler textureSampler);
+		Texture(vk::Device device,
+		        UploadQueue& uploadQueue,
 		        VmaAllocator allocator,
 		        void* data,
 		        uint32_t width,
-		        uint32_t height);
+		        uint32_t height,
+		        vk::Sampler textureSampler);
+		// Texture sampling the placeholder until TextureLoader gives it its image
+		Texture(const std::string& file, Ref<Texture> placeholder, vk::Sampler textureSampler);
+		// Streamed texture, starting with the levels of the mip chain from streamingState.residentMip on
+		Texture(vk::Device device,
+		        UploadQueue& uploadQueue,
+		        VmaAllocator allocator,
+		        const std::string& file,
+		        TextureStreamingState streamingState,
+		        vk::Sampler textureSampler);
 
+		Texture(const Texture&) = delete;
+		Texture(Texture&&)      = delete;
 		~Texture();
 
+		Texture& operator=(const Texture&) = delete;
+		Texture& operator=(Texture&&) = delete;
+
+		// Not available for streamed textures. Textures still loading display their placeholder.
 		[[nodiscard]] ImTextureID getImTexID();
+		// Index of the texture in the renderer's texture table (see TextureTable). Textures created by the renderer are always part of it.
+		[[nodiscard]] uint32_t getBindlessIndex() const { return m_bindlessIndex; }
+		// The image of streamed textures is replaced whenever their resident mip levels change, so they can only be sampled through the
+		// texture table
+		[[nodiscard]] bool isStreamed() const { return m_streamingState != nullptr; }
+		// Textures still loading have no image yet, so they can only be sampled through the texture table, which points their slot to
+		// their placeholder
+		[[nodiscard]] bool isLoaded() const { return m_placeholder == nullptr; }
 
 		std::string path{};
 
 		AllocatedImage image;
+		// Owned by the renderer's sampler cache (see SamplerCache), and possibly shared with other textures
 		vk::Sampler sampler;
 
 	private:
-		vk::Device m_device;
+		friend class TextureLoader;
+		friend class TextureStreamer;
+		friend class TextureTable;
+
 		ImTextureID m_imTexID{nullptr};
+
+		Ref<TextureTable> m_textureTable{};
+		uint32_t m_bindlessIndex{0};
+
+		Scope<TextureStreamingState> m_streamingState{};
+		Ref<Texture> m_placeholder{};
 	};
 }  // namespace MRG
 
@@ -0,0 +1,81 @@
+#include "TextureLoader.h"
+
+#include "Core/FileNames.h"
+
+namespace MRG
+{
+	TextureLoader::TextureLoader(vk::Device device, UploadQueue& uploadQueue, VmaAllocator allocator, bool useCookedTextures)
+	    : m_device{device}, m_uploadQueue{uploadQueue}, m_allocator{allocator}, m_useCookedTextures{useCookedTextures}
+	{}
+
+	TextureLoader::~TextureLoader()
+	{
+		for (const auto& request : m_requests) {
+			try {
+				Jobs::wait(request->decoding);
+			} catch (const std::exception& exception) {
+				MRG_ENGINE_ERROR("Failed to load texture \"{}\": {}", request->file, exception.what())
+			}
+		}
+	}
+
+	Ref<Texture> TextureLoader::loadTexture(const std::string& file, const Ref<Texture>& placeholder, vk::Sampler sampler)
+	{
+		auto texture = createRef<Texture>(file, placeholder, sampler);
+
+		auto request     = createScope<Request>();
+		request->texture = texture;
+		request->file    = file;
+		Jobs::run(
+		  [request = request.get(), useCookedTexture = m_useCookedTextures]() {
+			  if (useCookedTexture) { request->cookedTexture = Utils::Textures::loadCookedTexture(request->file.c_str()); }
+			  if (!request->cookedTexture.has_value()) {
+				  request->mipChain = loadMipChain((Folders::Rendering::texturesFolder + request->file).c_str(), true);
+			  }
+		  },
+		  &request->decoding);
+		m_requests.push_back(std::move(request));
+
+		return texture;
+	}
+
+	void TextureLoader::update()
+	{
+		for (auto& request : m_requests) {
+			if (!request->decoding.isDone()) { continue; }
+
+			try {
+				// Only rethrows the exception of the decoding job, if there was one
+				Jobs::wait(request->decoding);
+				// Textures destroyed in the meantime are not uploaded at all
+				if (auto texture = request->texture.lock()) { uploadTexture(*texture, *request); }
+			} catch (const std::exception& exception) {
+				MRG_ENGINE_ERROR("Failed to load texture \"{}\": {}", request->file, exception.what())
+			}
+			request.reset();
+		}
+		std::erase(m_requests, nullptr);
+	}
+
+	void TextureLoader::uploadTexture(Texture& texture, const Request& request)
+	{
+		AllocatedImageSpecification imageSpec{
+		  .device      = m_device,
+		  .uploadQueue = &m_uploadQueue,
+		  .allocator   = m_allocator,
+		  .usage       = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+		};
+		if (request.cookedTexture.has_value()) {
+			imageSpec.format    = request.cookedTexture->format;
+			imageSpec.levelData = request.cookedTexture->file.getData();
+			imageSpec.levels    = request.cookedTexture->levels;
+		} else {
+			imageSpec.levelData = request.mipChain.data;
+			imageSpec.levels    = request.mipChain.levels;
+		}
+		texture.image = AllocatedImage{imageSpec};
+
+		texture.m_placeholder.reset();
+		if (texture.m_textureTable != nullptr) { texture.m_textureTable->update(texture); }
+	}
+}  // namespace MRG
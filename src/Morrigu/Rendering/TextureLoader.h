@@ -0,0 +1,66 @@
+#ifndef MORRIGU_TEXTURELOADER_H
+#define MORRIGU_TEXTURELOADER_H
+
+#include "Core/Jobs.h"
+#include "Rendering/MipChain.h"
+#include "Rendering/Texture.h"
+#include "Rendering/UploadQueue.h"
+#include "Utils/Textures.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MRG
+{
+	// Decodes texture files on the job system threads, so that loading many of them (when opening a scene for example) scales with the
+	// number of cores instead of decoding them one after the other. Decoded textures are then handed to the upload queue all at once
+	// when updating, and sample their placeholder until then.
+	// This class is not thread safe, but the decoding jobs do not touch anything outside of their own request.
+	class TextureLoader
+	{
+	public:
+		TextureLoader(vk::Device device, UploadQueue& uploadQueue, VmaAllocator allocator, bool useCookedTextures);
+		TextureLoader(const TextureLoader&) = delete;
+		TextureLoader(TextureLoader&&)      = delete;
+		// Waits for the decoding jobs still running
+		~TextureLoader();
+
+		TextureLoader& operator=(const TextureLoader&) = delete;
+		TextureLoader& operator=(TextureLoader&&) = delete;
+
+		// The texture still has to be added to the texture table, which points its slot to the placeholder until the texture is loaded.
+		// Frames in flight can still sample the placeholder afterwards, so it has to outlive them (like the default texture does). The
+		// cooked version of the texture is used when allowed and when there is one.
+		[[nodiscard]] Ref<Texture> loadTexture(const std::string& file, const Ref<Texture>& placeholder, vk::Sampler sampler);
+
+		// Uploads every texture decoded since the last update. Must be called once per frame, before the uploads are flushed.
+		void update();
+
+		[[nodiscard]] std::size_t getPendingCount() const { return m_requests.size(); }
+
+	private:
+		struct Request
+		{
+			std::weak_ptr<Texture> texture;
+			std::string file;
+			JobCounter decoding{};
+
+			// Written by the decoding job, and only read once it is done
+			std::optional<Utils::Textures::CookedTexture> cookedTexture{};
+			MipChain mipChain{};
+		};
+
+		void uploadTexture(Texture& texture, const Request& request);
+
+		vk::Device m_device;
+		UploadQueue& m_uploadQueue;
+		VmaAllocator m_allocator;
+		bool m_useCookedTextures;
+
+		std::vector<Scope<Request>> m_requests{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_TEXTURELOADER_H
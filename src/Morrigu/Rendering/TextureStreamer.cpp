@@ -0,0 +1,209 @@
+#include "TextureStreamer.h"
+
+#include "Core/FileNames.h"
+#include "Utils/Textures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace
+{
+	// Cooked files store the smallest levels first, while chains go from the biggest to the smallest one
+	[[nodiscard]] MRG::MipChain copyMipChain(const MRG::Utils::Textures::CookedTexture& cookedTexture)
+	{
+		const auto fileData = cookedTexture.file.getData();
+
+		MRG::MipChain chain{};
+		for (const auto& level : cookedTexture.levels) {
+			chain.levels.push_back(MRG::MipLevel{
+			  .width  = level.width,
+			  .height = level.height,
+			  .offset = chain.data.size(),
+			  .size   = level.size,
+			});
+			const auto levelData = fileData.subspan(level.offset, level.size);
+			chain.data.insert(chain.data.end(), levelData.begin(), levelData.end());
+		}
+
+		return chain;
+	}
+}  // namespace
+
+namespace MRG
+{
+	TextureStreamer::TextureStreamer(vk::Device device,
+	                                 UploadQueue& uploadQueue,
+	                                 VmaAllocator allocator,
+	                                 std::size_t budget,
+	                                 std::size_t maxBytesPerUpdate,
+	                                 uint32_t framesInFlight,
+	                                 bool useCookedTextures)
+	    : m_device{device},
+	      m_uploadQueue{uploadQueue},
+	      m_allocator{allocator},
+	      m_budget{budget},
+	      m_maxBytesPerUpdate{maxBytesPerUpdate},
+	      m_framesInFlight{framesInFlight},
+	      m_useCookedTextures{useCookedTextures}
+	{
+		m_statistics.budget = m_budget;
+	}
+
+	Ref<Texture> TextureStreamer::createTexture(const std::string& file, vk::Sampler sampler)
+	{
+		std::optional<Utils::Textures::CookedTexture> cookedTexture{};
+		if (m_useCookedTextures) { cookedTexture = Utils::Textures::loadCookedTexture(file.c_str()); }
+
+		MipChain mipChain{};
+		auto format = vk::Format::eR8G8B8A8Srgb;
+		if (cookedTexture.has_value()) {
+			// Cooked levels are copied out of the file, as the chain has to outlive its mapping
+			mipChain = copyMipChain(cookedTexture.value());
+			format   = cookedTexture->format;
+		} else {
+			mipChain = loadMipChain((Folders::Rendering::texturesFolder + file).c_str(), true);
+		}
+
+		uint32_t minResidentMip = 0;
+		while (minResidentMip + 1 < mipChain.getLevelCount() &&
+		       std::max(mipChain.levels[minResidentMip].width, mipChain.levels[minResidentMip].height) > minResidentSize) {
+			++minResidentMip;
+		}
+
+		auto texture = createRef<Texture>(m_device,
+		                                  m_uploadQueue,
+		                                  m_allocator,
+		                                  file,
+		                                  TextureStreamingState{
+		                                    .format         = format,
+		                                    .mipChain       = std::move(mipChain),
+		                                    .residentMip    = minResidentMip,
+		                                    .minResidentMip = minResidentMip,
+		                                  },
+		                                  sampler);
+		m_textures.push_back(texture);
+		return texture;
+	}
+
+	void TextureStreamer::requestSize(const Texture& texture, float screenSize) const
+	{
+		if (!texture.isStreamed()) { return; }
+
+		auto& state = *texture.m_streamingState;
+		if (state.lastRequestFrame != m_frame) {
+			state.requestedSize    = 0.f;
+			state.lastRequestFrame = m_frame;
+		}
+		state.requestedSize = std::max(state.requestedSize, screenSize);
+	}
+
+	void TextureStreamer::update()
+	{
+		// Frames that could still use an image retired before are all complete by now
+		std::erase_if(m_retiredImages,
+		              [this](const RetiredImage& retiredImage) { return retiredImage.frame + m_framesInFlight <= m_frame; });
+		std::erase_if(m_textures, [](const std::weak_ptr<Texture>& texture) { return texture.expired(); });
+
+		m_statistics.streamedTextures = m_textures.size();
+		m_statistics.uploadedBytes    = 0;
+		m_statistics.refinements      = 0;
+		m_statistics.evictions        = 0;
+
+		// Textures drawn since the last update and wanting more levels, and the ones that were not drawn but hold more than their
+		// smallest levels
+		std::vector<Ref<Texture>> refinable{};
+		std::vector<Ref<Texture>> evictable{};
+		std::size_t residentBytes = 0;
+		for (const auto& weakTexture : m_textures) {
+			auto texture      = weakTexture.lock();
+			const auto& state = *texture->m_streamingState;
+			residentBytes += state.mipChain.getSize(state.residentMip);
+
+			if (state.lastRequestFrame == m_frame) {
+				if (getWantedMip(state) < state.residentMip) { refinable.push_back(std::move(texture)); }
+			} else if (state.residentMip < state.minResidentMip) {
+				evictable.push_back(std::move(texture));
+			}
+		}
+		// Biggest on screen first, and least recently drawn at the back of the eviction list
+		std::ranges::sort(refinable, std::ranges::greater{}, [](const Ref<Texture>& texture) {
+			return texture->m_streamingState->requestedSize;
+		});
+		std::ranges::sort(evictable, std::ranges::greater{}, [](const Ref<Texture>& texture) {
+			return texture->m_streamingState->lastRequestFrame;
+		});
+
+		for (const auto& texture : refinable) {
+			const auto& state      = *texture->m_streamingState;
+			const auto currentSize = state.mipChain.getSize(state.residentMip);
+			auto wantedMip         = getWantedMip(state);
+			// At least one texture is refined per update, however big it is
+			if (m_statistics.uploadedBytes > 0 && m_statistics.uploadedBytes + state.mipChain.getSize(wantedMip) > m_maxBytesPerUpdate) {
+				break;
+			}
+
+			while (residentBytes - currentSize + state.mipChain.getSize(wantedMip) > m_budget && !evictable.empty()) {
+				auto& evicted            = *evictable.back();
+				const auto& evictedState = *evicted.m_streamingState;
+				const auto minimumSize   = evictedState.mipChain.getSize(evictedState.minResidentMip);
+				residentBytes -= evictedState.mipChain.getSize(evictedState.residentMip) - minimumSize;
+				m_statistics.uploadedBytes += minimumSize;
+				setResidentMip(evicted, evictedState.minResidentMip);
+				evictable.pop_back();
+				++m_statistics.evictions;
+			}
+			// Without anything left to evict, the texture gets as many levels as the budget allows
+			while (wantedMip < state.residentMip && residentBytes - currentSize + state.mipChain.getSize(wantedMip) > m_budget) {
+				++wantedMip;
+			}
+			if (wantedMip == state.residentMip) { continue; }
+
+			const auto wantedSize = state.mipChain.getSize(wantedMip);
+			residentBytes += wantedSize - currentSize;
+			m_statistics.uploadedBytes += wantedSize;
+			setResidentMip(*texture, wantedMip);
+			++m_statistics.refinements;
+		}
+
+		m_statistics.residentBytes = residentBytes;
+		++m_frame;
+	}
+
+	void TextureStreamer::setResidentMip(Texture& texture, uint32_t residentMip)
+	{
+		auto& state = *texture.m_streamingState;
+		AllocatedImage newImage{AllocatedImageSpecification{
+		  .device        = m_device,
+		  .uploadQueue   = &m_uploadQueue,
+		  .allocator     = m_allocator,
+		  .usage         = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+		  .format        = state.format,
+		  .levelData     = state.mipChain.data,
+		  .levels        = state.mipChain.levels,
+		  .firstMipLevel = residentMip,
+		}};
+		m_retiredImages.push_back(RetiredImage{
+		  .image = std::exchange(texture.image, std::move(newImage)),
+		  .frame = m_frame,
+		});
+		state.residentMip = residentMip;
+
+		if (texture.m_textureTable != nullptr) { texture.m_textureTable->update(texture); }
+	}
+
+	uint32_t TextureStreamer::getWantedMip(const TextureStreamingState& state)
+	{
+		if (state.requestedSize <= 0.f) { return state.minResidentMip; }
+
+		// Each level halves the size of the previous one, and the level used is the smallest one still bigger than the requested size
+		const auto& baseLevel = state.mipChain.levels.front();
+		const auto baseSize   = static_cast<float>(std::max(baseLevel.width, baseLevel.height));
+		const auto mip        = std::floor(std::log2(baseSize / state.requestedSize));
+		if (mip <= 0.f) { return 0; }
+
+		return std::min(static_cast<uint32_t>(mip), state.minResidentMip);
+	}
+}  // namespace MRG
@@ -0,0 +1,91 @@
+#ifndef MORRIGU_TEXTURESTREAMER_H
+#define MORRIGU_TEXTURESTREAMER_H
+
+#include "Rendering/RendererTypes.h"
+#include "Rendering/Texture.h"
+#include "Rendering/UploadQueue.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MRG
+{
+	struct TextureStreamingStatistics
+	{
+		std::size_t residentBytes{0};
+		std::size_t budget{0};
+		std::size_t streamedTextures{0};
+		// Since the last update
+		std::size_t uploadedBytes{0};
+		uint32_t refinements{0};
+		uint32_t evictions{0};
+	};
+
+	// Keeps the full mip chain of streamed textures on the CPU, and only their smallest levels in VRAM to begin with. Textures are then
+	// refined up to the level matching the biggest size they are drawn at on screen, as long as the VRAM budget allows it. When it does
+	// not, the least recently drawn textures are evicted back to their smallest levels first.
+	// Changing the resident levels of a texture replaces its image, so streamed textures can only be sampled through the texture table.
+	// This class is not thread safe.
+	class TextureStreamer
+	{
+	public:
+		// Levels up to this size are always resident
+		static constexpr uint32_t minResidentSize = 64;
+
+		TextureStreamer(vk::Device device,
+		                UploadQueue& uploadQueue,
+		                VmaAllocator allocator,
+		                std::size_t budget,
+		                std::size_t maxBytesPerUpdate,
+		                uint32_t framesInFlight,
+		                bool useCookedTextures);
+		TextureStreamer(const TextureStreamer&) = delete;
+		TextureStreamer(TextureStreamer&&)      = delete;
+		~TextureStreamer() = default;
+
+		TextureStreamer& operator=(const TextureStreamer&) = delete;
+		TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+		// The texture still has to be added to the texture table. Its cooked version is used when allowed and when there is one.
+		[[nodiscard]] Ref<Texture> createTexture(const std::string& file, vk::Sampler sampler);
+
+		// Called for every texture drawn during the frame, with the size of what it is drawn on, in pixels. Does nothing for textures that
+		// are not streamed.
+		void requestSize(const Texture& texture, float screenSize) const;
+
+		// Refines and evicts textures according to the sizes requested since the last update, and uploads at most maxBytesPerUpdate bytes.
+		// Must be called once per frame, before the uploads are flushed.
+		void update();
+
+		[[nodiscard]] bool hasTextures() const { return !m_textures.empty(); }
+		[[nodiscard]] const TextureStreamingStatistics& getStatistics() const { return m_statistics; }
+
+	private:
+		struct RetiredImage
+		{
+			AllocatedImage image;
+			uint64_t frame;
+		};
+
+		// Replaces the image of the texture with one holding the levels from residentMip on
+		void setResidentMip(Texture& texture, uint32_t residentMip);
+		[[nodiscard]] static uint32_t getWantedMip(const TextureStreamingState& state);
+
+		vk::Device m_device;
+		UploadQueue& m_uploadQueue;
+		VmaAllocator m_allocator;
+		std::size_t m_budget;
+		std::size_t m_maxBytesPerUpdate;
+		uint32_t m_framesInFlight;
+		bool m_useCookedTextures;
+
+		uint64_t m_frame{1};
+		std::vector<std::weak_ptr<Texture>> m_textures{};
+		// Replaced images, destroyed once no frame in flight can use them anymore
+		std::vector<RetiredImage> m_retiredImages{};
+		TextureStreamingStatistics m_statistics{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_TEXTURESTREAMER_H
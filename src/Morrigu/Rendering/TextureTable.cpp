@@ -0,0 +1,158 @@
+#include "TextureTable.h"
+
+#include "Rendering/Texture.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace MRG
+{
+	TextureTable::TextureTable(vk::Device device, uint32_t capacity, uint32_t framesInFlight)
+	    : m_device{device}, m_capacity{capacity}, m_framesInFlight{framesInFlight}, m_pendingWrites(framesInFlight)
+	{
+		const vk::DescriptorSetLayoutBinding binding{
+		  .binding         = 0,
+		  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
+		  .descriptorCount = m_capacity,
+		  .stageFlags      = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+		};
+		const vk::DescriptorBindingFlags bindingFlags =
+		  vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+		const vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{
+		  .bindingCount  = 1,
+		  .pBindingFlags = &bindingFlags,
+		};
+		const vk::DescriptorSetLayoutCreateInfo setInfo{
+		  .pNext        = &bindingFlagsInfo,
+		  .flags        = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+		  .bindingCount = 1,
+		  .pBindings    = &binding,
+		};
+		m_layout = m_device.createDescriptorSetLayout(setInfo);
+
+		const vk::DescriptorPoolSize poolSize{vk::DescriptorType::eCombinedImageSampler, m_capacity * framesInFlight};
+		const vk::DescriptorPoolCreateInfo poolInfo{
+		  .flags         = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+		  .maxSets       = framesInFlight,
+		  .poolSizeCount = 1,
+		  .pPoolSizes    = &poolSize,
+		};
+		m_descriptorPool = m_device.createDescriptorPool(poolInfo);
+
+		const std::vector<vk::DescriptorSetLayout> setLayouts(framesInFlight, m_layout);
+		const vk::DescriptorSetAllocateInfo allocInfo{
+		  .descriptorPool     = m_descriptorPool,
+		  .descriptorSetCount = framesInFlight,
+		  .pSetLayouts        = setLayouts.data(),
+		};
+		m_descriptorSets = m_device.allocateDescriptorSets(allocInfo);
+	}
+
+	TextureTable::~TextureTable()
+	{
+		m_device.destroyDescriptorPool(m_descriptorPool);
+		m_device.destroyDescriptorSetLayout(m_layout);
+	}
+
+	void TextureTable::add(Texture& texture)
+	{
+		MRG_ENGINE_ASSERT(texture.m_textureTable == nullptr, "This texture is already part of a texture table!")
+
+		std::lock_guard lock{m_mutex};
+		uint32_t index = 0;
+		if (!m_freeIndices.empty()) {
+			index = m_freeIndices.back();
+			m_freeIndices.pop_back();
+		} else {
+			if (m_nextIndex == m_capacity) {
+				throw std::runtime_error(fmt::format("Texture table is full ({} textures)!", m_capacity));
+			}
+			index = m_nextIndex++;
+		}
+
+		write(SlotWrite{index, texture.sampler, getSampledView(texture)});
+
+		texture.m_textureTable  = shared_from_this();
+		texture.m_bindlessIndex = index;
+	}
+
+	void TextureTable::update(const Texture& texture)
+	{
+		MRG_ENGINE_ASSERT(texture.m_textureTable.get() == this, "This texture is not part of this texture table!")
+
+		std::lock_guard lock{m_mutex};
+		write(SlotWrite{texture.m_bindlessIndex, texture.sampler, getSampledView(texture)});
+	}
+
+	void TextureTable::beginFrame(uint32_t frameIndex)
+	{
+		std::lock_guard lock{m_mutex};
+		m_currentFrame = frameIndex;
+		++m_frame;
+
+		// Frames that could still sample a slot retired before are all complete by now
+		const auto reclaimedSlots = std::ranges::partition(
+		  m_retiredSlots, [this](const RetiredSlot& retiredSlot) { return retiredSlot.frame + m_framesInFlight > m_frame; });
+		for (const auto& retiredSlot : reclaimedSlots) { m_freeIndices.push_back(retiredSlot.index); }
+		m_retiredSlots.erase(reclaimedSlots.begin(), reclaimedSlots.end());
+
+		for (const auto& slotWrite : m_pendingWrites[frameIndex]) { applyWrite(m_descriptorSets[frameIndex], slotWrite); }
+		m_pendingWrites[frameIndex].clear();
+	}
+
+	void TextureTable::endFrame()
+	{
+		std::lock_guard lock{m_mutex};
+		m_currentFrame.reset();
+	}
+
+	// The descriptor is left as is: partially bound slots are never read as long as no shader is given their index. Pending writes are
+	// dropped though, as their image view might be destroyed before they are applied.
+	void TextureTable::release(uint32_t index, AllocatedImage image)
+	{
+		std::lock_guard lock{m_mutex};
+		for (auto& pendingWrites : m_pendingWrites) {
+			std::erase_if(pendingWrites, [index](const SlotWrite& slotWrite) { return slotWrite.index == index; });
+		}
+		m_retiredSlots.push_back(RetiredSlot{
+		  .index = index,
+		  .image = std::move(image),
+		  .frame = m_frame,
+		});
+	}
+
+	vk::ImageView TextureTable::getSampledView(const Texture& texture)
+	{
+		return texture.isLoaded() ? texture.image.view : texture.m_placeholder->image.view;
+	}
+
+	void TextureTable::write(const SlotWrite& slotWrite)
+	{
+		for (uint32_t frameIndex = 0; frameIndex < m_descriptorSets.size(); ++frameIndex) {
+			if (frameIndex == m_currentFrame) {
+				applyWrite(m_descriptorSets[frameIndex], slotWrite);
+			} else {
+				m_pendingWrites[frameIndex].push_back(slotWrite);
+			}
+		}
+	}
+
+	void TextureTable::applyWrite(vk::DescriptorSet descriptorSet, const SlotWrite& slotWrite) const
+	{
+		const vk::DescriptorImageInfo imageInfo{
+		  .sampler     = slotWrite.sampler,
+		  .imageView   = slotWrite.view,
+		  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+		};
+		const vk::WriteDescriptorSet setWrite{
+		  .dstSet          = descriptorSet,
+		  .dstBinding      = 0,
+		  .dstArrayElement = slotWrite.index,
+		  .descriptorCount = 1,
+		  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
+		  .pImageInfo      = &imageInfo,
+		};
+		m_device.updateDescriptorSets(setWrite, {});
+	}
+}  // namespace MRG
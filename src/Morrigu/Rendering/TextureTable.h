@@ -0,0 +1,97 @@
+#ifndef MORRIGU_TEXTURETABLE_H
+#define MORRIGU_TEXTURETABLE_H
+
+#include "Rendering/RendererTypes.h"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace MRG
+{
+	class Texture;
+
+	// Global array of every texture created by the renderer, bound once per command buffer as descriptor set 1:
+	//     layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+	// Shaders sample it with the index of a texture (Texture::getBindlessIndex), which materials and mesh renderers write into their
+	// uniform data instead of binding a descriptor per texture. Relies on descriptor indexing: the set is updated after being bound,
+	// and the slots not used by any texture are left unwritten.
+	// There is one set per frame in flight, so that a slot can be rewritten while the previous frames still read it: writes go to the
+	// set of the frame being recorded right away, and to the other sets when their frame begins (once the GPU is done with them).
+	// Can be used from any thread.
+	class TextureTable : public std::enable_shared_from_this<TextureTable>
+	{
+	public:
+		TextureTable(vk::Device device, uint32_t capacity, uint32_t framesInFlight);
+		TextureTable(const TextureTable&) = delete;
+		TextureTable(TextureTable&&)      = delete;
+		~TextureTable();
+
+		TextureTable& operator=(const TextureTable&) = delete;
+		TextureTable& operator=(TextureTable&&) = delete;
+
+		// Writes the texture to a free slot, and gives it its index. The slot is freed when the texture is destroyed (once the frames in
+		// flight are done with it), so the table has to be owned through a Ref.
+		void add(Texture& texture);
+		// Points the slot of the texture to its current image, after it was replaced or loaded (see TextureStreamer and TextureLoader). The
+		// previous image has to stay alive until every frame in flight has begun again.
+		void update(const Texture& texture);
+
+		// Must be called once the GPU is done with the previous use of this frame's set. Slots released framesInFlight frames ago or more
+		// can be reused from then on.
+		void beginFrame(uint32_t frameIndex);
+		// Once the frame is submitted, its set cannot be written to until the frame begins again
+		void endFrame();
+
+		[[nodiscard]] vk::DescriptorSetLayout getLayout() const { return m_layout; }
+		[[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t frameIndex) const { return m_descriptorSets[frameIndex]; }
+		[[nodiscard]] uint32_t getCapacity() const { return m_capacity; }
+
+	private:
+		friend class Texture;
+
+		struct SlotWrite
+		{
+			uint32_t index;
+			vk::Sampler sampler;
+			vk::ImageView view;
+		};
+		// Slot of a destroyed texture, which frames in flight may still sample along with the texture's image
+		struct RetiredSlot
+		{
+			uint32_t index;
+			AllocatedImage image;
+			uint64_t frame;
+		};
+
+		// Keeps the slot and the image alive until every frame in flight during the release is complete
+		void release(uint32_t index, AllocatedImage image);
+		// The placeholder's view for textures still loading
+		[[nodiscard]] static vk::ImageView getSampledView(const Texture& texture);
+		// Expects the mutex to be locked
+		void write(const SlotWrite& slotWrite);
+		void applyWrite(vk::DescriptorSet descriptorSet, const SlotWrite& slotWrite) const;
+
+		vk::Device m_device;
+		uint32_t m_capacity;
+		uint32_t m_framesInFlight;
+
+		vk::DescriptorSetLayout m_layout{};
+		vk::DescriptorPool m_descriptorPool{};
+		std::vector<vk::DescriptorSet> m_descriptorSets{};
+
+		std::mutex m_mutex{};
+		uint32_t m_nextIndex{0};
+		std::vector<uint32_t> m_freeIndices{};
+		std::vector<RetiredSlot> m_retiredSlots{};
+		// Frames begun so far
+		uint64_t m_frame{0};
+		// Frame being recorded, if any
+		std::optional<uint32_t> m_currentFrame{};
+		// Writes not applied yet, per frame
+		std::vector<std::vector<SlotWrite>> m_pendingWrites{};
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_TEXTURETABLE_H
@@ -0,0 +1,236 @@
+#include "UniformDescriptorSets.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace MRG
+{
+	UniformDescriptorSets::UniformDescriptorSets(vk::Device device,
+	                                             VmaAllocator allocator,
+	                                             vk::DescriptorSetLayout layout,
+	                                             const std::map<uint32_t, Shader::Root>& uboData,
+	                                             const std::map<uint32_t, Shader::TextureBindingInfo>& imageBindings,
+	                                             uint32_t framesInFlight)
+	    : m_device{device}, m_allocator{allocator}, m_frames(framesInFlight)
+	{
+		allocateSets(layout,
+		             vk::DescriptorType::eUniformBuffer,
+		             static_cast<uint32_t>(uboData.size()),
+		             0,
+		             static_cast<uint32_t>(imageBindings.size()));
+
+		for (auto& frame : m_frames) {
+			for (const auto& [bindingSlot, bindingInfo] : uboData) {
+				AllocatedBuffer newBuffer{m_allocator,
+				                          bindingInfo.size,
+				                          vk::BufferUsageFlagBits::eUniformBuffer,
+				                          VMA_MEMORY_USAGE_CPU_TO_GPU,
+				                          VMA_ALLOCATION_CREATE_MAPPED_BIT};
+
+				vk::DescriptorBufferInfo descriptorBufferInfo{
+				  .buffer = newBuffer.vkHandle,
+				  .offset = 0,
+				  .range  = bindingInfo.size,
+				};
+				vk::WriteDescriptorSet setWrite{
+				  .dstSet          = frame.descriptorSet,
+				  .dstBinding      = bindingSlot,
+				  .descriptorCount = 1,
+				  .descriptorType  = vk::DescriptorType::eUniformBuffer,
+				  .pBufferInfo     = &descriptorBufferInfo,
+				};
+
+				m_device.updateDescriptorSets(setWrite, {});
+				frame.uniformBuffers.insert(std::make_pair(bindingSlot, std::move(newBuffer)));
+			}
+		}
+
+		for (const auto& [bindingSlot, bindingInfo] : uboData) { m_uniformData[bindingSlot].resize(bindingInfo.size); }
+	}
+
+	UniformDescriptorSets::UniformDescriptorSets(vk::Device device,
+	                                             const Ref<DescriptorSetAllocator>& setAllocator,
+	                                             vk::DescriptorSetLayout layout,
+	                                             const std::map<uint32_t, Shader::Root>& uboData,
+	                                             const std::map<uint32_t, Shader::TextureBindingInfo>& imageBindings,
+	                                             std::span<const vk::Buffer> dynamicUniformBuffers,
+	                                             vk::DeviceSize instanceDataRange)
+	    : m_device{device}, m_setAllocator{setAllocator}, m_frames(dynamicUniformBuffers.size())
+	{
+		allocateSets(layout,
+		             vk::DescriptorType::eUniformBufferDynamic,
+		             static_cast<uint32_t>(uboData.size()),
+		             instanceDataRange != 0 ? 1u : 0u,
+		             static_cast<uint32_t>(imageBindings.size()));
+
+		for (std::size_t frameIndex = 0; frameIndex < m_frames.size(); ++frameIndex) {
+			std::vector<vk::DescriptorBufferInfo> bufferInfos{};
+			bufferInfos.reserve(uboData.size() + 1);
+			std::vector<vk::WriteDescriptorSet> setWrites{};
+			setWrites.reserve(uboData.size() + 1);
+			if (instanceDataRange != 0) {
+				// Dynamic offsets only move the range, which stays the one written here: shaders can read that many model matrices
+				// from the offset the instance data was pushed at, whatever the actual instance count is
+				bufferInfos.push_back(vk::DescriptorBufferInfo{
+				  .buffer = dynamicUniformBuffers[frameIndex],
+				  .offset = 0,
+				  .range  = instanceDataRange,
+				});
+				setWrites.push_back(vk::WriteDescriptorSet{
+				  .dstSet          = m_frames[frameIndex].descriptorSet,
+				  .dstBinding      = 0,
+				  .descriptorCount = 1,
+				  .descriptorType  = vk::DescriptorType::eStorageBufferDynamic,
+				  .pBufferInfo     = &bufferInfos.back(),
+				});
+			}
+			for (const auto& [bindingSlot, bindingInfo] : uboData) {
+				bufferInfos.push_back(vk::DescriptorBufferInfo{
+				  .buffer = dynamicUniformBuffers[frameIndex],
+				  .offset = 0,
+				  .range  = bindingInfo.size,
+				});
+				setWrites.push_back(vk::WriteDescriptorSet{
+				  .dstSet          = m_frames[frameIndex].descriptorSet,
+				  .dstBinding      = bindingSlot,
+				  .descriptorCount = 1,
+				  .descriptorType  = vk::DescriptorType::eUniformBufferDynamic,
+				  .pBufferInfo     = &bufferInfos.back(),
+				});
+			}
+			m_device.updateDescriptorSets(setWrites, {});
+		}
+	}
+
+	UniformDescriptorSets::UniformDescriptorSets(UniformDescriptorSets&& other) noexcept
+	    : m_device{other.m_device},
+	      m_allocator{other.m_allocator},
+	      m_descriptorPool{std::exchange(other.m_descriptorPool, vk::DescriptorPool{})},
+	      m_setAllocator{std::move(other.m_setAllocator)},
+	      m_frames{std::move(other.m_frames)},
+	      m_uniformData{std::move(other.m_uniformData)},
+	      m_imageInfos{std::move(other.m_imageInfos)}
+	{}
+
+	UniformDescriptorSets::~UniformDescriptorSets() { destroy(); }
+
+	UniformDescriptorSets& UniformDescriptorSets::operator=(UniformDescriptorSets&& other) noexcept
+	{
+		destroy();
+
+		m_device         = other.m_device;
+		m_allocator      = other.m_allocator;
+		m_descriptorPool = std::exchange(other.m_descriptorPool, vk::DescriptorPool{});
+		m_setAllocator   = std::move(other.m_setAllocator);
+		m_frames         = std::move(other.m_frames);
+		m_uniformData    = std::move(other.m_uniformData);
+		m_imageInfos     = std::move(other.m_imageInfos);
+
+		return *this;
+	}
+
+	void UniformDescriptorSets::setUniform(uint32_t bindingSlot, const void* data, std::size_t size)
+	{
+		MRG_ENGINE_ASSERT(m_uniformData.contains(bindingSlot), "Invalid binding slot!")
+		auto& uniformData = m_uniformData.at(bindingSlot);
+		MRG_ENGINE_ASSERT(size <= uniformData.size(), "Uniform data is bigger than its binding ({} > {})!", size, uniformData.size())
+
+		memcpy(uniformData.data(), data, size);
+		for (auto& frame : m_frames) { frame.isDirty = true; }
+	}
+
+	void UniformDescriptorSets::setImage(uint32_t bindingSlot, vk::Sampler sampler, vk::ImageView view)
+	{
+		m_imageInfos[bindingSlot] = vk::DescriptorImageInfo{
+		  .sampler     = sampler,
+		  .imageView   = view,
+		  .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+		};
+		for (auto& frame : m_frames) { frame.isDirty = true; }
+	}
+
+	vk::DescriptorSet UniformDescriptorSets::getDescriptorSet(uint32_t frameIndex, uint64_t frameNumber)
+	{
+		auto& frame = m_frames[frameIndex];
+		// Rewriting a set (or its uniform buffers) already recorded into a command buffer of this frame is not allowed
+		const auto isInUse = frame.lastUseFrame == frameNumber;
+		frame.lastUseFrame = frameNumber;
+		if (!frame.isDirty || isInUse) { return frame.descriptorSet; }
+
+		for (const auto& [bindingSlot, uniformData] : m_uniformData) {
+			frame.uniformBuffers.at(bindingSlot).write(uniformData.data(), uniformData.size());
+		}
+
+		std::vector<vk::WriteDescriptorSet> textureUpdates{};
+		textureUpdates.reserve(m_imageInfos.size());
+		for (const auto& [bindingSlot, imageInfo] : m_imageInfos) {
+			textureUpdates.push_back(vk::WriteDescriptorSet{
+			  .dstSet          = frame.descriptorSet,
+			  .dstBinding      = bindingSlot,
+			  .descriptorCount = 1,
+			  .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
+			  .pImageInfo      = &imageInfo,
+			});
+		}
+		m_device.updateDescriptorSets(textureUpdates, {});
+
+		frame.isDirty = false;
+		return frame.descriptorSet;
+	}
+
+	void UniformDescriptorSets::allocateSets(
+	  vk::DescriptorSetLayout layout, vk::DescriptorType uboType, uint32_t uboCount, uint32_t storageCount, uint32_t imageCount)
+	{
+		const auto framesInFlight = static_cast<uint32_t>(m_frames.size());
+
+		// Descriptors needed by the set of a single frame
+		const std::array<vk::DescriptorPoolSize, 3> setSizes{
+		  vk::DescriptorPoolSize{uboType, std::max(uboCount, 1u)},
+		  vk::DescriptorPoolSize{vk::DescriptorType::eStorageBufferDynamic, std::max(storageCount, 1u)},
+		  vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, std::max(imageCount, 1u)},
+		};
+		std::vector<vk::DescriptorSet> descriptorSets{};
+		if (m_setAllocator != nullptr) {
+			auto allocation  = m_setAllocator->allocate(layout, framesInFlight, setSizes);
+			m_descriptorPool = allocation.pool;
+			descriptorSets   = std::move(allocation.descriptorSets);
+		} else {
+			auto poolSizes = setSizes;
+			for (auto& poolSize : poolSizes) { poolSize.descriptorCount *= framesInFlight; }
+			vk::DescriptorPoolCreateInfo poolInfo{
+			  .maxSets       = framesInFlight,
+			  .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+			  .pPoolSizes    = poolSizes.data(),
+			};
+			m_descriptorPool = m_device.createDescriptorPool(poolInfo);
+
+			std::vector<vk::DescriptorSetLayout> layouts(framesInFlight, layout);
+			vk::DescriptorSetAllocateInfo setAllocInfo{
+			  .descriptorPool     = m_descriptorPool,
+			  .descriptorSetCount = framesInFlight,
+			  .pSetLayouts        = layouts.data(),
+			};
+			descriptorSets = m_device.allocateDescriptorSets(setAllocInfo);
+		}
+		for (std::size_t frameIndex = 0; frameIndex < m_frames.size(); ++frameIndex) {
+			m_frames[frameIndex].descriptorSet = descriptorSets[frameIndex];
+		}
+	}
+
+	void UniformDescriptorSets::destroy()
+	{
+		if (m_descriptorPool == vk::DescriptorPool{}) { return; }
+
+		if (m_setAllocator != nullptr) {
+			DescriptorSetAllocation allocation{.pool = m_descriptorPool};
+			for (const auto& frame : m_frames) { allocation.descriptorSets.push_back(frame.descriptorSet); }
+			m_setAllocator->release(std::move(allocation));
+			m_setAllocator.reset();
+		} else {
+			m_device.destroyDescriptorPool(m_descriptorPool);
+		}
+		m_descriptorPool = vk::DescriptorPool{};
+	}
+}  // namespace MRG
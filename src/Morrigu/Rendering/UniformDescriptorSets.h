@@ -0,0 +1,84 @@
+#ifndef MORRIGU_UNIFORMDESCRIPTORSETS_H
+#define MORRIGU_UNIFORMDESCRIPTORSETS_H
+
+#include "Rendering/DescriptorSetAllocator.h"
+#include "Rendering/RendererTypes.h"
+#include "Rendering/Shader.h"
+
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace MRG
+{
+	// Holds one copy of a descriptor set (and of the uniform buffers it points to) per frame in flight, so that changing a uniform or a
+	// texture for the frame being recorded never touches resources the GPU may still be reading for the previous frames.
+	// Changes are kept on the CPU side and only written to the copy of a given frame when that frame asks for its descriptor set, the
+	// first time it does so in a given frame: command buffers recorded earlier in the frame may already use the set, so changes made
+	// afterwards wait for the next frame using that copy.
+	class UniformDescriptorSets
+	{
+	public:
+		UniformDescriptorSets() = default;
+		UniformDescriptorSets(vk::Device device,
+		                      VmaAllocator allocator,
+		                      vk::DescriptorSetLayout layout,
+		                      const std::map<uint32_t, Shader::Root>& uboData,
+		                      const std::map<uint32_t, Shader::TextureBindingInfo>& imageBindings,
+		                      uint32_t framesInFlight);
+		// Uniform buffers are bound as dynamic uniform buffers pointing into the given buffers (one per frame in flight) instead of being
+		// owned by the sets: their content and offsets are given when drawing, and setUniform cannot be used.
+		// Instance data is bound the same way at slot 0, as a dynamic storage buffer of instanceDataRange bytes (none if 0).
+		// As these are created for every object, the sets come from the shared pools of setAllocator instead of a pool of their own.
+		UniformDescriptorSets(vk::Device device,
+		                      const Ref<DescriptorSetAllocator>& setAllocator,
+		                      vk::DescriptorSetLayout layout,
+		                      const std::map<uint32_t, Shader::Root>& uboData,
+		                      const std::map<uint32_t, Shader::TextureBindingInfo>& imageBindings,
+		                      std::span<const vk::Buffer> dynamicUniformBuffers,
+		                      vk::DeviceSize instanceDataRange);
+		UniformDescriptorSets(const UniformDescriptorSets&) = delete;
+		UniformDescriptorSets(UniformDescriptorSets&& other) noexcept;
+		~UniformDescriptorSets();
+
+		UniformDescriptorSets& operator=(const UniformDescriptorSets&) = delete;
+		UniformDescriptorSets& operator=(UniformDescriptorSets&& other) noexcept;
+
+		[[nodiscard]] bool hasUniform(uint32_t bindingSlot) const { return m_uniformData.contains(bindingSlot); }
+		void setUniform(uint32_t bindingSlot, const void* data, std::size_t size);
+		void setImage(uint32_t bindingSlot, vk::Sampler sampler, vk::ImageView view);
+
+		// Writes every change made since this frame last used its descriptor set (unless the set was already used during the frame with
+		// the given number), and returns it
+		[[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t frameIndex, uint64_t frameNumber);
+
+		[[nodiscard]] uint32_t getFramesInFlight() const { return static_cast<uint32_t>(m_frames.size()); }
+
+	private:
+		struct FrameResources
+		{
+			vk::DescriptorSet descriptorSet{};
+			std::map<uint32_t, AllocatedBuffer> uniformBuffers{};
+			bool isDirty{true};
+			// Number of the last frame the set was returned for
+			std::optional<uint64_t> lastUseFrame{};
+		};
+
+		vk::Device m_device{};
+		VmaAllocator m_allocator{};
+		// Owned by setAllocator if there is one
+		vk::DescriptorPool m_descriptorPool{};
+		Ref<DescriptorSetAllocator> m_setAllocator{};
+
+		std::vector<FrameResources> m_frames{};
+		std::map<uint32_t, std::vector<std::byte>> m_uniformData{};
+		std::map<uint32_t, vk::DescriptorImageInfo> m_imageInfos{};
+
+		void allocateSets(
+		  vk::DescriptorSetLayout layout, vk::DescriptorType uboType, uint32_t uboCount, uint32_t storageCount, uint32_t imageCount);
+		void destroy();
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_UNIFORMDESCRIPTORSETS_H
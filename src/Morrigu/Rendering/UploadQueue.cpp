@@ -0,0 +1,349 @@
+#include "UploadQueue.h"
+
+namespace MRG
+{
+	namespace
+	{
+		// Satisfies the buffer offset requirements of copies to any color format, compressed ones included
+		constexpr vk::DeviceSize stagingAlignment = 16;
+
+		// Uploaded images can be sampled by vertex shaders (displacement, ...) as well as fragment shaders
+		constexpr vk::PipelineStageFlags imageDstStages =
+		  vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader;
+	}  // namespace
+
+	UploadQueue::UploadQueue(vk::Device device,
+	                         VmaAllocator allocator,
+	                         StagingRingBuffer& stagingBuffer,
+	                         QueueInfo transferQueue,
+	                         QueueInfo graphicsQueue)
+	    : m_device{device},
+	      m_allocator{allocator},
+	      m_stagingBuffer{stagingBuffer},
+	      m_transferQueue{transferQueue},
+	      m_graphicsQueue{graphicsQueue}
+	{
+		vk::CommandPoolCreateInfo cmdPoolInfo{
+		  .flags            = vk::CommandPoolCreateFlagBits::eTransient,
+		  .queueFamilyIndex = m_transferQueue.familyIndex,
+		};
+		m_transferCommandPool = m_device.createCommandPool(cmdPoolInfo);
+
+		if (hasDedicatedTransferQueue()) {
+			cmdPoolInfo.queueFamilyIndex = m_graphicsQueue.familyIndex;
+			m_graphicsCommandPool        = m_device.createCommandPool(cmdPoolInfo);
+		}
+
+		// Batch 0 is never submitted, which makes the default constructed ticket always complete
+		m_currentBatch.id = 1;
+	}
+
+	UploadQueue::~UploadQueue()
+	{
+		flush();
+		waitIdle();
+
+		if (m_graphicsCommandPool != vk::CommandPool{}) { m_device.destroyCommandPool(m_graphicsCommandPool); }
+		m_device.destroyCommandPool(m_transferCommandPool);
+	}
+
+	UploadTicket UploadQueue::enqueueBufferUpload(std::span<const std::byte> data,
+	                                              vk::Buffer dstBuffer,
+	                                              vk::DeviceSize dstOffset,
+	                                              vk::PipelineStageFlags dstStage,
+	                                              vk::AccessFlags dstAccess)
+	{
+		const auto staging   = stage(data);
+		const auto cmdBuffer = getTransferCmdBuffer();
+
+		vk::BufferCopy copyRegion{
+		  .srcOffset = staging.offset,
+		  .dstOffset = dstOffset,
+		  .size      = data.size(),
+		};
+		cmdBuffer.copyBuffer(staging.buffer, dstBuffer, copyRegion);
+
+		m_pendingBufferBarriers.push_back(vk::BufferMemoryBarrier{
+		  .srcAccessMask       = vk::AccessFlagBits::eTransferWrite,
+		  .dstAccessMask       = dstAccess,
+		  .srcQueueFamilyIndex = hasDedicatedTransferQueue() ? m_transferQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED,
+		  .dstQueueFamilyIndex = hasDedicatedTransferQueue() ? m_graphicsQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED,
+		  .buffer              = dstBuffer,
+		  .offset              = dstOffset,
+		  .size                = data.size(),
+		});
+		m_pendingDstStages |= dstStage;
+
+		return {m_currentBatch.id};
+	}
+
+	UploadTicket UploadQueue::enqueueImageUpload(std::span<const std::byte> data,
+	                                             vk::Image dstImage,
+	                                             vk::Extent3D extent,
+	                                             const vk::ImageSubresourceRange& range)
+	{
+		const vk::BufferImageCopy copyRegion{
+		  .bufferOffset = 0,
+		  .imageSubresource =
+		    {
+		      .aspectMask     = range.aspectMask,
+		      .mipLevel       = range.baseMipLevel,
+		      .baseArrayLayer = range.baseArrayLayer,
+		      .layerCount     = range.layerCount,
+		    },
+		  .imageExtent = extent,
+		};
+		return enqueueImageUpload(data, dstImage, std::span{&copyRegion, 1}, range);
+	}
+
+	UploadTicket UploadQueue::enqueueImageUpload(std::span<const std::byte> data,
+	                                             vk::Image dstImage,
+	                                             std::span<const vk::BufferImageCopy> regions,
+	                                             const vk::ImageSubresourceRange& range)
+	{
+		const auto staging   = stage(data);
+		const auto cmdBuffer = getTransferCmdBuffer();
+
+		vk::ImageMemoryBarrier barrierToTransfer{
+		  .srcAccessMask    = {},
+		  .dstAccessMask    = vk::AccessFlagBits::eTransferWrite,
+		  .oldLayout        = vk::ImageLayout::eUndefined,
+		  .newLayout        = vk::ImageLayout::eTransferDstOptimal,
+		  .image            = dstImage,
+		  .subresourceRange = range,
+		};
+		cmdBuffer.pipelineBarrier(
+		  vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrierToTransfer);
+
+		std::vector<vk::BufferImageCopy> copyRegions(regions.begin(), regions.end());
+		for (auto& copyRegion : copyRegions) { copyRegion.bufferOffset += staging.offset; }
+		cmdBuffer.copyBufferToImage(staging.buffer, dstImage, vk::ImageLayout::eTransferDstOptimal, copyRegions);
+
+		m_pendingImageBarriers.push_back(vk::ImageMemoryBarrier{
+		  .srcAccessMask       = vk::AccessFlagBits::eTransferWrite,
+		  .dstAccessMask       = vk::AccessFlagBits::eShaderRead,
+		  .oldLayout           = vk::ImageLayout::eTransferDstOptimal,
+		  .newLayout           = vk::ImageLayout::eShaderReadOnlyOptimal,
+		  .srcQueueFamilyIndex = hasDedicatedTransferQueue() ? m_transferQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED,
+		  .dstQueueFamilyIndex = hasDedicatedTransferQueue() ? m_graphicsQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED,
+		  .image               = dstImage,
+		  .subresourceRange    = range,
+		});
+		m_pendingDstStages |= imageDstStages;
+
+		return {m_currentBatch.id};
+	}
+
+	UploadTicket UploadQueue::enqueueImageInitialisation(vk::Image image, const vk::ImageSubresourceRange& range)
+	{
+		// Nothing is copied, so the image never has to leave the graphics queue
+		vk::ImageMemoryBarrier barrierToShaders{
+		  .srcAccessMask    = {},
+		  .dstAccessMask    = vk::AccessFlagBits::eShaderRead,
+		  .oldLayout        = vk::ImageLayout::eUndefined,
+		  .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
+		  .image            = image,
+		  .subresourceRange = range,
+		};
+		getGraphicsCmdBuffer().pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, imageDstStages, {}, {}, {}, barrierToShaders);
+
+		return {m_currentBatch.id};
+	}
+
+	UploadTicket UploadQueue::enqueueGraphicsCommands(const std::function<void(vk::CommandBuffer)>& function)
+	{
+		function(getGraphicsCmdBuffer());
+
+		return {m_currentBatch.id};
+	}
+
+	UploadTicket UploadQueue::flush()
+	{
+		if (m_currentBatch.transferCmdBuffer == vk::CommandBuffer{} && m_currentBatch.graphicsCmdBuffer == vk::CommandBuffer{}) {
+			return {m_currentBatch.id - 1};
+		}
+
+		if (!m_pendingBufferBarriers.empty() || !m_pendingImageBarriers.empty()) {
+			if (hasDedicatedTransferQueue()) {
+				// The release half of the ownership transfer only has to make the transfer writes available, while the acquire half makes
+				// them visible to the graphics stages. Any layout transition has to be specified identically in both halves.
+				auto releaseBufferBarriers = m_pendingBufferBarriers;
+				auto releaseImageBarriers  = m_pendingImageBarriers;
+				for (auto& barrier : releaseBufferBarriers) { barrier.dstAccessMask = {}; }
+				for (auto& barrier : releaseImageBarriers) { barrier.dstAccessMask = {}; }
+				m_currentBatch.transferCmdBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+				                                                 vk::PipelineStageFlagBits::eBottomOfPipe,
+				                                                 {},
+				                                                 {},
+				                                                 releaseBufferBarriers,
+				                                                 releaseImageBarriers);
+
+				for (auto& barrier : m_pendingBufferBarriers) { barrier.srcAccessMask = {}; }
+				for (auto& barrier : m_pendingImageBarriers) { barrier.srcAccessMask = {}; }
+				getGraphicsCmdBuffer().pipelineBarrier(
+				  vk::PipelineStageFlagBits::eTopOfPipe, m_pendingDstStages, {}, {}, m_pendingBufferBarriers, m_pendingImageBarriers);
+			} else {
+				m_currentBatch.transferCmdBuffer.pipelineBarrier(
+				  vk::PipelineStageFlagBits::eTransfer, m_pendingDstStages, {}, {}, m_pendingBufferBarriers, m_pendingImageBarriers);
+			}
+
+			m_pendingBufferBarriers.clear();
+			m_pendingImageBarriers.clear();
+			m_pendingDstStages = {};
+		}
+
+		m_currentBatch.fence = m_device.createFence(vk::FenceCreateInfo{});
+
+		const bool hasTransferWork = m_currentBatch.transferCmdBuffer != vk::CommandBuffer{};
+		const bool hasGraphicsWork = m_currentBatch.graphicsCmdBuffer != vk::CommandBuffer{};
+		if (hasTransferWork && hasGraphicsWork) {
+			m_currentBatch.transferCmdBuffer.end();
+			m_currentBatch.graphicsCmdBuffer.end();
+			m_currentBatch.ownershipSemaphore = m_device.createSemaphore(vk::SemaphoreCreateInfo{});
+
+			vk::SubmitInfo transferSubmitInfo{
+			  .commandBufferCount   = 1,
+			  .pCommandBuffers      = &m_currentBatch.transferCmdBuffer,
+			  .signalSemaphoreCount = 1,
+			  .pSignalSemaphores    = &m_currentBatch.ownershipSemaphore,
+			};
+			m_transferQueue.queue.submit(transferSubmitInfo);
+
+			vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+			vk::SubmitInfo graphicsSubmitInfo{
+			  .waitSemaphoreCount = 1,
+			  .pWaitSemaphores    = &m_currentBatch.ownershipSemaphore,
+			  .pWaitDstStageMask  = &waitStage,
+			  .commandBufferCount = 1,
+			  .pCommandBuffers    = &m_currentBatch.graphicsCmdBuffer,
+			};
+			m_graphicsQueue.queue.submit(graphicsSubmitInfo, m_currentBatch.fence);
+		} else {
+			const auto cmdBuffer = hasTransferWork ? m_currentBatch.transferCmdBuffer : m_currentBatch.graphicsCmdBuffer;
+			const auto queue     = hasTransferWork ? m_transferQueue.queue : m_graphicsQueue.queue;
+			cmdBuffer.end();
+
+			vk::SubmitInfo submitInfo{
+			  .commandBufferCount = 1,
+			  .pCommandBuffers    = &cmdBuffer,
+			};
+			queue.submit(submitInfo, m_currentBatch.fence);
+		}
+
+		const UploadTicket ticket{m_currentBatch.id};
+		m_stagingBuffer.closeRegion(ticket.batchID);
+		m_inFlightBatches.push_back(std::move(m_currentBatch));
+		m_currentBatch    = Batch{};
+		m_currentBatch.id = ticket.batchID + 1;
+
+		collectCompletedBatches();
+
+		return ticket;
+	}
+
+	bool UploadQueue::isComplete(UploadTicket ticket)
+	{
+		collectCompletedBatches();
+
+		return ticket.batchID <= m_lastCompletedBatchID;
+	}
+
+	void UploadQueue::wait(UploadTicket ticket)
+	{
+		if (ticket.batchID >= m_currentBatch.id) { flush(); }
+
+		// Batches can end on different queues, so their fences are not guaranteed to be signaled in order
+		for (const auto& batch : m_inFlightBatches) {
+			if (batch.id > ticket.batchID) { break; }
+			MRG_VK_CHECK_HPP(m_device.waitForFences(batch.fence, VK_TRUE, UINT64_MAX), "failed to wait for upload fence!")
+		}
+
+		collectCompletedBatches();
+	}
+
+	void UploadQueue::waitIdle()
+	{
+		if (m_inFlightBatches.empty()) { return; }
+
+		wait({m_inFlightBatches.back().id});
+	}
+
+	vk::CommandBuffer UploadQueue::getTransferCmdBuffer()
+	{
+		if (m_currentBatch.transferCmdBuffer == vk::CommandBuffer{}) {
+			vk::CommandBufferAllocateInfo cmdBufferAllocInfo{
+			  .commandPool        = m_transferCommandPool,
+			  .level              = vk::CommandBufferLevel::ePrimary,
+			  .commandBufferCount = 1,
+			};
+			m_currentBatch.transferCmdBuffer = m_device.allocateCommandBuffers(cmdBufferAllocInfo).back();
+			m_currentBatch.transferCmdBuffer.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+		}
+
+		return m_currentBatch.transferCmdBuffer;
+	}
+
+	vk::CommandBuffer UploadQueue::getGraphicsCmdBuffer()
+	{
+		if (!hasDedicatedTransferQueue()) { return getTransferCmdBuffer(); }
+
+		if (m_currentBatch.graphicsCmdBuffer == vk::CommandBuffer{}) {
+			vk::CommandBufferAllocateInfo cmdBufferAllocInfo{
+			  .commandPool        = m_graphicsCommandPool,
+			  .level              = vk::CommandBufferLevel::ePrimary,
+			  .commandBufferCount = 1,
+			};
+			m_currentBatch.graphicsCmdBuffer = m_device.allocateCommandBuffers(cmdBufferAllocInfo).back();
+			m_currentBatch.graphicsCmdBuffer.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+		}
+
+		return m_currentBatch.graphicsCmdBuffer;
+	}
+
+	StagingAllocation UploadQueue::stage(std::span<const std::byte> data)
+	{
+		if (auto allocation = m_stagingBuffer.push(data, stagingAlignment); allocation.has_value()) { return allocation.value(); }
+
+		if (data.size() <= m_stagingBuffer.getCapacity()) {
+			// The ring is full of data still in use: submit what is pending and wait for the GPU to consume it
+			flush();
+			waitIdle();
+
+			const auto allocation = m_stagingBuffer.push(data, stagingAlignment);
+			MRG_ENGINE_ASSERT(allocation.has_value(), "an idle staging ring buffer should fit any upload smaller than its capacity!")
+			return allocation.value();
+		}
+
+		MRG_ENGINE_WARN("Upload of {} bytes does not fit in the staging ring buffer ({} bytes), consider making it bigger",
+		                data.size(),
+		                m_stagingBuffer.getCapacity())
+		auto& stagingBuffer = m_currentBatch.stagingBuffers.emplace_back(
+		  m_allocator, data.size(), vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+		stagingBuffer.write(data.data(), data.size());
+
+		return StagingAllocation{
+		  .buffer = stagingBuffer.vkHandle,
+		  .offset = 0,
+		};
+	}
+
+	void UploadQueue::collectCompletedBatches()
+	{
+		while (!m_inFlightBatches.empty() && m_device.getFenceStatus(m_inFlightBatches.front().fence) == vk::Result::eSuccess) {
+			releaseBatch(m_inFlightBatches.front());
+			m_lastCompletedBatchID = m_inFlightBatches.front().id;
+			m_inFlightBatches.pop_front();
+		}
+		m_stagingBuffer.release(m_lastCompletedBatchID);
+	}
+
+	void UploadQueue::releaseBatch(Batch& batch)
+	{
+		if (batch.transferCmdBuffer != vk::CommandBuffer{}) { m_device.freeCommandBuffers(m_transferCommandPool, batch.transferCmdBuffer); }
+		if (batch.graphicsCmdBuffer != vk::CommandBuffer{}) { m_device.freeCommandBuffers(m_graphicsCommandPool, batch.graphicsCmdBuffer); }
+		if (batch.ownershipSemaphore != vk::Semaphore{}) { m_device.destroySemaphore(batch.ownershipSemaphore); }
+		m_device.destroyFence(batch.fence);
+
+		batch.stagingBuffers.clear();
+	}
+}  // namespace MRG
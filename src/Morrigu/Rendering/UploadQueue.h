@@ -0,0 +1,120 @@
+#ifndef MORRIGU_UPLOADQUEUE_H
+#define MORRIGU_UPLOADQUEUE_H
+
+#include "Rendering/RendererTypes.h"
+#include "Rendering/StagingRingBuffer.h"
+
+#include <deque>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace MRG
+{
+	// Identifies the batch an upload was recorded in. Tickets are ordered: once a ticket is complete, every ticket issued before it is too.
+	struct UploadTicket
+	{
+		uint64_t batchID{0};
+	};
+
+	struct QueueInfo
+	{
+		vk::Queue queue;
+		uint32_t familyIndex;
+	};
+
+	// Records staging copies into a shared command buffer and submits them all at once when flushed, instead of doing a full CPU/GPU
+	// round-trip per resource. Copies are done on the transfer queue, and resources are then handed over to the graphics queue with a
+	// queue family ownership transfer when both queues are from different families.
+	// Everything enqueued is guaranteed to be visible to graphics commands submitted after the flush, so callers only need to wait on
+	// a ticket if they want to know when the GPU is done reading the source data.
+	// This class is not thread safe.
+	class UploadQueue
+	{
+	public:
+		UploadQueue(vk::Device device,
+		            VmaAllocator allocator,
+		            StagingRingBuffer& stagingBuffer,
+		            QueueInfo transferQueue,
+		            QueueInfo graphicsQueue);
+		UploadQueue(const UploadQueue&) = delete;
+		UploadQueue(UploadQueue&&)      = delete;
+		~UploadQueue();
+
+		UploadQueue& operator=(const UploadQueue&) = delete;
+		UploadQueue& operator=(UploadQueue&&) = delete;
+
+		// The destination buffer will be readable from the given stage with the given access once the upload is done
+		UploadTicket enqueueBufferUpload(std::span<const std::byte> data,
+		                                 vk::Buffer dstBuffer,
+		                                 vk::DeviceSize dstOffset,
+		                                 vk::PipelineStageFlags dstStage,
+		                                 vk::AccessFlags dstAccess);
+		// The whole subresource range is left in the eShaderReadOnlyOptimal layout
+		UploadTicket enqueueImageUpload(std::span<const std::byte> data,
+		                                vk::Image dstImage,
+		                                vk::Extent3D extent,
+		                                const vk::ImageSubresourceRange& range);
+		// Same as above with one copy per region (mip levels for example), their buffer offsets being relative to the beginning of data
+		UploadTicket enqueueImageUpload(std::span<const std::byte> data,
+		                                vk::Image dstImage,
+		                                std::span<const vk::BufferImageCopy> regions,
+		                                const vk::ImageSubresourceRange& range);
+		// Transitions an image without any data from the eUndefined layout to the eShaderReadOnlyOptimal layout
+		UploadTicket enqueueImageInitialisation(vk::Image image, const vk::ImageSubresourceRange& range);
+		// For work that has to be recorded on the graphics queue (ImGui font upload for example)
+		UploadTicket enqueueGraphicsCommands(const std::function<void(vk::CommandBuffer)>& function);
+
+		// Submits everything enqueued since the last flush, and returns the ticket of the submitted batch
+		UploadTicket flush();
+
+		[[nodiscard]] bool isComplete(UploadTicket ticket);
+		void wait(UploadTicket ticket);
+		void waitIdle();
+
+		[[nodiscard]] bool hasDedicatedTransferQueue() const { return m_transferQueue.familyIndex != m_graphicsQueue.familyIndex; }
+
+	private:
+		struct Batch
+		{
+			uint64_t id{};
+
+			vk::CommandBuffer transferCmdBuffer{};
+			vk::CommandBuffer graphicsCmdBuffer{};
+
+			vk::Semaphore ownershipSemaphore{};
+			vk::Fence fence{};
+
+			// Uploads too big to fit in the staging ring get their own staging buffer, kept alive until the GPU is done with the batch
+			std::vector<AllocatedBuffer> stagingBuffers{};
+		};
+
+		vk::Device m_device;
+		VmaAllocator m_allocator;
+		StagingRingBuffer& m_stagingBuffer;
+		QueueInfo m_transferQueue;
+		QueueInfo m_graphicsQueue;
+
+		vk::CommandPool m_transferCommandPool{};
+		vk::CommandPool m_graphicsCommandPool{};
+
+		Batch m_currentBatch{};
+		std::deque<Batch> m_inFlightBatches{};
+		uint64_t m_lastCompletedBatchID{0};
+
+		// Barriers making the uploaded data visible to the graphics queue are all recorded at once when flushing
+		std::vector<vk::BufferMemoryBarrier> m_pendingBufferBarriers{};
+		std::vector<vk::ImageMemoryBarrier> m_pendingImageBarriers{};
+		vk::PipelineStageFlags m_pendingDstStages{};
+
+		[[nodiscard]] vk::CommandBuffer getTransferCmdBuffer();
+		// When there is no dedicated transfer queue, this is the same command buffer as the transfer one
+		[[nodiscard]] vk::CommandBuffer getGraphicsCmdBuffer();
+		[[nodiscard]] StagingAllocation stage(std::span<const std::byte> data);
+
+		void collectCompletedBatches();
+		void releaseBatch(Batch& batch);
+	};
+}  // namespace MRG
+
+#endif  // MORRIGU_UPLOADQUEUE_H
@@ -5,9 +5,28 @@
 #include "Vertex.h"
 
 #include "Rendering/RendererTypes.h"
+#include "Utils/Hashing.h"
 
 namespace MRG
 {
+	uint64_t VertexInputDescription::getLayoutHash() const
+	{
+		uint64_t hash = Utils::Hashing::fnv1aOffsetBasis;
+		for (const auto& binding : bindings) {
+			Utils::Hashing::fnv1a<uint32_t>(hash, binding.binding);
+			Utils::Hashing::fnv1a<uint32_t>(hash, binding.stride);
+			Utils::Hashing::fnv1a<uint32_t>(hash, static_cast<uint32_t>(binding.inputRate));
+		}
+		for (const auto& attribute : attributes) {
+			Utils::Hashing::fnv1a<uint32_t>(hash, attribute.location);
+			Utils::Hashing::fnv1a<uint32_t>(hash, attribute.binding);
+			Utils::Hashing::fnv1a<uint32_t>(hash, static_cast<uint32_t>(attribute.format));
+			Utils::Hashing::fnv1a<uint32_t>(hash, attribute.offset);
+		}
+
+		return hash;
+	}
+
 	VertexInputDescription BasicVertex::getVertexDescription()
 	{
 		vk::VertexInputBindingDescription mainBinding{
@@ -16,6 +16,9 @@ namespace MRG
 	{
 		std::vector<vk::VertexInputBindingDescription> bindings{};
 		std::vector<vk::VertexInputAttributeDescription> attributes{};
+
+		// Hash of every binding and attribute of the layout, used to check that cooked vertex data matches a vertex type
+		[[nodiscard]] uint64_t getLayoutHash() const;
 	};
 
 	// clang-format off
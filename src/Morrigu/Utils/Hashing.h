@@ -0,0 +1,30 @@
+#ifndef MORRIGU_HASHING_H
+#define MORRIGU_HASHING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace MRG::Utils::Hashing
+{
+	// Mixes value into seed, same combination as boost::hash_combine. Meant for in-memory hash maps only, as the result depends on the
+	// size of std::size_t and on the std::hash implementation.
+	inline void hashCombine(std::size_t& seed, std::size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+
+	// 64 bits FNV-1a, stable across runs and platforms (for a given byte order), so suitable for hashes stored on disk
+	constexpr uint64_t fnv1aOffsetBasis = 0xCBF29CE484222325;
+	inline void fnv1a(uint64_t& hash, std::span<const std::byte> bytes)
+	{
+		for (const auto byte : bytes) {
+			hash ^= static_cast<uint64_t>(byte);
+			hash *= 0x100000001B3;
+		}
+	}
+	template<typename T>
+	void fnv1a(uint64_t& hash, const T& value)
+	{
+		fnv1a(hash, std::as_bytes(std::span{&value, 1}));
+	}
+}  // namespace MRG::Utils::Hashing
+
+#endif  // MORRIGU_HASHING_H
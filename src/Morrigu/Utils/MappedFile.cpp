@@ -0,0 +1,125 @@
+#include "MappedFile.h"
+
+#ifdef MRG_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace MRG::Utils
+{
+#ifdef MRG_PLATFORM_WINDOWS
+	MappedFile::MappedFile(const std::string& filePath)
+	{
+		m_fileHandle =
+		  CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_fileHandle == INVALID_HANDLE_VALUE) {
+			m_fileHandle = nullptr;
+			return;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(m_fileHandle, &fileSize) == 0 || fileSize.QuadPart == 0) {
+			unmap();
+			return;
+		}
+
+		m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mappingHandle == nullptr) {
+			unmap();
+			return;
+		}
+
+		m_data = static_cast<const std::byte*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		m_size = (m_data != nullptr) ? static_cast<std::size_t>(fileSize.QuadPart) : 0;
+		if (m_data == nullptr) { unmap(); }
+	}
+
+	void MappedFile::unmap()
+	{
+		if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+		if (m_mappingHandle != nullptr) { CloseHandle(m_mappingHandle); }
+		if (m_fileHandle != nullptr) { CloseHandle(m_fileHandle); }
+
+		m_data          = nullptr;
+		m_size          = 0;
+		m_mappingHandle = nullptr;
+		m_fileHandle    = nullptr;
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	    : m_data{std::exchange(other.m_data, nullptr)},
+	      m_size{std::exchange(other.m_size, 0)},
+	      m_fileHandle{std::exchange(other.m_fileHandle, nullptr)},
+	      m_mappingHandle{std::exchange(other.m_mappingHandle, nullptr)}
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		unmap();
+
+		m_data          = std::exchange(other.m_data, nullptr);
+		m_size          = std::exchange(other.m_size, 0);
+		m_fileHandle    = std::exchange(other.m_fileHandle, nullptr);
+		m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+
+		return *this;
+	}
+#else
+	MappedFile::MappedFile(const std::string& filePath)
+	{
+		const auto fileDescriptor = open(filePath.c_str(), O_RDONLY);
+		if (fileDescriptor == -1) { return; }
+
+		struct stat fileInfo
+		{};
+		if (fstat(fileDescriptor, &fileInfo) == -1 || fileInfo.st_size == 0) {
+			close(fileDescriptor);
+			return;
+		}
+
+		const auto fileSize = static_cast<std::size_t>(fileInfo.st_size);
+		auto* mapping       = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		// The mapping keeps its own reference to the file, the descriptor isn't needed anymore
+		close(fileDescriptor);
+		if (mapping == MAP_FAILED) { return; }
+
+		// The whole file is about to be read, so ask for it to be paged in right away
+		madvise(mapping, fileSize, MADV_WILLNEED);
+
+		m_data = static_cast<const std::byte*>(mapping);
+		m_size = fileSize;
+	}
+
+	void MappedFile::unmap()
+	{
+		if (m_data != nullptr) { munmap(const_cast<std::byte*>(m_data), m_size); }
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	    : m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		unmap();
+
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+
+		return *this;
+	}
+#endif
+
+	MappedFile::~MappedFile() { unmap(); }
+}  // namespace MRG::Utils
@@ -0,0 +1,40 @@
+#ifndef MORRIGU_MAPPEDFILE_H
+#define MORRIGU_MAPPEDFILE_H
+
+#include "Core/Core.h"
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace MRG::Utils
+{
+	// Read only memory mapping of a whole file. The mapping stays valid for as long as the object lives.
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::string& filePath);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		[[nodiscard]] bool isValid() const { return m_data != nullptr; }
+		[[nodiscard]] std::span<const std::byte> getData() const { return {m_data, m_size}; }
+
+	private:
+		void unmap();
+
+		const std::byte* m_data{nullptr};
+		std::size_t m_size{0};
+
+#ifdef MRG_PLATFORM_WINDOWS
+		void* m_fileHandle{nullptr};
+		void* m_mappingHandle{nullptr};
+#endif
+	};
+}  // namespace MRG::Utils
+
+#endif  // MORRIGU_MAPPEDFILE_H
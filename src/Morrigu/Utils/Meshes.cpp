@@ -4,57 +4,42 @@
 
 #include "Meshes.h"
 
+#include "Utils/Hashing.h"
+
 #include <tiny_obj_loader.h>
 
-namespace MRG::Utils::Meshes
+#include <unordered_map>
+
+namespace
 {
-	template<>
-	Ref<Mesh<BasicVertex>> loadMeshFromFile(const char* filePath)
+	// Uniquely identifies an OBJ face corner
+	struct IndexKey
 	{
-		auto newMesh = createRef<Mesh<BasicVertex>>();
-
-		tinyobj::attrib_t attrib;
-		std::vector<tinyobj::shape_t> shapes;
-		std::vector<tinyobj::material_t> materials;
-
-		std::string errors;
-
-		const auto result = tinyobj::LoadObj(&attrib, &shapes, &materials, &errors, (Folders::Rendering::meshesFolder + filePath).c_str());
-		if (!result) { MRG_ENGINE_WARN("Errors encountered when loading mesh:\n\"{}\"", errors) }
-
-		for (const auto& shape : shapes) {
-			std::size_t indexOffset = 0;
-			for ([[maybe_unused]] const auto& face : shape.mesh.num_face_vertices) {
-				static const std::size_t shapeVertexCount = 3;  // Only triangles for now
-				for (std::size_t vertexIndex = 0; vertexIndex < shapeVertexCount; ++vertexIndex) {
-					const auto idx = shape.mesh.indices[indexOffset + vertexIndex];
-
-					// position
-					const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
-					const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
-					const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
+		int vertexIndex;
+		int normalIndex;
+		int texcoordIndex;
 
-					// normals
-					const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
-					const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
-					const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
+		[[nodiscard]] bool operator==(const IndexKey&) const = default;
+	};
 
-					newMesh->vertices.emplace_back(BasicVertex{
-					  .position = {posX, posY, posZ},
-					  .normal   = {normX, normY, normZ},
-					});
-				}
-				indexOffset += shapeVertexCount;
+	struct IndexKeyHash
+	{
+		[[nodiscard]] std::size_t operator()(const IndexKey& key) const
+		{
+			std::size_t seed = 0;
+			for (const auto value : {key.vertexIndex, key.normalIndex, key.texcoordIndex}) {
+				MRG::Utils::Hashing::hashCombine(seed, std::hash<int>{}(value));
 			}
+			return seed;
 		}
+	};
 
-		return newMesh;
-	}
-
-	template<>
-	Ref<Mesh<ColoredVertex>> loadMeshFromFile(const char* filePath)
+	// Loads an OBJ file, and deduplicates the face corners sharing the same attributes so they can be referenced by the index buffer.
+	// createVertex is used to build a vertex out of the attributes of a corner that hasn't been seen yet.
+	template<MRG::Vertex VertexType, typename VertexBuilder>
+	[[nodiscard]] MRG::Ref<MRG::Mesh<VertexType>> loadIndexedMesh(const char* filePath, VertexBuilder&& createVertex)
 	{
-		auto newMesh = createRef<Mesh<ColoredVertex>>();
+		auto newMesh = MRG::createRef<MRG::Mesh<VertexType>>();
 
 		tinyobj::attrib_t attrib;
 		std::vector<tinyobj::shape_t> shapes;
@@ -62,31 +47,27 @@ namespace MRG::Utils::Meshes
 
 		std::string errors;
 
-		const auto result = tinyobj::LoadObj(&attrib, &shapes, &materials, &errors, (Folders::Rendering::meshesFolder + filePath).c_str());
+		const auto result =
+		  tinyobj::LoadObj(&attrib, &shapes, &materials, &errors, (MRG::Folders::Rendering::meshesFolder + filePath).c_str());
 		if (!result) { MRG_ENGINE_WARN("Errors encountered when loading mesh:\n\"{}\"", errors) }
 
+		std::unordered_map<IndexKey, uint32_t, IndexKeyHash> uniqueVertices{};
+		uniqueVertices.reserve(attrib.vertices.size() / 3);
+
 		for (const auto& shape : shapes) {
+			newMesh->indices.reserve(newMesh->indices.size() + shape.mesh.indices.size());
+
 			std::size_t indexOffset = 0;
 			for ([[maybe_unused]] const auto& face : shape.mesh.num_face_vertices) {
-				static const int shapeVertexCount = 3;  // Only triangles for now
+				static const std::size_t shapeVertexCount = 3;  // Only triangles for now
 				for (std::size_t vertexIndex = 0; vertexIndex < shapeVertexCount; ++vertexIndex) {
 					const auto idx = shape.mesh.indices[indexOffset + vertexIndex];
 
-					// position
-					const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
-					const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
-					const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
-
-					// normals
-					const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
-					const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
-					const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
-
-					newMesh->vertices.emplace_back(ColoredVertex{
-					  .position = {posX, posY, posZ},
-					  .normal   = {normX, normY, normZ},
-					  .color    = {normX, normY, normZ},  // Set the color as the normal for now
-					});
+					const IndexKey key{idx.vertex_index, idx.normal_index, idx.texcoord_index};
+					const auto [vertex, isNew] = uniqueVertices.try_emplace(key, static_cast<uint32_t>(newMesh->vertices.size()));
+					if (isNew) { newMesh->vertices.emplace_back(createVertex(attrib, idx)); }
+
+					newMesh->indices.emplace_back(vertex->second);
 				}
 				indexOffset += shapeVertexCount;
 			}
@@ -94,54 +75,79 @@ namespace MRG::Utils::Meshes
 
 		return newMesh;
 	}
+}  // namespace
 
+namespace MRG::Utils::Meshes
+{
 	template<>
-	Ref<Mesh<TexturedVertex>> loadMeshFromFile(const char* filePath)
+	Ref<Mesh<BasicVertex>> loadMeshFromFile(const char* filePath)
 	{
-		auto newMesh = createRef<Mesh<TexturedVertex>>();
-
-		tinyobj::attrib_t attrib;
-		std::vector<tinyobj::shape_t> shapes;
-		std::vector<tinyobj::material_t> materials;
-
-		std::string errors;
-
-		const auto result = tinyobj::LoadObj(&attrib, &shapes, &materials, &errors, (Folders::Rendering::meshesFolder + filePath).c_str());
-		if (!result) { MRG_ENGINE_WARN("Errors encountered when loading mesh:\n\"{}\"", errors) }
-
-		for (const auto& shape : shapes) {
-			std::size_t indexOffset = 0;
-			for ([[maybe_unused]] const auto& face : shape.mesh.num_face_vertices) {
-				static const int shapeVertexCount = 3;  // Only triangles for now
-				for (std::size_t vertexIndex = 0; vertexIndex < shapeVertexCount; ++vertexIndex) {
-					const auto idx = shape.mesh.indices[indexOffset + vertexIndex];
+		return loadIndexedMesh<BasicVertex>(filePath, [](const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx) {
+			// position
+			const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
+			const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
+			const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
+
+			// normals
+			const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
+			const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
+			const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
+
+			return BasicVertex{
+			  .position = {posX, posY, posZ},
+			  .normal   = {normX, normY, normZ},
+			};
+		});
+	}
 
-					// position
-					const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
-					const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
-					const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
-
-					// normals
-					const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
-					const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
-					const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
-
-					// texture coordinates
-					const auto texCoodX = attrib.texcoords[2 * static_cast<std::size_t>(idx.texcoord_index) + 0];
-					const auto texCoodY = attrib.texcoords[2 * static_cast<std::size_t>(idx.texcoord_index) + 1];
-
-					newMesh->vertices.emplace_back(TexturedVertex{
-					  .position  = {posX, posY, posZ},
-					  .normal    = {normX, normY, normZ},
-					  .texCoords = {texCoodX, 1 - texCoodY},
-					});
-				}
-				indexOffset += shapeVertexCount;
-			}
-		}
+	template<>
+	Ref<Mesh<ColoredVertex>> loadMeshFromFile(const char* filePath)
+	{
+		return loadIndexedMesh<ColoredVertex>(filePath, [](const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx) {
+			// position
+			const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
+			const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
+			const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
+
+			// normals
+			const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
+			const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
+			const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
+
+			return ColoredVertex{
+			  .position = {posX, posY, posZ},
+			  .normal   = {normX, normY, normZ},
+			  .color    = {normX, normY, normZ},  // Set the color as the normal for now
+			};
+		});
+	}
 
-		return newMesh;
+	template<>
+	Ref<Mesh<TexturedVertex>> loadMeshFromFile(const char* filePath)
+	{
+		return loadIndexedMesh<TexturedVertex>(filePath, [](const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx) {
+			// position
+			const auto posX = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 0];
+			const auto posY = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 1];
+			const auto posZ = attrib.vertices[3 * static_cast<std::size_t>(idx.vertex_index) + 2];
+
+			// normals
+			const auto normX = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 0];
+			const auto normY = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 1];
+			const auto normZ = attrib.normals[3 * static_cast<std::size_t>(idx.normal_index) + 2];
+
+			// texture coordinates
+			const auto texCoodX = attrib.texcoords[2 * static_cast<std::size_t>(idx.texcoord_index) + 0];
+			const auto texCoodY = attrib.texcoords[2 * static_cast<std::size_t>(idx.texcoord_index) + 1];
+
+			return TexturedVertex{
+			  .position  = {posX, posY, posZ},
+			  .normal    = {normX, normY, normZ},
+			  .texCoords = {texCoodX, 1 - texCoodY},
+			};
+		});
 	}
+
 	template<>
 	Ref<Mesh<BasicVertex>> quad()
 	{
@@ -150,10 +156,9 @@ namespace MRG::Utils::Meshes
 		  BasicVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
 		  BasicVertex{.position{-0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
 		  BasicVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
-		  BasicVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
 		  BasicVertex{.position{0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
-		  BasicVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}},
 		};
+		quad->indices = {0, 1, 2, 2, 3, 0};
 
 		return quad;
 	}
@@ -166,10 +171,9 @@ namespace MRG::Utils::Meshes
 		  ColoredVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
 		  ColoredVertex{.position{-0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
 		  ColoredVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
-		  ColoredVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
 		  ColoredVertex{.position{0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
-		  ColoredVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .color{0.2, 0.2, 0.2}},
 		};
+		quad->indices = {0, 1, 2, 2, 3, 0};
 
 		return quad;
 	}
@@ -182,10 +186,9 @@ namespace MRG::Utils::Meshes
 		  MRG::TexturedVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{0.f, 0.f}},
 		  MRG::TexturedVertex{.position{-0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{0.f, 1.f}},
 		  MRG::TexturedVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{1.f, 1.f}},
-		  MRG::TexturedVertex{.position{0.5f, 0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{1.f, 1.f}},
 		  MRG::TexturedVertex{.position{0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{1.f, 0.f}},
-		  MRG::TexturedVertex{.position{-0.5f, -0.5f, 0.f}, .normal{0.f, 0.f, -1.f}, .texCoords{0.f, 0.f}},
 		};
+		quad->indices = {0, 1, 2, 2, 3, 0};
 
 		return quad;
 	}
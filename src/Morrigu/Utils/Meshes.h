@@ -6,6 +6,16 @@
 #define MORRIGU_UTILSMESHES_H
 
 #include "Rendering/Mesh.h"
+#include "Utils/MappedFile.h"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace MRG::Utils::Meshes
 {
@@ -42,6 +52,130 @@ namespace MRG::Utils::Meshes
 	{
 		return loadMeshFromFile<VertexType>("engine/torus.obj");
 	}
+
+	/// Indices drawing the given vertices as a plain triangle list, for meshes built without any index
+	[[nodiscard]] inline std::vector<uint32_t> makeTriangleListIndices(std::size_t vertexCount)
+	{
+		std::vector<uint32_t> indices(vertexCount);
+		std::iota(indices.begin(), indices.end(), uint32_t{0});
+		return indices;
+	}
+
+	/// Cooked meshes are binary blobs made of this header, followed by the interleaved vertices and then the indices.
+	/// They are produced offline by the cooker tool, and can be copied as is into a staging buffer.
+	struct CookedMeshHeader
+	{
+		static constexpr std::array<char, 4> expectedMagic{'M', 'R', 'G', 'M'};
+		// Increment this whenever the layout of the file changes
+		static constexpr uint32_t currentVersion = 1;
+
+		std::array<char, 4> magic{expectedMagic};
+		uint32_t version{currentVersion};
+		uint64_t vertexLayoutHash{};
+		uint32_t vertexStride{};
+		uint32_t vertexCount{};
+		uint32_t indexCount{};
+		uint32_t reserved{};
+	};
+
+	template<Vertex VertexType>
+	class CookedMesh
+	{
+	public:
+		CookedMeshHeader header;
+		// Both views point directly into the file mapping
+		std::span<const std::byte> vertexData;
+		std::span<const std::byte> indexData;
+
+		MappedFile file;
+	};
+
+	/// Returns the path of the cooked version of the given mesh file (relative to MRG::Folders::Rendering::meshesFolder)
+	[[nodiscard]] inline std::string getCookedMeshPath(const char* filePath)
+	{
+		return std::filesystem::path{Folders::Rendering::cookedMeshesFolder + filePath}
+		  .replace_extension(Files::Rendering::cookedMeshExtension)
+		  .string();
+	}
+
+	/// Meshes without any index are cooked as a plain triangle list, so that cooked meshes always have indices
+	template<Vertex VertexType>
+	bool cookMesh(const Mesh<VertexType>& mesh, const std::string& outputPath)
+	{
+		if (mesh.vertices.empty()) {
+			MRG_ENGINE_ERROR("Cannot cook \"{}\", the mesh has no vertices!", outputPath)
+			return false;
+		}
+		const auto indices = mesh.indices.empty() ? makeTriangleListIndices(mesh.vertices.size()) : mesh.indices;
+
+		const CookedMeshHeader header{
+		  .vertexLayoutHash = VertexType::getVertexDescription().getLayoutHash(),
+		  .vertexStride     = static_cast<uint32_t>(sizeof(VertexType)),
+		  .vertexCount      = static_cast<uint32_t>(mesh.vertices.size()),
+		  .indexCount       = static_cast<uint32_t>(indices.size()),
+		};
+
+		const auto parentFolder = std::filesystem::path{outputPath}.parent_path();
+		if (!parentFolder.empty()) { std::filesystem::create_directories(parentFolder); }
+
+		std::ofstream file{outputPath, std::ios::binary | std::ios::trunc};
+		if (!file.is_open()) {
+			MRG_ENGINE_ERROR("Failed to open \"{}\" to write cooked mesh!", outputPath)
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(mesh.vertices.data()),
+		           static_cast<std::streamsize>(mesh.vertices.size() * sizeof(VertexType)));
+		file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+
+		return file.good();
+	}
+
+	/// Maps the cooked version of the given mesh file (see getCookedMeshPath). Returns an empty optional if the file is missing, empty,
+	/// or if it was cooked with an incompatible version or vertex layout.
+	template<Vertex VertexType>
+	[[nodiscard]] std::optional<CookedMesh<VertexType>> loadCookedMesh(const char* filePath)
+	{
+		const auto cookedPath = getCookedMeshPath(filePath);
+		MappedFile file{cookedPath};
+		if (!file.isValid()) { return std::nullopt; }
+
+		const auto data = file.getData();
+		if (data.size() < sizeof(CookedMeshHeader)) {
+			MRG_ENGINE_WARN("Cooked mesh \"{}\" is truncated, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		CookedMeshHeader header;
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (header.magic != CookedMeshHeader::expectedMagic || header.version != CookedMeshHeader::currentVersion) {
+			MRG_ENGINE_WARN("Cooked mesh \"{}\" was produced by an incompatible cooker version, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+		if (header.vertexLayoutHash != VertexType::getVertexDescription().getLayoutHash() || header.vertexStride != sizeof(VertexType)) {
+			MRG_ENGINE_WARN("Cooked mesh \"{}\" does not match the requested vertex layout, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		if (header.vertexCount == 0 || header.indexCount == 0) {
+			MRG_ENGINE_WARN("Cooked mesh \"{}\" has no vertices or no indices, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		const auto vertexDataSize = static_cast<std::size_t>(header.vertexCount) * header.vertexStride;
+		const auto indexDataSize  = static_cast<std::size_t>(header.indexCount) * sizeof(uint32_t);
+		if (data.size() != sizeof(CookedMeshHeader) + vertexDataSize + indexDataSize) {
+			MRG_ENGINE_WARN("Cooked mesh \"{}\" has an invalid size, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		return CookedMesh<VertexType>{
+		  .header     = header,
+		  .vertexData = data.subspan(sizeof(CookedMeshHeader), vertexDataSize),
+		  .indexData  = data.subspan(sizeof(CookedMeshHeader) + vertexDataSize, indexDataSize),
+		  .file       = std::move(file),
+		};
+	}
 }  // namespace MRG::Utils::Meshes
 
 #endif  // MORRIGU_UTILSMESHES_H
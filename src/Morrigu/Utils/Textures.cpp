@@ -0,0 +1,260 @@
+#include "Textures.h"
+
+#include "Core/FileNames.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	// Beginning of a KTX2 file, followed by one KTX2LevelIndex per level. KTX2 files are little endian, like every platform supported.
+	struct KTX2Header
+	{
+		static constexpr std::array<uint8_t, 12> expectedIdentifier{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+		std::array<uint8_t, 12> identifier{expectedIdentifier};
+		uint32_t vkFormat{};
+		uint32_t typeSize{};
+		uint32_t pixelWidth{};
+		uint32_t pixelHeight{};
+		uint32_t pixelDepth{};
+		uint32_t layerCount{};
+		uint32_t faceCount{};
+		uint32_t levelCount{};
+		uint32_t supercompressionScheme{};
+		uint32_t dfdByteOffset{};
+		uint32_t dfdByteLength{};
+		uint32_t kvdByteOffset{};
+		uint32_t kvdByteLength{};
+		uint64_t sgdByteOffset{};
+		uint64_t sgdByteLength{};
+	};
+	static_assert(sizeof(KTX2Header) == 80, "Invalid KTX2 header layout!");
+
+	struct KTX2LevelIndex
+	{
+		uint64_t byteOffset;
+		uint64_t byteLength;
+		uint64_t uncompressedByteLength;
+	};
+
+	[[nodiscard]] bool isSRGB(vk::Format format)
+	{
+		return format == vk::Format::eBc1RgbSrgbBlock || format == vk::Format::eBc7SrgbBlock;
+	}
+
+	// KTX2 files must hold the Khronos basic data format descriptor of their format, even though vkFormat already describes it
+	[[nodiscard]] std::vector<uint32_t> createDataFormatDescriptor(vk::Format format, uint32_t blockSize)
+	{
+		constexpr uint32_t versionNumber    = 2;
+		constexpr uint32_t primariesBT709   = 1;
+		constexpr uint32_t transferLinear   = 1;
+		constexpr uint32_t transferSRGB     = 2;
+		constexpr uint32_t colorModelBC1A   = 128;
+		constexpr uint32_t colorModelBC5    = 132;
+		constexpr uint32_t colorModelBC7    = 134;
+		constexpr uint32_t blockDimensions4 = 3;
+
+		struct Sample
+		{
+			uint32_t bitOffset;
+			uint32_t bitLength;
+			uint32_t channel;
+		};
+		uint32_t colorModel = 0;
+		std::vector<Sample> samples{};
+		switch (format) {
+		case vk::Format::eBc1RgbUnormBlock:
+		case vk::Format::eBc1RgbSrgbBlock:
+			colorModel = colorModelBC1A;
+			samples    = {{0, 64, 0}};
+			break;
+		case vk::Format::eBc5UnormBlock:
+			// Red then green channels
+			colorModel = colorModelBC5;
+			samples    = {{0, 64, 0}, {64, 64, 1}};
+			break;
+		default:
+			colorModel = colorModelBC7;
+			samples    = {{0, 128, 0}};
+			break;
+		}
+
+		const auto descriptorBlockSize = static_cast<uint32_t>(24 + 16 * samples.size());
+		std::vector<uint32_t> descriptor{
+		  4 + descriptorBlockSize,
+		  0,  // Khronos vendor and basic descriptor type
+		  versionNumber | (descriptorBlockSize << 16),
+		  colorModel | (primariesBT709 << 8) | ((isSRGB(format) ? transferSRGB : transferLinear) << 16),
+		  blockDimensions4 | (blockDimensions4 << 8),
+		  blockSize,
+		  0,
+		};
+		for (const auto& sample : samples) {
+			descriptor.push_back(sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channel << 24));
+			descriptor.push_back(0);  // Sample position
+			descriptor.push_back(0);  // Lower bound
+			descriptor.push_back(UINT32_MAX);  // Upper bound
+		}
+
+		return descriptor;
+	}
+}  // namespace
+
+namespace MRG::Utils::Textures
+{
+	std::optional<uint32_t> getBlockSize(vk::Format format)
+	{
+		switch (format) {
+		case vk::Format::eBc1RgbUnormBlock:
+		case vk::Format::eBc1RgbSrgbBlock:
+			return 8;
+		case vk::Format::eBc5UnormBlock:
+		case vk::Format::eBc7UnormBlock:
+		case vk::Format::eBc7SrgbBlock:
+			return 16;
+		default:
+			return std::nullopt;
+		}
+	}
+
+	std::size_t getCompressedLevelSize(vk::Format format, uint32_t width, uint32_t height)
+	{
+		const auto blockSize = getBlockSize(format);
+		MRG_ENGINE_ASSERT(blockSize.has_value(), "Unsupported block compressed format!")
+
+		return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize.value();
+	}
+
+	std::string getCookedTexturePath(const char* filePath)
+	{
+		return std::filesystem::path{Folders::Rendering::cookedTexturesFolder + filePath}
+		  .replace_extension(Files::Rendering::cookedTextureExtension)
+		  .string();
+	}
+
+	bool cookTexture(const MipChain& compressedChain, vk::Format format, const std::string& outputPath)
+	{
+		const auto blockSize = getBlockSize(format);
+		MRG_ENGINE_ASSERT(blockSize.has_value(), "Cooked textures have to be BC1, BC5 or BC7 compressed!")
+
+		const auto descriptor     = createDataFormatDescriptor(format, blockSize.value());
+		const auto descriptorSize = descriptor.size() * sizeof(uint32_t);
+		const auto levelIndexSize = compressedChain.levels.size() * sizeof(KTX2LevelIndex);
+
+		// Levels are stored from the smallest to the biggest one, each of them aligned on the block size
+		std::vector<KTX2LevelIndex> levelIndex(compressedChain.levels.size());
+		std::size_t offset = sizeof(KTX2Header) + levelIndexSize + descriptorSize;
+		for (auto level = compressedChain.levels.size(); level-- > 0;) {
+			offset            = (offset + blockSize.value() - 1) / blockSize.value() * blockSize.value();
+			levelIndex[level] = KTX2LevelIndex{
+			  .byteOffset             = offset,
+			  .byteLength             = compressedChain.levels[level].size,
+			  .uncompressedByteLength = compressedChain.levels[level].size,
+			};
+			offset += compressedChain.levels[level].size;
+		}
+
+		const auto& baseLevel = compressedChain.levels.front();
+		const KTX2Header header{
+		  .vkFormat      = static_cast<uint32_t>(format),
+		  .typeSize      = 1,
+		  .pixelWidth    = baseLevel.width,
+		  .pixelHeight   = baseLevel.height,
+		  .faceCount     = 1,
+		  .levelCount    = compressedChain.getLevelCount(),
+		  .dfdByteOffset = static_cast<uint32_t>(sizeof(KTX2Header) + levelIndexSize),
+		  .dfdByteLength = static_cast<uint32_t>(descriptorSize),
+		};
+
+		const auto parentFolder = std::filesystem::path{outputPath}.parent_path();
+		if (!parentFolder.empty()) { std::filesystem::create_directories(parentFolder); }
+
+		std::ofstream file{outputPath, std::ios::binary | std::ios::trunc};
+		if (!file.is_open()) {
+			MRG_ENGINE_ERROR("Failed to open \"{}\" to write cooked texture!", outputPath)
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(levelIndex.data()), static_cast<std::streamsize>(levelIndexSize));
+		file.write(reinterpret_cast<const char*>(descriptor.data()), static_cast<std::streamsize>(descriptorSize));
+		for (auto level = compressedChain.levels.size(); level-- > 0;) {
+			static constexpr std::array<char, 16> padding{};
+			const auto position = static_cast<std::size_t>(file.tellp());
+			file.write(padding.data(), static_cast<std::streamsize>(levelIndex[level].byteOffset - position));
+
+			const auto levelData = compressedChain.getLevelData(static_cast<uint32_t>(level));
+			file.write(reinterpret_cast<const char*>(levelData.data()), static_cast<std::streamsize>(levelData.size()));
+		}
+
+		return file.good();
+	}
+
+	std::optional<CookedTexture> loadCookedTexture(const char* filePath)
+	{
+		const auto cookedPath = getCookedTexturePath(filePath);
+		MappedFile file{cookedPath};
+		if (!file.isValid()) { return std::nullopt; }
+
+		const auto data = file.getData();
+		KTX2Header header;
+		if (data.size() < sizeof(header)) {
+			MRG_ENGINE_WARN("Cooked texture \"{}\" is truncated, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (header.identifier != KTX2Header::expectedIdentifier) {
+			MRG_ENGINE_WARN("Cooked texture \"{}\" is not a KTX2 file, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		const auto format    = static_cast<vk::Format>(header.vkFormat);
+		const auto blockSize = getBlockSize(format);
+		if (!blockSize.has_value() || header.supercompressionScheme != 0) {
+			MRG_ENGINE_WARN("Cooked texture \"{}\" is not BC1, BC5 or BC7 compressed without supercompression, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+		// A full mip chain has log2(max(width, height)) + 1 levels
+		const auto baseSize = std::max(header.pixelWidth, header.pixelHeight);
+		if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 || header.layerCount > 1 || header.faceCount != 1 ||
+		    header.levelCount == 0 || header.levelCount > 32 || (baseSize >> (header.levelCount - 1)) == 0) {
+			MRG_ENGINE_WARN("Cooked texture \"{}\" is not a single 2D image with mip levels, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+		if (data.size() < sizeof(header) + header.levelCount * sizeof(KTX2LevelIndex)) {
+			MRG_ENGINE_WARN("Cooked texture \"{}\" is truncated, ignoring it", cookedPath)
+			return std::nullopt;
+		}
+
+		std::vector<MipLevel> levels{};
+		levels.reserve(header.levelCount);
+		for (uint32_t level = 0; level < header.levelCount; ++level) {
+			KTX2LevelIndex levelIndex;
+			std::memcpy(&levelIndex, data.data() + sizeof(header) + level * sizeof(KTX2LevelIndex), sizeof(levelIndex));
+
+			const auto width  = std::max(header.pixelWidth >> level, 1u);
+			const auto height = std::max(header.pixelHeight >> level, 1u);
+			if (levelIndex.byteLength != getCompressedLevelSize(format, width, height) || levelIndex.byteOffset % blockSize.value() != 0 ||
+			    levelIndex.byteOffset + levelIndex.byteLength > data.size()) {
+				MRG_ENGINE_WARN("Cooked texture \"{}\" has an invalid level {}, ignoring it", cookedPath, level)
+				return std::nullopt;
+			}
+
+			levels.push_back(MipLevel{
+			  .width  = width,
+			  .height = height,
+			  .offset = levelIndex.byteOffset,
+			  .size   = levelIndex.byteLength,
+			});
+		}
+
+		return CookedTexture{
+		  .format = format,
+		  .levels = std::move(levels),
+		  .file   = std::move(file),
+		};
+	}
+}  // namespace MRG::Utils::Textures
@@ -0,0 +1,44 @@
+#ifndef MORRIGU_UTILSTEXTURES_H
+#define MORRIGU_UTILSTEXTURES_H
+
+#include "Rendering/MipChain.h"
+#include "Rendering/RendererTypes.h"
+#include "Utils/MappedFile.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MRG::Utils::Textures
+{
+	/// Cooked textures are KTX2 files (https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html) holding the whole mip chain of a
+	/// block compressed image, without supercompression. They are produced offline by the cooker tool, and their levels can be copied as
+	/// is into a staging buffer.
+	struct CookedTexture
+	{
+		vk::Format format;
+		// Offsets are relative to the beginning of the file, and point directly into its mapping
+		std::vector<MipLevel> levels;
+
+		MappedFile file;
+	};
+
+	/// Size in bytes of a 4x4 block of the given format, or an empty optional if it is not a block compressed format cooked textures
+	/// can use (BC1, BC5 and BC7)
+	[[nodiscard]] std::optional<uint32_t> getBlockSize(vk::Format format);
+	/// Size in bytes of a level of the given block compressed format. Blocks on the right and bottom edges are partially used when the
+	/// level size is not a multiple of 4.
+	[[nodiscard]] std::size_t getCompressedLevelSize(vk::Format format, uint32_t width, uint32_t height);
+
+	/// Returns the path of the cooked version of the given texture file (relative to MRG::Folders::Rendering::texturesFolder)
+	[[nodiscard]] std::string getCookedTexturePath(const char* filePath);
+
+	/// Writes the given mip chain, whose levels are already compressed in the given format, as a KTX2 file
+	bool cookTexture(const MipChain& compressedChain, vk::Format format, const std::string& outputPath);
+
+	/// Maps the cooked version of the given texture file (see getCookedTexturePath). Returns an empty optional if the file is missing,
+	/// or if it is not a KTX2 file cooked textures can use.
+	[[nodiscard]] std::optional<CookedTexture> loadCookedTexture(const char* filePath);
+}  // namespace MRG::Utils::Textures
+
+#endif  // MORRIGU_UTILSTEXTURES_H
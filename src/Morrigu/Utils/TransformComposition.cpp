@@ -0,0 +1,234 @@
+#include "TransformComposition.h"
+
+#include "Core/Core.h"
+
+#include <array>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// The kernel is written once against these wrappers, so that the remainder of a batch can go through the scalar version
+	struct ScalarFloats
+	{
+		static constexpr std::size_t WIDTH = 1;
+
+		float value;
+
+		[[nodiscard]] static ScalarFloats load(const float* source) { return {*source}; }
+		[[nodiscard]] static ScalarFloats broadcast(float value) { return {value}; }
+		void store(float* destination) const { *destination = value; }
+
+		[[nodiscard]] friend ScalarFloats operator+(ScalarFloats lhs, ScalarFloats rhs) { return {lhs.value + rhs.value}; }
+		[[nodiscard]] friend ScalarFloats operator-(ScalarFloats lhs, ScalarFloats rhs) { return {lhs.value - rhs.value}; }
+		[[nodiscard]] friend ScalarFloats operator*(ScalarFloats lhs, ScalarFloats rhs) { return {lhs.value * rhs.value}; }
+		[[nodiscard]] friend ScalarFloats roundToNearest(ScalarFloats floats) { return {std::round(floats.value)}; }
+	};
+
+#if defined(__AVX2__)
+	struct VectorFloats
+	{
+		static constexpr std::size_t WIDTH = 8;
+
+		__m256 value;
+
+		[[nodiscard]] static VectorFloats load(const float* source) { return {_mm256_loadu_ps(source)}; }
+		[[nodiscard]] static VectorFloats broadcast(float value) { return {_mm256_set1_ps(value)}; }
+		void store(float* destination) const { _mm256_storeu_ps(destination, value); }
+
+		[[nodiscard]] friend VectorFloats operator+(VectorFloats lhs, VectorFloats rhs) { return {_mm256_add_ps(lhs.value, rhs.value)}; }
+		[[nodiscard]] friend VectorFloats operator-(VectorFloats lhs, VectorFloats rhs) { return {_mm256_sub_ps(lhs.value, rhs.value)}; }
+		[[nodiscard]] friend VectorFloats operator*(VectorFloats lhs, VectorFloats rhs) { return {_mm256_mul_ps(lhs.value, rhs.value)}; }
+		[[nodiscard]] friend VectorFloats roundToNearest(VectorFloats floats)
+		{
+			return {_mm256_round_ps(floats.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+		}
+	};
+#elif defined(__SSE2__) || defined(_M_X64)
+	struct VectorFloats
+	{
+		static constexpr std::size_t WIDTH = 4;
+
+		__m128 value;
+
+		[[nodiscard]] static VectorFloats load(const float* source) { return {_mm_loadu_ps(source)}; }
+		[[nodiscard]] static VectorFloats broadcast(float value) { return {_mm_set1_ps(value)}; }
+		void store(float* destination) const { _mm_storeu_ps(destination, value); }
+
+		[[nodiscard]] friend VectorFloats operator+(VectorFloats lhs, VectorFloats rhs) { return {_mm_add_ps(lhs.value, rhs.value)}; }
+		[[nodiscard]] friend VectorFloats operator-(VectorFloats lhs, VectorFloats rhs) { return {_mm_sub_ps(lhs.value, rhs.value)}; }
+		[[nodiscard]] friend VectorFloats operator*(VectorFloats lhs, VectorFloats rhs) { return {_mm_mul_ps(lhs.value, rhs.value)}; }
+		// SSE2 has no rounding instruction, but the conversion to integers rounds to nearest (angles never get close to 2^31 turns)
+		[[nodiscard]] friend VectorFloats roundToNearest(VectorFloats floats) { return {_mm_cvtepi32_ps(_mm_cvtps_epi32(floats.value))}; }
+	};
+#else
+	using VectorFloats = ScalarFloats;
+#endif
+
+	using MRG::Utils::Maths::TransformArrays;
+
+	// First three rows of the columns of Floats::WIDTH matrices
+	template<typename Floats>
+	using Columns = std::array<std::array<float, Floats::WIDTH>, 12>;
+
+	template<typename Floats>
+	struct SinCos
+	{
+		Floats sin;
+		Floats cos;
+	};
+
+	// Reduces the angle to [-pi, pi], evaluates the Taylor series of its half (accurate to ~1e-7 on [-pi/2, pi/2]), and doubles it back
+	template<typename Floats>
+	[[nodiscard]] SinCos<Floats> sinCos(Floats angle)
+	{
+		// 2 pi split in two so that k * 2 pi is subtracted with more precision than a float holds
+		const auto turns   = roundToNearest(angle * Floats::broadcast(0.15915494309189535f));
+		const auto reduced = angle - turns * Floats::broadcast(6.28125f) - turns * Floats::broadcast(1.9353071795864769e-3f);
+
+		const auto half        = reduced * Floats::broadcast(0.5f);
+		const auto halfSquared = half * half;
+
+		auto sinPolynomial = Floats::broadcast(-1.f / 39916800.f);
+		sinPolynomial      = sinPolynomial * halfSquared + Floats::broadcast(1.f / 362880.f);
+		sinPolynomial      = sinPolynomial * halfSquared + Floats::broadcast(-1.f / 5040.f);
+		sinPolynomial      = sinPolynomial * halfSquared + Floats::broadcast(1.f / 120.f);
+		sinPolynomial      = sinPolynomial * halfSquared + Floats::broadcast(-1.f / 6.f);
+		sinPolynomial      = sinPolynomial * halfSquared + Floats::broadcast(1.f);
+		const auto halfSin = sinPolynomial * half;
+
+		auto cosPolynomial = Floats::broadcast(1.f / 479001600.f);
+		cosPolynomial      = cosPolynomial * halfSquared + Floats::broadcast(-1.f / 3628800.f);
+		cosPolynomial      = cosPolynomial * halfSquared + Floats::broadcast(1.f / 40320.f);
+		cosPolynomial      = cosPolynomial * halfSquared + Floats::broadcast(-1.f / 720.f);
+		cosPolynomial      = cosPolynomial * halfSquared + Floats::broadcast(1.f / 24.f);
+		cosPolynomial      = cosPolynomial * halfSquared + Floats::broadcast(-1.f / 2.f);
+		const auto halfCos = cosPolynomial * halfSquared + Floats::broadcast(1.f);
+
+		const auto two = Floats::broadcast(2.f);
+		return {
+		  .sin = two * halfSin * halfCos,
+		  .cos = Floats::broadcast(1.f) - two * halfSin * halfSin,
+		};
+	}
+
+	// Composes the Floats::WIDTH transforms starting at first
+	template<typename Floats>
+	void composePack(const TransformArrays& transforms, std::size_t first, Columns<Floats>& columns)
+	{
+		const auto half = Floats::broadcast(0.5f);
+		const auto x    = sinCos(Floats::load(transforms.rotationsX.data() + first) * half);
+		const auto y    = sinCos(Floats::load(transforms.rotationsY.data() + first) * half);
+		const auto z    = sinCos(Floats::load(transforms.rotationsZ.data() + first) * half);
+
+		// Same as glm::quat(eulerAngles), then glm::mat3_cast
+		const auto qw = x.cos * y.cos * z.cos + x.sin * y.sin * z.sin;
+		const auto qx = x.sin * y.cos * z.cos - x.cos * y.sin * z.sin;
+		const auto qy = x.cos * y.sin * z.cos + x.sin * y.cos * z.sin;
+		const auto qz = x.cos * y.cos * z.sin - x.sin * y.sin * z.cos;
+
+		const auto one = Floats::broadcast(1.f);
+		const auto two = Floats::broadcast(2.f);
+		const auto qxx = qx * qx;
+		const auto qyy = qy * qy;
+		const auto qzz = qz * qz;
+		const auto qxz = qx * qz;
+		const auto qxy = qx * qy;
+		const auto qyz = qy * qz;
+		const auto qwx = qw * qx;
+		const auto qwy = qw * qy;
+		const auto qwz = qw * qz;
+
+		const auto scaleX = Floats::load(transforms.scalesX.data() + first);
+		const auto scaleY = Floats::load(transforms.scalesY.data() + first);
+		const auto scaleZ = Floats::load(transforms.scalesZ.data() + first);
+
+		((one - two * (qyy + qzz)) * scaleX).store(columns[0].data());
+		(two * (qxy + qwz) * scaleX).store(columns[1].data());
+		(two * (qxz - qwy) * scaleX).store(columns[2].data());
+		(two * (qxy - qwz) * scaleY).store(columns[3].data());
+		((one - two * (qxx + qzz)) * scaleY).store(columns[4].data());
+		(two * (qyz + qwx) * scaleY).store(columns[5].data());
+		(two * (qxz + qwy) * scaleZ).store(columns[6].data());
+		(two * (qyz - qwx) * scaleZ).store(columns[7].data());
+		((one - two * (qxx + qyy)) * scaleZ).store(columns[8].data());
+		Floats::load(transforms.translationsX.data() + first).store(columns[9].data());
+		Floats::load(transforms.translationsY.data() + first).store(columns[10].data());
+		Floats::load(transforms.translationsZ.data() + first).store(columns[11].data());
+	}
+
+	// Composes the transforms in [first, last), which must be a multiple of Floats::WIDTH transforms
+	template<typename Floats>
+	void composeRange(const TransformArrays& transforms, std::size_t first, std::size_t last, std::span<glm::mat4> matrices)
+	{
+		Columns<Floats> columns;
+		for (; first + Floats::WIDTH <= last; first += Floats::WIDTH) {
+			composePack<Floats>(transforms, first, columns);
+			for (std::size_t lane = 0; lane < Floats::WIDTH; ++lane) {
+				matrices[first + lane] = glm::mat4{
+				  glm::vec4{columns[0][lane], columns[1][lane], columns[2][lane], 0.f},
+				  glm::vec4{columns[3][lane], columns[4][lane], columns[5][lane], 0.f},
+				  glm::vec4{columns[6][lane], columns[7][lane], columns[8][lane], 0.f},
+				  glm::vec4{columns[9][lane], columns[10][lane], columns[11][lane], 1.f},
+				};
+			}
+		}
+	}
+}  // namespace
+
+namespace MRG::Utils::Maths
+{
+	void TransformArrays::clear()
+	{
+		translationsX.clear();
+		translationsY.clear();
+		translationsZ.clear();
+		rotationsX.clear();
+		rotationsY.clear();
+		rotationsZ.clear();
+		scalesX.clear();
+		scalesY.clear();
+		scalesZ.clear();
+	}
+
+	void TransformArrays::reserve(std::size_t count)
+	{
+		translationsX.reserve(count);
+		translationsY.reserve(count);
+		translationsZ.reserve(count);
+		rotationsX.reserve(count);
+		rotationsY.reserve(count);
+		rotationsZ.reserve(count);
+		scalesX.reserve(count);
+		scalesY.reserve(count);
+		scalesZ.reserve(count);
+	}
+
+	void TransformArrays::push(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		translationsX.push_back(translation.x);
+		translationsY.push_back(translation.y);
+		translationsZ.push_back(translation.z);
+		rotationsX.push_back(rotation.x);
+		rotationsY.push_back(rotation.y);
+		rotationsZ.push_back(rotation.z);
+		scalesX.push_back(scale.x);
+		scalesY.push_back(scale.y);
+		scalesZ.push_back(scale.z);
+	}
+
+	void composeTransforms(const TransformArrays& transforms, std::span<glm::mat4> matrices)
+	{
+		const auto count = transforms.size();
+		MRG_ENGINE_ASSERT(matrices.size() >= count, "Not enough matrices for the transforms ({} < {})!", matrices.size(), count)
+
+		const auto vectorizedCount = count - count % VectorFloats::WIDTH;
+		composeRange<VectorFloats>(transforms, 0, vectorizedCount, matrices);
+		composeRange<ScalarFloats>(transforms, vectorizedCount, count, matrices);
+	}
+}  // namespace MRG::Utils::Maths
@@ -0,0 +1,37 @@
+#ifndef MORRIGU_UTILS_TRANSFORMCOMPOSITION_H
+#define MORRIGU_UTILS_TRANSFORMCOMPOSITION_H
+
+#include "Utils/GLMIncludeHelper.h"
+
+#include <span>
+#include <vector>
+
+namespace MRG::Utils::Maths
+{
+	// Translations, rotations (euler angles, in radians) and scales, stored as a structure of arrays so that they can be composed in
+	// batches
+	struct TransformArrays
+	{
+		std::vector<float> translationsX{};
+		std::vector<float> translationsY{};
+		std::vector<float> translationsZ{};
+		std::vector<float> rotationsX{};
+		std::vector<float> rotationsY{};
+		std::vector<float> rotationsZ{};
+		std::vector<float> scalesX{};
+		std::vector<float> scalesY{};
+		std::vector<float> scalesZ{};
+
+		void clear();
+		void reserve(std::size_t count);
+		void push(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+		[[nodiscard]] std::size_t size() const { return scalesZ.size(); }
+	};
+
+	// Writes translate(translation) * toMat4(quat(rotation)) * scale(scale) for every transform, in the order they were pushed (matrices
+	// must hold at least transforms.size() elements). Uses 8 wide vectors when the engine is compiled with AVX2 (see ENABLE_AVX2),
+	// 4 wide SSE vectors on other x86-64 targets, and scalar code elsewhere.
+	void composeTransforms(const TransformArrays& transforms, std::span<glm::mat4> matrices);
+}  // namespace MRG::Utils::Maths
+
+#endif  // MORRIGU_UTILS_TRANSFORMCOMPOSITION_H
@@ -10,9 +10,13 @@ namespace MRG
 	{
 		return application->renderer->createFrameBuffer(spec);
 	}
-	Ref<Texture> StandardLayer::createTexture(const std::string& filePath)
+	Ref<Texture> StandardLayer::createTexture(const std::string& filePath, SamplerPreset samplerPreset)
 	{
-		return application->renderer->createTexture(filePath.c_str());
+		return application->renderer->createTexture(filePath.c_str(), samplerPreset);
+	}
+	Ref<Texture> StandardLayer::createTextureAsync(const std::string& filePath, SamplerPreset samplerPreset)
+	{
+		return application->renderer->createTextureAsync(filePath.c_str(), samplerPreset);
 	}
 	Ref<Shader> StandardLayer::createShader(const std::string& vertexShaderFile, const std::string& fragmentShaderFile)
 	{
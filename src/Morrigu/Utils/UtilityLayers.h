@@ -20,7 +20,9 @@ namespace MRG
 		}
 
 		[[nodiscard]] Ref<Framebuffer> createFramebuffer(const FramebufferSpecification& spec);
-		[[nodiscard]] Ref<Texture> createTexture(const std::string& filePath);
+		[[nodiscard]] Ref<Texture> createTexture(const std::string& filePath, SamplerPreset samplerPreset = SamplerPreset::Anisotropic);
+		[[nodiscard]] Ref<Texture> createTextureAsync(const std::string& filePath,
+		                                              SamplerPreset samplerPreset = SamplerPreset::Anisotropic);
 		[[nodiscard]] Ref<Shader> createShader(const std::string& vertexShaderFile, const std::string& fragmentShaderFile);
 
 		template<Vertex VertexType>
@@ -29,6 +31,11 @@ namespace MRG
 			return application->renderer->createMaterial<VertexType>(shader, config);
 		}
 		template<Vertex VertexType>
+		[[nodiscard]] Ref<Material<VertexType>> createMaterialAsync(const Ref<Shader>& shader, const MaterialConfiguration& config = {})
+		{
+			return application->renderer->createMaterialAsync<VertexType>(shader, config);
+		}
+		template<Vertex VertexType>
 		[[nodiscard]] Components::MeshRenderer<VertexType>::VulkanObjects createMeshRenderer(const Ref<Mesh<VertexType>>& meshRef,
 		                                                                                     const Ref<Material<VertexType>>& materialRef)
 		{
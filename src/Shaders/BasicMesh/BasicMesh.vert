@@ -9,14 +9,14 @@ layout(push_constant) uniform CameraData {
     mat4 viewProjection;
 } pc_CameraData;
 
-layout(set = 3, binding = 0) uniform ModelData {
-    mat4 modelMatrix;
+layout(set = 3, binding = 0) readonly buffer ModelData {
+    mat4 modelMatrices[];
 } u_ModelData;
 
 layout(location = 0) out vec3 fs_Color;
 
 void main() {
-    mat4 transform = pc_CameraData.viewProjection * u_ModelData.modelMatrix;
+    mat4 transform = pc_CameraData.viewProjection * u_ModelData.modelMatrices[gl_InstanceIndex];
     gl_Position = transform * vec4(v_Position, 1.f);
     fs_Color = vec3(0.3, 0.3, 0.3);
 }
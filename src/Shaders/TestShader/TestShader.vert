@@ -10,14 +10,14 @@ layout(push_constant) uniform CameraData {
     mat4 viewProjectionMatrix;
 } pc_CameraData;
 
-layout(set = 3, binding = 0) uniform ModelData {
-    mat4 modelMatrix;
+layout(set = 3, binding = 0) readonly buffer ModelData {
+    mat4 modelMatrices[];
 } u_ModelData;
 
 layout(location = 0) out vec2 fs_UVPassThrough;
 
 void main() {
-    mat4 transform = pc_CameraData.viewProjectionMatrix * u_ModelData.modelMatrix;
+    mat4 transform = pc_CameraData.viewProjectionMatrix * u_ModelData.modelMatrices[gl_InstanceIndex];
     gl_Position = transform * vec4(v_Position, 1);
     fs_UVPassThrough = v_UV;
 }
@@ -1,9 +1,16 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec2 vs_UV;
 
-layout(set = 3, binding = 1) uniform sampler2D u_Texture;
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+layout(set = 3, binding = 1) uniform TextureData
+{
+	uint textureIndex;
+}
+u_TextureData;
 
 layout(location = 0) out vec4 f_Color;
 
-void main() { f_Color = texture(u_Texture, vs_UV); }
+void main() { f_Color = texture(u_Textures[nonuniformEXT(u_TextureData.textureIndex)], vs_UV); }
@@ -0,0 +1,289 @@
+#include "Testing.h"
+
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using Texel = std::array<uint32_t, 4>;
+
+	// Reference decoders, written after the format specifications rather than the encoders
+	// (https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html#S3TC and #BPTC)
+	[[nodiscard]] uint64_t readBits(const std::byte* block, uint32_t byteCount)
+	{
+		uint64_t bits = 0;
+		for (uint32_t byte = 0; byte < byteCount; ++byte) { bits |= std::to_integer<uint64_t>(block[byte]) << (8 * byte); }
+		return bits;
+	}
+
+	[[nodiscard]] Texel decodeRGB565(uint32_t value)
+	{
+		const auto red   = (value >> 11) & 31;
+		const auto green = (value >> 5) & 63;
+		const auto blue  = value & 31;
+		return {(red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2), 255};
+	}
+
+	[[nodiscard]] std::array<Texel, 16> decodeBC1Block(const std::byte* block)
+	{
+		const auto color0 = static_cast<uint32_t>(readBits(block, 2));
+		const auto color1 = static_cast<uint32_t>(readBits(block + 2, 2));
+		const auto c0     = decodeRGB565(color0);
+		const auto c1     = decodeRGB565(color1);
+
+		std::array<Texel, 4> palette{c0, c1};
+		for (std::size_t channel = 0; channel < 3; ++channel) {
+			if (color0 > color1) {
+				palette[2][channel] = (2 * c0[channel] + c1[channel]) / 3;
+				palette[3][channel] = (c0[channel] + 2 * c1[channel]) / 3;
+			} else {
+				palette[2][channel] = (c0[channel] + c1[channel]) / 2;
+				palette[3][channel] = 0;
+			}
+		}
+		palette[2][3] = 255;
+		palette[3][3] = (color0 > color1) ? 255 : 0;
+
+		const auto indices = readBits(block + 4, 4);
+		std::array<Texel, 16> texels{};
+		for (std::size_t texel = 0; texel < texels.size(); ++texel) { texels[texel] = palette[(indices >> (2 * texel)) & 3]; }
+		return texels;
+	}
+
+	[[nodiscard]] std::array<uint32_t, 16> decodeBC4Block(const std::byte* block)
+	{
+		const auto value0 = std::to_integer<uint32_t>(block[0]);
+		const auto value1 = std::to_integer<uint32_t>(block[1]);
+
+		std::array<uint32_t, 8> palette{value0, value1};
+		if (value0 > value1) {
+			for (uint32_t step = 1; step < 7; ++step) { palette[step + 1] = ((7 - step) * value0 + step * value1) / 7; }
+		} else {
+			for (uint32_t step = 1; step < 5; ++step) { palette[step + 1] = ((5 - step) * value0 + step * value1) / 5; }
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		const auto indices = readBits(block + 2, 6);
+		std::array<uint32_t, 16> values{};
+		for (std::size_t texel = 0; texel < values.size(); ++texel) { values[texel] = palette[(indices >> (3 * texel)) & 7]; }
+		return values;
+	}
+
+	class BitReader
+	{
+	public:
+		explicit BitReader(const std::byte* block) : m_block{block} {}
+
+		[[nodiscard]] uint32_t read(uint32_t bitCount)
+		{
+			uint32_t value = 0;
+			for (uint32_t bit = 0; bit < bitCount; ++bit, ++m_position) {
+				value |= ((std::to_integer<uint32_t>(m_block[m_position / 8]) >> (m_position % 8)) & 1) << bit;
+			}
+			return value;
+		}
+
+	private:
+		const std::byte* m_block;
+		uint32_t m_position{0};
+	};
+
+	// Only mode 6, the one the encoder uses. Returns an empty optional for other modes.
+	[[nodiscard]] std::optional<std::array<Texel, 16>> decodeBC7Block(const std::byte* block)
+	{
+		static constexpr std::array<uint32_t, 16> weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		BitReader reader{block};
+		if (reader.read(7) != (1 << 6)) { return std::nullopt; }
+
+		std::array<Texel, 2> endpoints{};
+		for (std::size_t channel = 0; channel < 4; ++channel) {
+			endpoints[0][channel] = reader.read(7);
+			endpoints[1][channel] = reader.read(7);
+		}
+		for (auto& endpoint : endpoints) {
+			const auto pBit = reader.read(1);
+			for (auto& value : endpoint) { value = (value << 1) | pBit; }
+		}
+
+		std::array<Texel, 16> texels{};
+		for (std::size_t texel = 0; texel < texels.size(); ++texel) {
+			const auto weight = weights[reader.read(texel == 0 ? 3 : 4)];
+			for (std::size_t channel = 0; channel < 4; ++channel) {
+				texels[texel][channel] = (endpoints[0][channel] * (64 - weight) + endpoints[1][channel] * weight + 32) >> 6;
+			}
+		}
+		return texels;
+	}
+
+	struct Image
+	{
+		uint32_t width;
+		uint32_t height;
+		std::vector<std::byte> pixels;
+
+		[[nodiscard]] uint32_t get(uint32_t x, uint32_t y, std::size_t channel) const
+		{
+			return std::to_integer<uint32_t>(pixels[(static_cast<std::size_t>(y) * width + x) * 4 + channel]);
+		}
+	};
+
+	[[nodiscard]] Image createImage(uint32_t width, uint32_t height, auto&& getTexel)
+	{
+		Image image{.width = width, .height = height, .pixels = std::vector<std::byte>(static_cast<std::size_t>(width) * height * 4)};
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				const Texel texel = getTexel(x, y);
+				for (std::size_t channel = 0; channel < 4; ++channel) {
+					image.pixels[(static_cast<std::size_t>(y) * width + x) * 4 + channel] = static_cast<std::byte>(texel[channel]);
+				}
+			}
+		}
+		return image;
+	}
+
+	// Smooth gradients on every channel, with a different direction for each of them
+	[[nodiscard]] Image createGradient(uint32_t width, uint32_t height)
+	{
+		return createImage(width, height, [width, height](uint32_t x, uint32_t y) {
+			return Texel{x * 255 / (width - 1), y * 255 / (height - 1), (x + y) * 255 / (width + height - 2), 255 - y * 255 / (height - 1)};
+		});
+	}
+
+	struct ErrorStatistics
+	{
+		uint32_t maxError{0};
+		double meanError{0.};
+	};
+
+	// Compares every texel of the image with the decoded blocks, on the given channels. decodeBlock returns the 16 decoded values of a
+	// channel of a block.
+	[[nodiscard]] ErrorStatistics measureError(const Image& image,
+	                                           std::span<const std::byte> compressed,
+	                                           std::size_t blockSize,
+	                                           std::span<const std::size_t> channels,
+	                                           auto&& decodeBlock)
+	{
+		const auto blocksX = (image.width + 3) / 4;
+
+		ErrorStatistics statistics{};
+		for (uint32_t y = 0; y < image.height; ++y) {
+			for (uint32_t x = 0; x < image.width; ++x) {
+				const auto* block = compressed.data() + ((y / 4) * blocksX + x / 4) * blockSize;
+				for (const auto channel : channels) {
+					const auto decoded  = static_cast<int>(decodeBlock(block, channel)[(y % 4) * 4 + x % 4]);
+					const auto expected = static_cast<int>(image.get(x, y, channel));
+					const auto error    = static_cast<uint32_t>(std::abs(decoded - expected));
+					statistics.maxError = std::max(statistics.maxError, error);
+					statistics.meanError += static_cast<double>(error);
+				}
+			}
+		}
+		statistics.meanError /= static_cast<double>(static_cast<std::size_t>(image.width) * image.height * channels.size());
+
+		return statistics;
+	}
+
+	constexpr std::array<std::size_t, 3> rgbChannels{0, 1, 2};
+	constexpr std::array<std::size_t, 2> rgChannels{0, 1};
+	constexpr std::array<std::size_t, 4> rgbaChannels{0, 1, 2, 3};
+
+	[[nodiscard]] ErrorStatistics measureBC1Error(const Image& image)
+	{
+		const auto compressed = BlockCompression::compressBC1(image.pixels, image.width, image.height);
+		return measureError(image, compressed, 8, rgbChannels, [](const std::byte* block, std::size_t channel) {
+			std::array<uint32_t, 16> values{};
+			const auto texels = decodeBC1Block(block);
+			for (std::size_t texel = 0; texel < values.size(); ++texel) { values[texel] = texels[texel][channel]; }
+			return values;
+		});
+	}
+
+	[[nodiscard]] ErrorStatistics measureBC5Error(const Image& image)
+	{
+		const auto compressed = BlockCompression::compressBC5(image.pixels, image.width, image.height);
+		return measureError(image, compressed, 16, rgChannels, [](const std::byte* block, std::size_t channel) {
+			return decodeBC4Block(block + 8 * channel);
+		});
+	}
+
+	[[nodiscard]] ErrorStatistics measureBC7Error(const Image& image)
+	{
+		const auto compressed = BlockCompression::compressBC7(image.pixels, image.width, image.height);
+		return measureError(image, compressed, 16, rgbaChannels, [](const std::byte* block, std::size_t channel) {
+			std::array<uint32_t, 16> values{};
+			const auto texels = decodeBC7Block(block);
+			// Any other mode is an error, reported as the biggest one possible
+			values.fill(texels.has_value() ? 0 : 1000);
+			if (texels.has_value()) {
+				for (std::size_t texel = 0; texel < values.size(); ++texel) { values[texel] = texels.value()[texel][channel]; }
+			}
+			return values;
+		});
+	}
+}  // namespace
+
+MRG_TEST(blockCompressionSizes)
+{
+	// Edge blocks are partially used when the size is not a multiple of 4
+	const auto image = createGradient(6, 5);
+	MRG_CHECK(BlockCompression::compressBC1(image.pixels, image.width, image.height).size() == 2 * 2 * 8)
+	MRG_CHECK(BlockCompression::compressBC5(image.pixels, image.width, image.height).size() == 2 * 2 * 16)
+	MRG_CHECK(BlockCompression::compressBC7(image.pixels, image.width, image.height).size() == 2 * 2 * 16)
+
+	const auto pixel = createGradient(2, 2);
+	MRG_CHECK(BlockCompression::compressBC7(pixel.pixels, 1, 1).size() == 16)
+}
+
+MRG_TEST(blockCompressionSolidColors)
+{
+	for (const auto& color : {Texel{0, 0, 0, 255}, Texel{255, 255, 255, 255}, Texel{200, 100, 50, 128}, Texel{13, 77, 211, 0}}) {
+		const auto image = createImage(8, 8, [&color](uint32_t, uint32_t) { return color; });
+
+		// RGB565 endpoints lose up to 3 bits per channel
+		MRG_CHECK(measureBC1Error(image).maxError <= 4)
+		MRG_CHECK(measureBC5Error(image).maxError == 0)
+		// Endpoints have 7 bits per channel, and a lowest bit shared by all of them
+		MRG_CHECK(measureBC7Error(image).maxError <= 1)
+	}
+}
+
+MRG_TEST(blockCompressionTwoColors)
+{
+	// Checkerboard of two colors: both are endpoints, so only their quantisation matters
+	const Texel dark{20, 40, 60, 30};
+	const Texel light{230, 200, 180, 250};
+	const auto image = createImage(16, 16, [&dark, &light](uint32_t x, uint32_t y) { return ((x + y) % 2 == 0) ? dark : light; });
+
+	MRG_CHECK(measureBC1Error(image).maxError <= 4)
+	MRG_CHECK(measureBC5Error(image).maxError == 0)
+	MRG_CHECK(measureBC7Error(image).maxError <= 1)
+}
+
+MRG_TEST(blockCompressionGradients)
+{
+	for (const auto& [width, height] : {std::pair{64u, 64u}, std::pair{37u, 23u}}) {
+		const auto image = createGradient(width, height);
+
+		// Bounds measured on the current encoders with some margin, to catch broken encoders rather than slightly worse ones
+		const auto bc1Error = measureBC1Error(image);
+		MRG_CHECK(bc1Error.maxError <= 24)
+		MRG_CHECK(bc1Error.meanError <= 6.)
+
+		const auto bc5Error = measureBC5Error(image);
+		MRG_CHECK(bc5Error.maxError <= 4)
+		MRG_CHECK(bc5Error.meanError <= 1.)
+
+		const auto bc7Error = measureBC7Error(image);
+		MRG_CHECK(bc7Error.maxError <= 20)
+		MRG_CHECK(bc7Error.meanError <= 4.5)
+	}
+}
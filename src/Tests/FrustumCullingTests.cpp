@@ -0,0 +1,109 @@
+#include "Testing.h"
+
+#include "Rendering/FrustumCulling.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	// 90 degrees vertical field of view, square aspect ratio: the side planes are at 45 degrees from the view direction
+	[[nodiscard]] glm::mat4 createViewProjection(const glm::vec3& cameraPosition)
+	{
+		const auto projection = glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+		const auto view       = glm::lookAt(cameraPosition, cameraPosition + glm::vec3{0.f, 0.f, -1.f}, glm::vec3{0.f, 1.f, 0.f});
+		return projection * view;
+	}
+
+	[[nodiscard]] float getDistance(const glm::vec4& plane, const glm::vec3& point) { return glm::dot(glm::vec3{plane}, point) + plane.w; }
+
+	[[nodiscard]] bool isClose(float lhs, float rhs, float tolerance) { return std::abs(lhs - rhs) <= tolerance; }
+
+	[[nodiscard]] MRG::CullingSpheres createSpheres(const std::vector<glm::vec4>& spheres)
+	{
+		MRG::CullingSpheres cullingSpheres{};
+		for (const auto& sphere : spheres) {
+			cullingSpheres.push(MRG::BoundingSphere{.center = glm::vec3{sphere}, .radius = sphere.w}, glm::mat4{1.f});
+		}
+
+		return cullingSpheres;
+	}
+}  // namespace
+
+MRG_TEST(frustumPlaneExtraction)
+{
+	const auto frustum = MRG::Frustum::fromViewProjection(createViewProjection(glm::vec3{0.f}));
+
+	for (const auto& plane : frustum.planes) { MRG_CHECK(isClose(glm::length(glm::vec3{plane}), 1.f, 1e-4f)) }
+
+	// Left, right, bottom, top, near, far
+	const auto& planes = frustum.planes;
+	MRG_CHECK(isClose(getDistance(planes[0], glm::vec3{-10.f, 0.f, -10.f}), 0.f, 1e-3f))
+	MRG_CHECK(isClose(getDistance(planes[1], glm::vec3{10.f, 0.f, -10.f}), 0.f, 1e-3f))
+	MRG_CHECK(isClose(getDistance(planes[2], glm::vec3{0.f, -10.f, -10.f}), 0.f, 1e-3f))
+	MRG_CHECK(isClose(getDistance(planes[3], glm::vec3{0.f, 10.f, -10.f}), 0.f, 1e-3f))
+	MRG_CHECK(isClose(getDistance(planes[4], glm::vec3{0.f, 0.f, -0.1f}), 0.f, 1e-3f))
+	MRG_CHECK(isClose(getDistance(planes[5], glm::vec3{0.f, 0.f, -100.f}), 0.f, 5e-2f))
+
+	// Normals point inside
+	for (const auto& plane : planes) { MRG_CHECK(getDistance(plane, glm::vec3{0.f, 0.f, -50.f}) > 0.f) }
+	MRG_CHECK(isClose(getDistance(planes[4], glm::vec3{0.f, 0.f, -10.1f}), 10.f, 1e-3f))
+}
+
+MRG_TEST(frustumSphereCulling)
+{
+	const auto frustum = MRG::Frustum::fromViewProjection(createViewProjection(glm::vec3{0.f}));
+	const auto spheres = createSpheres({
+	  {0.f, 0.f, -10.f, 1.f},     // In front of the camera
+	  {0.f, 0.f, 10.f, 1.f},      // Behind the camera
+	  {0.f, 0.f, 0.5f, 1.f},      // Crossing the near plane
+	  {0.f, 0.f, -150.f, 1.f},    // Past the far plane
+	  {0.f, 0.f, -100.5f, 1.f},   // Crossing the far plane
+	  {-10.5f, 0.f, -10.f, 1.f},  // Crossing the left plane
+	  {-13.f, 0.f, -10.f, 1.f},   // Left of the frustum
+	  {0.f, 13.f, -10.f, 1.f},    // Above the frustum
+	  {0.f, -13.f, -10.f, 1.f},   // Below the frustum
+	  {0.f, 0.f, 50.f, 100.f},    // Containing the whole frustum
+	});
+
+	std::vector<uint32_t> visibility{};
+	const auto visibleCount = MRG::cullSpheres(frustum, spheres, visibility);
+
+	MRG_CHECK((visibility == std::vector<uint32_t>{1, 0, 1, 0, 1, 1, 0, 0, 0, 1}))
+	MRG_CHECK(visibleCount == 5)
+}
+
+MRG_TEST(frustumWorldSpaceCulling)
+{
+	// The planes are in world space, so a moved camera sees different spheres
+	const auto frustum = MRG::Frustum::fromViewProjection(createViewProjection(glm::vec3{10.f, 0.f, 0.f}));
+	const auto spheres = createSpheres({
+	  {10.f, 0.f, -10.f, 1.f},
+	  {-5.f, 0.f, -10.f, 1.f},
+	});
+
+	std::vector<uint32_t> visibility{};
+	MRG_CHECK(MRG::cullSpheres(frustum, spheres, visibility) == 1)
+	MRG_CHECK((visibility == std::vector<uint32_t>{1, 0}))
+
+	MRG::CullingSpheres noSpheres{};
+	MRG_CHECK(MRG::cullSpheres(frustum, noSpheres, visibility) == 0)
+	MRG_CHECK(visibility.empty())
+}
+
+MRG_TEST(cullingSpheresTransform)
+{
+	MRG::CullingSpheres spheres{};
+	const auto transform = glm::scale(glm::translate(glm::mat4{1.f}, glm::vec3{0.f, 5.f, 0.f}), glm::vec3{1.f, 3.f, 2.f});
+	spheres.push(MRG::BoundingSphere{.center = glm::vec3{1.f, 0.f, 0.f}, .radius = 2.f}, transform);
+
+	MRG_CHECK(spheres.size() == 1)
+	MRG_CHECK(isClose(spheres.centersX[0], 1.f, 1e-5f))
+	MRG_CHECK(isClose(spheres.centersY[0], 5.f, 1e-5f))
+	MRG_CHECK(isClose(spheres.centersZ[0], 0.f, 1e-5f))
+	// Scaled by the biggest scale of the transform
+	MRG_CHECK(isClose(spheres.radii[0], 6.f, 1e-5f))
+
+	spheres.clear();
+	MRG_CHECK(spheres.size() == 0)
+}
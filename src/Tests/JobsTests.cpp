@@ -0,0 +1,138 @@
+#include "Testing.h"
+
+#include "Core/Jobs.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	// Every test gets its own pool, so that a failing one does not leave jobs behind for the next ones
+	class JobSystem
+	{
+	public:
+		JobSystem() { MRG::Jobs::init(4); }
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(JobSystem&&)      = delete;
+		~JobSystem() { MRG::Jobs::shutdown(); }
+
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+	};
+
+	void splitRecursively(std::size_t count, MRG::JobCounter& counter, std::atomic<std::size_t>& executedJobs)
+	{
+		if (count <= 1) {
+			executedJobs.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		const auto half = count / 2;
+		MRG::Jobs::run([half, &counter, &executedJobs]() { splitRecursively(half, counter, executedJobs); }, &counter);
+		splitRecursively(count - half, counter, executedJobs);
+	}
+}  // namespace
+
+MRG_TEST(jobsCounter)
+{
+	JobSystem jobSystem{};
+	MRG_CHECK(MRG::Jobs::getThreadCount() == 4)
+
+	MRG::JobCounter counter{};
+	MRG_CHECK(counter.isDone())
+
+	std::atomic<std::size_t> executedJobs{0};
+	for (std::size_t job = 0; job < 1000; ++job) {
+		MRG::Jobs::run([&executedJobs]() { executedJobs.fetch_add(1, std::memory_order_relaxed); }, &counter);
+	}
+	MRG::Jobs::wait(counter);
+	MRG_CHECK(counter.isDone())
+	MRG_CHECK(executedJobs.load() == 1000)
+
+	// Counters can be reused once waited on, and jobs can spawn more jobs on the counter they run with
+	executedJobs = 0;
+	MRG::Jobs::run([&counter, &executedJobs]() { splitRecursively(5000, counter, executedJobs); }, &counter);
+	MRG::Jobs::wait(counter);
+	MRG_CHECK(executedJobs.load() == 5000)
+}
+
+MRG_TEST(jobsContinuations)
+{
+	JobSystem jobSystem{};
+
+	MRG::JobCounter dependency{};
+	std::vector<std::atomic<uint32_t>> values(256);
+	for (std::size_t index = 0; index < values.size(); ++index) {
+		MRG::Jobs::run([&values, index]() { values[index].store(1, std::memory_order_relaxed); }, &dependency);
+	}
+
+	// The continuation must see every write of the jobs it depends on
+	MRG::JobCounter counter{};
+	std::atomic<uint32_t> seenValues{0};
+	MRG::Jobs::runAfter(
+	  dependency,
+	  [&values, &seenValues]() {
+		  for (const auto& value : values) { seenValues.fetch_add(value.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+	  },
+	  &counter);
+	MRG::Jobs::wait(counter);
+	MRG_CHECK(dependency.isDone())
+	MRG_CHECK(seenValues.load() == values.size())
+
+	// A continuation of a counter that is already done runs right away
+	std::atomic<bool> hasRun{false};
+	MRG::Jobs::runAfter(dependency, [&hasRun]() { hasRun = true; }, &counter);
+	MRG::Jobs::wait(counter);
+	MRG_CHECK(hasRun.load())
+
+	// Continuations can be chained
+	std::vector<uint32_t> order{};
+	MRG::JobCounter first{};
+	MRG::JobCounter second{};
+	MRG::Jobs::run([&order]() { order.push_back(0); }, &first);
+	MRG::Jobs::runAfter(first, [&order]() { order.push_back(1); }, &second);
+	MRG::Jobs::runAfter(second, [&order]() { order.push_back(2); }, &counter);
+	MRG::Jobs::wait(counter);
+	MRG_CHECK((order == std::vector<uint32_t>{0, 1, 2}))
+}
+
+MRG_TEST(jobsExceptions)
+{
+	JobSystem jobSystem{};
+
+	MRG::JobCounter counter{};
+	std::atomic<std::size_t> executedJobs{0};
+	for (std::size_t job = 0; job < 100; ++job) {
+		MRG::Jobs::run(
+		  [&executedJobs, job]() {
+			  if (job == 50) { throw std::runtime_error{"Job failure"}; }
+			  executedJobs.fetch_add(1, std::memory_order_relaxed);
+		  },
+		  &counter);
+	}
+
+	bool hasThrown = false;
+	try {
+		MRG::Jobs::wait(counter);
+	} catch (const std::runtime_error&) { hasThrown = true; }
+	MRG_CHECK(hasThrown)
+	// The other jobs still ran
+	MRG_CHECK(executedJobs.load() == 99)
+
+	// The exception is only rethrown once
+	MRG::Jobs::run([]() {}, &counter);
+	MRG::Jobs::wait(counter);
+}
+
+MRG_TEST(jobsParallelFor)
+{
+	JobSystem jobSystem{};
+
+	std::vector<std::size_t> values(10000, 0);
+	MRG::Jobs::parallelFor(values.size(), 64, [&values](std::size_t index) { values[index] += index * 2; });
+
+	bool isValid = true;
+	for (std::size_t index = 0; index < values.size(); ++index) { isValid &= (values[index] == index * 2); }
+	MRG_CHECK(isValid)
+}
@@ -0,0 +1,228 @@
+#include "Testing.h"
+
+#include "Utils/Meshes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+	// Relative to MRG::Folders::Rendering::meshesFolder
+	const char* const testCubePath = "tests/cube.obj";
+	const char* const testCookedPath = "tests/cooked.obj";
+
+	// Unit cube with one normal per face, so that each of its 8 corners is shared by 3 faces with different normals
+	const std::array<glm::vec3, 8> cubePositions{
+	  glm::vec3{0.f, 0.f, 0.f},
+	  glm::vec3{1.f, 0.f, 0.f},
+	  glm::vec3{1.f, 1.f, 0.f},
+	  glm::vec3{0.f, 1.f, 0.f},
+	  glm::vec3{0.f, 0.f, 1.f},
+	  glm::vec3{1.f, 0.f, 1.f},
+	  glm::vec3{1.f, 1.f, 1.f},
+	  glm::vec3{0.f, 1.f, 1.f},
+	};
+	const std::array<glm::vec3, 6> cubeNormals{
+	  glm::vec3{1.f, 0.f, 0.f},
+	  glm::vec3{-1.f, 0.f, 0.f},
+	  glm::vec3{0.f, 1.f, 0.f},
+	  glm::vec3{0.f, -1.f, 0.f},
+	  glm::vec3{0.f, 0.f, 1.f},
+	  glm::vec3{0.f, 0.f, -1.f},
+	};
+	// Position indices of the quad facing each normal, split in two triangles when written
+	const std::array<std::array<std::size_t, 4>, 6> cubeFaces{{
+	  {1, 2, 6, 5},
+	  {0, 4, 7, 3},
+	  {3, 7, 6, 2},
+	  {0, 1, 5, 4},
+	  {4, 5, 6, 7},
+	  {0, 3, 2, 1},
+	}};
+
+	struct FaceCorner
+	{
+		std::size_t position;
+		std::size_t normal;
+	};
+
+	[[nodiscard]] std::vector<FaceCorner> getCubeCorners()
+	{
+		static constexpr std::array<std::size_t, 6> triangleCorners{0, 1, 2, 0, 2, 3};
+
+		std::vector<FaceCorner> corners{};
+		for (std::size_t face = 0; face < cubeFaces.size(); ++face) {
+			for (const auto corner : triangleCorners) { corners.push_back(FaceCorner{cubeFaces[face][corner], face}); }
+		}
+		return corners;
+	}
+
+	void writeCube(const std::vector<FaceCorner>& corners)
+	{
+		const auto path = MRG::Folders::Rendering::meshesFolder + testCubePath;
+		std::filesystem::create_directories(std::filesystem::path{path}.parent_path());
+
+		std::ofstream file{path, std::ios::trunc};
+		for (const auto& position : cubePositions) { file << "v " << position.x << ' ' << position.y << ' ' << position.z << '\n'; }
+		for (const auto& normal : cubeNormals) { file << "vn " << normal.x << ' ' << normal.y << ' ' << normal.z << '\n'; }
+		// OBJ indices start at 1
+		for (std::size_t corner = 0; corner < corners.size(); corner += 3) {
+			file << 'f';
+			for (std::size_t vertex = corner; vertex < corner + 3; ++vertex) {
+				file << ' ' << corners[vertex].position + 1 << "//" << corners[vertex].normal + 1;
+			}
+			file << '\n';
+		}
+	}
+
+	[[nodiscard]] MRG::Mesh<MRG::BasicVertex> createCookingTestMesh()
+	{
+		MRG::Mesh<MRG::BasicVertex> mesh{};
+		for (std::size_t vertex = 0; vertex < cubePositions.size(); ++vertex) {
+			const auto& normal = cubeNormals[vertex % cubeNormals.size()];
+			mesh.vertices.push_back(MRG::BasicVertex{.position = cubePositions[vertex], .normal = normal});
+		}
+		for (const auto& face : cubeFaces) {
+			for (const auto corner : {face[0], face[1], face[2], face[0], face[2], face[3]}) {
+				mesh.indices.push_back(static_cast<uint32_t>(corner));
+			}
+		}
+		return mesh;
+	}
+
+	[[nodiscard]] std::vector<char> readFile(const std::string& path)
+	{
+		std::ifstream file{path, std::ios::binary};
+		return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	}
+
+	void writeFile(const std::string& path, const std::vector<char>& content)
+	{
+		std::ofstream file{path, std::ios::binary | std::ios::trunc};
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	template<typename T>
+	void patchFile(std::vector<char> content, std::size_t offset, const T& value, const std::string& path)
+	{
+		std::memcpy(content.data() + offset, &value, sizeof(value));
+		writeFile(path, content);
+	}
+}  // namespace
+
+MRG_TEST(objVertexDeduplication)
+{
+	const auto corners = getCubeCorners();
+	writeCube(corners);
+
+	const auto mesh = MRG::Utils::Meshes::loadMeshFromFile<MRG::BasicVertex>(testCubePath);
+	std::filesystem::remove(MRG::Folders::Rendering::meshesFolder + testCubePath);
+
+	// Each corner is stored once per face it belongs to
+	MRG_CHECK(mesh->vertices.size() == cubeFaces.size() * 4)
+	MRG_CHECK(mesh->indices.size() == corners.size())
+	if (mesh->indices.size() != corners.size()) { return; }
+
+	for (std::size_t vertex = 0; vertex < mesh->vertices.size(); ++vertex) {
+		for (std::size_t other = vertex + 1; other < mesh->vertices.size(); ++other) {
+			MRG_CHECK(mesh->vertices[vertex].position != mesh->vertices[other].position ||
+			          mesh->vertices[vertex].normal != mesh->vertices[other].normal)
+		}
+	}
+
+	// The indices rebuild the original faces
+	for (std::size_t corner = 0; corner < corners.size(); ++corner) {
+		const auto index = mesh->indices[corner];
+		MRG_CHECK(index < mesh->vertices.size())
+		if (index >= mesh->vertices.size()) { continue; }
+
+		MRG_CHECK(mesh->vertices[index].position == cubePositions[corners[corner].position])
+		MRG_CHECK(mesh->vertices[index].normal == cubeNormals[corners[corner].normal])
+	}
+}
+
+MRG_TEST(cookedMeshRoundTrip)
+{
+	using MRG::Utils::Meshes::CookedMeshHeader;
+
+	const auto mesh       = createCookingTestMesh();
+	const auto cookedPath = MRG::Utils::Meshes::getCookedMeshPath(testCookedPath);
+	MRG_CHECK(MRG::Utils::Meshes::cookMesh(mesh, cookedPath))
+
+	{
+		const auto cookedMesh = MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath);
+		MRG_CHECK(cookedMesh.has_value())
+		if (!cookedMesh.has_value()) { return; }
+
+		MRG_CHECK(cookedMesh->header.vertexCount == mesh.vertices.size())
+		MRG_CHECK(cookedMesh->header.indexCount == mesh.indices.size())
+		MRG_CHECK(cookedMesh->vertexData.size() == mesh.vertices.size() * sizeof(MRG::BasicVertex))
+		MRG_CHECK(cookedMesh->indexData.size() == mesh.indices.size() * sizeof(uint32_t))
+		if (cookedMesh->vertexData.size() == mesh.vertices.size() * sizeof(MRG::BasicVertex)) {
+			MRG_CHECK(std::memcmp(cookedMesh->vertexData.data(), mesh.vertices.data(), cookedMesh->vertexData.size()) == 0)
+		}
+		if (cookedMesh->indexData.size() == mesh.indices.size() * sizeof(uint32_t)) {
+			MRG_CHECK(std::memcmp(cookedMesh->indexData.data(), mesh.indices.data(), cookedMesh->indexData.size()) == 0)
+		}
+	}
+
+	// Files produced by another cooker version, or for another vertex layout, are ignored
+	const auto content = readFile(cookedPath);
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::ColoredVertex>(testCookedPath).has_value())
+
+	patchFile(content, offsetof(CookedMeshHeader, magic), std::array<char, 4>{'M', 'R', 'G', 'X'}, cookedPath);
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	patchFile(content, offsetof(CookedMeshHeader, version), CookedMeshHeader::currentVersion + 1, cookedPath);
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	patchFile(content, offsetof(CookedMeshHeader, vertexLayoutHash), ~MRG::BasicVertex::getVertexDescription().getLayoutHash(), cookedPath);
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	// So are files whose body does not match the header
+	writeFile(cookedPath, std::vector<char>(content.begin(), content.end() - 1));
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	writeFile(cookedPath, std::vector<char>(content.begin(), content.begin() + static_cast<std::ptrdiff_t>(sizeof(CookedMeshHeader)) - 1));
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	auto oversizedContent = content;
+	oversizedContent.push_back(0);
+	writeFile(cookedPath, oversizedContent);
+	MRG_CHECK(!MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath).has_value())
+
+	std::filesystem::remove(cookedPath);
+}
+
+MRG_TEST(cookedMeshWithoutIndices)
+{
+	auto mesh = createCookingTestMesh();
+	mesh.indices.clear();
+
+	const auto cookedPath = MRG::Utils::Meshes::getCookedMeshPath(testCookedPath);
+	MRG_CHECK(MRG::Utils::Meshes::cookMesh(mesh, cookedPath))
+
+	{
+		// Meshes are cooked as a plain triangle list
+		const auto cookedMesh = MRG::Utils::Meshes::loadCookedMesh<MRG::BasicVertex>(testCookedPath);
+		MRG_CHECK(cookedMesh.has_value())
+		if (!cookedMesh.has_value()) { return; }
+
+		const auto expectedIndices = MRG::Utils::Meshes::makeTriangleListIndices(mesh.vertices.size());
+		MRG_CHECK(cookedMesh->header.indexCount == mesh.vertices.size())
+		MRG_CHECK(cookedMesh->indexData.size() == expectedIndices.size() * sizeof(uint32_t))
+		if (cookedMesh->indexData.size() == expectedIndices.size() * sizeof(uint32_t)) {
+			MRG_CHECK(std::memcmp(cookedMesh->indexData.data(), expectedIndices.data(), cookedMesh->indexData.size()) == 0)
+		}
+	}
+
+	// Empty meshes cannot be cooked at all
+	MRG_CHECK(!MRG::Utils::Meshes::cookMesh(MRG::Mesh<MRG::BasicVertex>{}, cookedPath))
+
+	std::filesystem::remove(cookedPath);
+}
@@ -0,0 +1,77 @@
+#include "Testing.h"
+
+#include "Rendering/RenderQueue.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+MRG_TEST(renderQueueKeyLayout)
+{
+	MRG_CHECK(MRG::RenderQueue::makeKey(1, 2, 3, 0.f) == ((uint64_t{1} << 48) | (uint64_t{2} << 32) | (uint64_t{3} << 16)))
+	// Negative depths are clamped to 0
+	MRG_CHECK(MRG::RenderQueue::makeKey(1, 2, 3, -5.f) == MRG::RenderQueue::makeKey(1, 2, 3, 0.f))
+
+	// Pipelines first, then materials, then meshes, then depth
+	MRG_CHECK(MRG::RenderQueue::makeKey(1, 0, 0, 0.f) > MRG::RenderQueue::makeKey(0, 0xFFFF, 0xFFFF, 1000.f))
+	MRG_CHECK(MRG::RenderQueue::makeKey(0, 1, 0, 0.f) > MRG::RenderQueue::makeKey(0, 0, 0xFFFF, 1000.f))
+	MRG_CHECK(MRG::RenderQueue::makeKey(0, 0, 1, 0.f) > MRG::RenderQueue::makeKey(0, 0, 0, 1000.f))
+
+	// Front to back
+	float previousDepth = 0.f;
+	for (const auto depth : {0.01f, 0.5f, 1.f, 2.f, 10.f, 100.f, 10000.f}) {
+		MRG_CHECK(MRG::RenderQueue::makeKey(0, 0, 0, depth) > MRG::RenderQueue::makeKey(0, 0, 0, previousDepth))
+		previousDepth = depth;
+	}
+}
+
+MRG_TEST(renderQueueSortIDs)
+{
+	MRG::RenderQueue queue{};
+	const int first  = 0;
+	const int second = 0;
+
+	MRG_CHECK(queue.getSortID(&first) == 0)
+	MRG_CHECK(queue.getSortID(&second) == 1)
+	MRG_CHECK(queue.getSortID(&first) == 0)
+
+	queue.clear();
+	MRG_CHECK(queue.getSortID(&second) == 0)
+}
+
+MRG_TEST(renderQueueSort)
+{
+	MRG::RenderQueue queue{};
+	std::mt19937_64 generator{42};
+	std::vector<MRG::RenderQueue::Item> expected{};
+
+	// Few different values per digit, so that many keys are equal and the sort has to be stable
+	for (uint32_t index = 0; index < 5000; ++index) {
+		const auto key = MRG::RenderQueue::makeKey(static_cast<uint16_t>(generator() % 3),
+		                                           static_cast<uint16_t>(generator() % 300),
+		                                           static_cast<uint16_t>(generator() % 4),
+		                                           static_cast<float>(generator() % 8));
+		queue.push(key, index);
+		expected.push_back(MRG::RenderQueue::Item{.key = key, .index = index});
+	}
+	queue.sort();
+	std::ranges::stable_sort(expected, {}, &MRG::RenderQueue::Item::key);
+
+	const auto items = queue.getItems();
+	MRG_CHECK(items.size() == expected.size())
+	MRG_CHECK(std::ranges::equal(items, expected, [](const MRG::RenderQueue::Item& lhs, const MRG::RenderQueue::Item& rhs) {
+		return lhs.key == rhs.key && lhs.index == rhs.index;
+	}))
+}
+
+MRG_TEST(renderQueueSortIdenticalKeys)
+{
+	MRG::RenderQueue queue{};
+	for (uint32_t index = 0; index < 100; ++index) { queue.push(MRG::RenderQueue::makeKey(4, 5, 6, 7.f), index); }
+	queue.sort();
+
+	// Every pass is skipped, the order must not change
+	const auto items = queue.getItems();
+	MRG_CHECK(items.size() == 100)
+	for (uint32_t index = 0; index < items.size(); ++index) { MRG_CHECK(items[index].index == index) }
+}
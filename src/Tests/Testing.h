@@ -0,0 +1,28 @@
+#ifndef TESTING_H
+#define TESTING_H
+
+#include <string>
+
+// Minimal test registry: every test defined with MRG_TEST is run by the Tests executable, which fails if any MRG_CHECK did
+namespace Testing
+{
+	using TestFunction = void (*)();
+
+	// Returns true, so that registration can initialise a static variable
+	bool registerTest(const char* name, TestFunction function);
+	void reportFailure(const char* expression, const char* file, int line);
+}  // namespace Testing
+
+// clang-format off
+#define MRG_TEST(name)                                                                                                                     \
+	static void name();                                                                                                                    \
+	static const bool name##Registered = ::Testing::registerTest(#name, name);                                                             \
+	static void name()
+
+#define MRG_CHECK(x)                                                                                                                       \
+	{                                                                                                                                      \
+		if (!(x)) { ::Testing::reportFailure(#x, __FILE__, __LINE__); }                                                                    \
+	}
+// clang-format on
+
+#endif
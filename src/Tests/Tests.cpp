@@ -0,0 +1,65 @@
+#include "Testing.h"
+
+#include <Morrigu.h>
+
+#include <exception>
+#include <vector>
+
+namespace
+{
+	struct Test
+	{
+		const char* name;
+		Testing::TestFunction function;
+	};
+
+	// Function local, as tests register themselves during static initialisation, in any order
+	[[nodiscard]] std::vector<Test>& getTests()
+	{
+		static std::vector<Test> tests{};
+		return tests;
+	}
+
+	std::size_t failureCount = 0;
+}  // namespace
+
+namespace Testing
+{
+	bool registerTest(const char* name, TestFunction function)
+	{
+		getTests().push_back(Test{.name = name, .function = function});
+		return true;
+	}
+
+	void reportFailure(const char* expression, const char* file, int line)
+	{
+		MRG_ERROR("\t{}:{}: check failed: {}", file, line, expression)
+		++failureCount;
+	}
+}  // namespace Testing
+
+int main()
+{
+	MRG::Logger::init();
+
+	std::size_t failedTests = 0;
+	for (const auto& test : getTests()) {
+		MRG_INFO("{}", test.name)
+
+		const auto previousFailureCount = failureCount;
+		try {
+			test.function();
+		} catch (const std::exception& exception) {
+			MRG_ERROR("\tunexpected exception: {}", exception.what())
+			++failureCount;
+		}
+		if (failureCount != previousFailureCount) { ++failedTests; }
+	}
+
+	if (failedTests != 0) {
+		MRG_ERROR("{} of {} tests failed", failedTests, getTests().size())
+		return 1;
+	}
+	MRG_INFO("All {} tests passed", getTests().size())
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include "Testing.h"
+
+#include "Utils/Textures.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	// Relative to the cooked textures folder, which is itself relative to the working directory of the tests
+	constexpr const char* testTexturePath = "tests/roundTrip.png";
+
+	// Every level is filled with a different byte pattern, so that reading a level from the wrong offset is noticed
+	[[nodiscard]] MRG::MipChain createCompressedChain(vk::Format format, uint32_t width, uint32_t height)
+	{
+		MRG::MipChain chain{};
+		while (true) {
+			const auto size = MRG::Utils::Textures::getCompressedLevelSize(format, width, height);
+			chain.levels.push_back(MRG::MipLevel{.width = width, .height = height, .offset = chain.data.size(), .size = size});
+			for (std::size_t byte = 0; byte < size; ++byte) {
+				chain.data.push_back(static_cast<std::byte>((chain.levels.size() * 31 + byte) & 0xFF));
+			}
+
+			if (width == 1 && height == 1) { break; }
+			width  = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+		}
+
+		return chain;
+	}
+
+	[[nodiscard]] std::vector<char> readFile(const std::string& filePath)
+	{
+		std::ifstream file{filePath, std::ios::binary};
+		return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	}
+
+	void writeFile(const std::string& filePath, const std::vector<char>& data)
+	{
+		std::ofstream file{filePath, std::ios::binary | std::ios::trunc};
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	}
+}  // namespace
+
+MRG_TEST(cookedTextureRoundTrip)
+{
+	const auto cookedPath = MRG::Utils::Textures::getCookedTexturePath(testTexturePath);
+
+	// Sizes that are not multiples of 4 have partially used blocks, and non square ones have levels of different widths and heights
+	for (const auto& [format, width, height] : {std::tuple{vk::Format::eBc1RgbSrgbBlock, 5u, 3u},
+	                                            std::tuple{vk::Format::eBc5UnormBlock, 16u, 16u},
+	                                            std::tuple{vk::Format::eBc7UnormBlock, 8u, 32u}}) {
+		const auto chain = createCompressedChain(format, width, height);
+		MRG_CHECK(MRG::Utils::Textures::cookTexture(chain, format, cookedPath))
+
+		const auto cookedTexture = MRG::Utils::Textures::loadCookedTexture(testTexturePath);
+		MRG_CHECK(cookedTexture.has_value())
+		if (!cookedTexture.has_value()) { continue; }
+
+		const auto data = cookedTexture->file.getData();
+		MRG_CHECK(data.size() >= 12 && std::to_integer<uint8_t>(data[0]) == 0xAB && std::to_integer<char>(data[1]) == 'K')
+		MRG_CHECK(cookedTexture->format == format)
+		MRG_CHECK(cookedTexture->levels.size() == chain.levels.size())
+		if (cookedTexture->levels.size() != chain.levels.size()) { continue; }
+
+		const auto blockSize = MRG::Utils::Textures::getBlockSize(format).value();
+		for (uint32_t level = 0; level < chain.getLevelCount(); ++level) {
+			const auto& cookedLevel = cookedTexture->levels[level];
+			MRG_CHECK(cookedLevel.width == chain.levels[level].width)
+			MRG_CHECK(cookedLevel.height == chain.levels[level].height)
+			MRG_CHECK(cookedLevel.offset % blockSize == 0)
+			MRG_CHECK(std::ranges::equal(data.subspan(cookedLevel.offset, cookedLevel.size), chain.getLevelData(level)))
+		}
+	}
+
+	std::filesystem::remove(cookedPath);
+}
+
+MRG_TEST(cookedTextureInvalidFiles)
+{
+	const auto cookedPath = MRG::Utils::Textures::getCookedTexturePath(testTexturePath);
+	std::filesystem::remove(cookedPath);
+	MRG_CHECK(!MRG::Utils::Textures::loadCookedTexture(testTexturePath).has_value())
+
+	const auto format = vk::Format::eBc7SrgbBlock;
+	MRG_CHECK(MRG::Utils::Textures::cookTexture(createCompressedChain(format, 64, 64), format, cookedPath))
+	const auto validFile = readFile(cookedPath);
+	MRG_CHECK(MRG::Utils::Textures::loadCookedTexture(testTexturePath).has_value())
+
+	// Truncated in the header
+	writeFile(cookedPath, {validFile.begin(), validFile.begin() + 40});
+	MRG_CHECK(!MRG::Utils::Textures::loadCookedTexture(testTexturePath).has_value())
+
+	// Truncated in the data of the biggest level, which is stored last
+	writeFile(cookedPath, {validFile.begin(), validFile.end() - 1});
+	MRG_CHECK(!MRG::Utils::Textures::loadCookedTexture(testTexturePath).has_value())
+
+	// Not a KTX2 file
+	auto invalidIdentifier = validFile;
+	invalidIdentifier[1]   = 'X';
+	writeFile(cookedPath, invalidIdentifier);
+	MRG_CHECK(!MRG::Utils::Textures::loadCookedTexture(testTexturePath).has_value())
+
+	std::filesystem::remove(cookedPath);
+}
@@ -0,0 +1,64 @@
+#include "Testing.h"
+
+#include "Entity/Transform.h"
+#include "Utils/TransformComposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+	[[nodiscard]] bool areClose(const glm::mat4& lhs, const glm::mat4& rhs)
+	{
+		for (glm::length_t column = 0; column < 4; ++column) {
+			for (glm::length_t row = 0; row < 4; ++row) {
+				const auto tolerance = 1e-4f * std::max(1.f, std::abs(rhs[column][row]));
+				if (std::abs(lhs[column][row] - rhs[column][row]) > tolerance) { return false; }
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] std::vector<MRG::Transform> createTransforms(std::size_t count)
+	{
+		// Fixed seed, so that failures can be reproduced
+		std::mt19937 generator{42};
+		std::uniform_real_distribution<float> translations{-50.f, 50.f};
+		std::uniform_real_distribution<float> rotations{-100.f, 100.f};
+		std::uniform_real_distribution<float> scales{0.1f, 5.f};
+
+		std::vector<MRG::Transform> transforms(count);
+		for (auto& transform : transforms) {
+			transform.translation = {translations(generator), translations(generator), translations(generator)};
+			transform.rotation    = {rotations(generator), rotations(generator), rotations(generator)};
+			transform.scale       = {scales(generator), scales(generator), -scales(generator)};
+		}
+		// Angles far outside of [-pi, pi], and exactly on the boundaries of the reduction
+		if (count > 0) { transforms[0].rotation = {1000.f, -1000.f, 0.f}; }
+		if (count > 1) { transforms[1].rotation = {glm::pi<float>(), -glm::pi<float>(), 2.f * glm::pi<float>()}; }
+		return transforms;
+	}
+}  // namespace
+
+MRG_TEST(transformComposition)
+{
+	// Every count up to two full AVX2 batches, so that both the vector path and the scalar tail are checked whatever the width is
+	std::vector<std::size_t> counts(18);
+	std::iota(counts.begin(), counts.end(), std::size_t{0});
+	counts.push_back(37);
+
+	for (const auto count : counts) {
+		const auto transforms = createTransforms(count);
+
+		MRG::Utils::Maths::TransformArrays arrays{};
+		for (const auto& transform : transforms) { arrays.push(transform.translation, transform.rotation, transform.scale); }
+		MRG_CHECK(arrays.size() == count)
+
+		std::vector<glm::mat4> matrices(count);
+		MRG::Utils::Maths::composeTransforms(arrays, matrices);
+		for (std::size_t index = 0; index < count; ++index) { MRG_CHECK(areClose(matrices[index], transforms[index].getTransform())) }
+	}
+}
@@ -0,0 +1,237 @@
+#include "Testing.h"
+
+#include "Entity/Transforms.h"
+
+#include <entt/entt.hpp>
+
+#include <cmath>
+
+namespace
+{
+	[[nodiscard]] bool areClose(const glm::mat4& lhs, const glm::mat4& rhs)
+	{
+		for (glm::length_t column = 0; column < 4; ++column) {
+			for (glm::length_t row = 0; row < 4; ++row) {
+				if (std::abs(lhs[column][row] - rhs[column][row]) > 1e-5f) { return false; }
+			}
+		}
+		return true;
+	}
+
+	entt::entity createTransform(entt::registry& registry, const MRG::Transform& local)
+	{
+		const auto entity = registry.create();
+		registry.emplace<MRG::Components::Transform>(entity).setLocal(local);
+		return entity;
+	}
+
+	[[nodiscard]] const MRG::Components::Transform& getTransform(const entt::registry& registry, entt::entity entity)
+	{
+		return registry.get<MRG::Components::Transform>(entity);
+	}
+
+	// World matrix expected from the local transforms of the given entity and of its ancestors
+	[[nodiscard]] glm::mat4 getExpectedWorldMatrix(const entt::registry& registry, entt::entity entity)
+	{
+		glm::mat4 worldMatrix{1.f};
+		for (; entity != entt::null; entity = getTransform(registry, entity).getParent()) {
+			worldMatrix = getTransform(registry, entity).getLocal().getTransform() * worldMatrix;
+		}
+		return worldMatrix;
+	}
+
+	[[nodiscard]] bool isUpToDate(const entt::registry& registry, entt::entity entity)
+	{
+		return areClose(getTransform(registry, entity).getWorldMatrix(), getExpectedWorldMatrix(registry, entity));
+	}
+}  // namespace
+
+MRG_TEST(transformHierarchyPropagation)
+{
+	entt::registry registry{};
+	const auto root       = createTransform(registry, {.translation = {1.f, 0.f, 0.f}, .scale = {2.f, 2.f, 2.f}});
+	const auto child      = createTransform(registry, {.translation = {0.f, 2.f, 0.f}, .rotation = {0.f, 0.f, 1.f}});
+	const auto grandchild = createTransform(registry, {.translation = {0.f, 0.f, 3.f}});
+	const auto other      = createTransform(registry, {.translation = {5.f, 0.f, 0.f}});
+	// Attaching a subtree updates the depth of all of its nodes
+	MRG::Transforms::setParent(registry, grandchild, child);
+	MRG::Transforms::setParent(registry, child, root);
+	MRG_CHECK(getTransform(registry, child).getDepth() == 1)
+	MRG_CHECK(getTransform(registry, grandchild).getDepth() == 2)
+
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {root, child, grandchild, other}) {
+		MRG_CHECK(isUpToDate(registry, entity))
+		MRG_CHECK(getTransform(registry, entity).getVersion() == 1)
+	}
+
+	// Nothing changed, so nothing is recomputed
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {root, child, grandchild, other}) { MRG_CHECK(getTransform(registry, entity).getVersion() == 1) }
+
+	// Modifying a transform recomputes its whole subtree, and only it
+	registry.get<MRG::Components::Transform>(root).setRotation({0.f, 1.f, 0.f});
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {root, child, grandchild}) {
+		MRG_CHECK(isUpToDate(registry, entity))
+		MRG_CHECK(getTransform(registry, entity).getVersion() == 2)
+	}
+	MRG_CHECK(getTransform(registry, other).getVersion() == 1)
+
+	registry.get<MRG::Components::Transform>(grandchild).setScale({1.f, 3.f, 1.f});
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(isUpToDate(registry, grandchild))
+	MRG_CHECK(getTransform(registry, grandchild).getVersion() == 3)
+	MRG_CHECK(getTransform(registry, root).getVersion() == 2)
+	MRG_CHECK(getTransform(registry, child).getVersion() == 2)
+}
+
+MRG_TEST(transformReparenting)
+{
+	entt::registry registry{};
+	const auto first  = createTransform(registry, {.translation = {1.f, 0.f, 0.f}});
+	const auto second = createTransform(registry, {.translation = {0.f, 10.f, 0.f}, .rotation = {1.f, 0.f, 0.f}});
+	const auto left   = createTransform(registry, {.translation = {0.f, 0.f, 1.f}});
+	const auto middle = createTransform(registry, {.translation = {0.f, 0.f, 2.f}});
+	const auto right  = createTransform(registry, {.translation = {0.f, 0.f, 3.f}});
+	// Children are prepended, so first ends up with left, middle and right in that order
+	for (const auto child : {right, middle, left}) { MRG::Transforms::setParent(registry, child, first); }
+	const auto leaf = createTransform(registry, {.translation = {0.f, 1.f, 0.f}});
+	MRG::Transforms::setParent(registry, leaf, middle);
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(isUpToDate(registry, leaf))
+
+	// Moving a child out of the middle of the sibling list keeps the other siblings linked
+	MRG::Transforms::setParent(registry, middle, second);
+	MRG_CHECK(getTransform(registry, middle).getParent() == second)
+	MRG_CHECK(getTransform(registry, second).getFirstChild() == middle)
+	MRG_CHECK(getTransform(registry, middle).getNextSibling() == entt::null)
+	MRG_CHECK(getTransform(registry, first).getFirstChild() == left)
+	MRG_CHECK(getTransform(registry, left).getNextSibling() == right)
+	MRG_CHECK(getTransform(registry, right).getNextSibling() == entt::null)
+
+	// The local transform is kept, so the world matrix of the whole subtree follows the new parent
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {first, second, left, middle, right, leaf}) { MRG_CHECK(isUpToDate(registry, entity)) }
+
+	// Depths are updated for the whole subtree
+	MRG::Transforms::setParent(registry, second, right);
+	MRG_CHECK(getTransform(registry, second).getDepth() == 2)
+	MRG_CHECK(getTransform(registry, middle).getDepth() == 3)
+	MRG_CHECK(getTransform(registry, leaf).getDepth() == 4)
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {first, second, left, middle, right, leaf}) { MRG_CHECK(isUpToDate(registry, entity)) }
+
+	// Making an entity a root
+	MRG::Transforms::setParent(registry, middle, entt::null);
+	MRG_CHECK(getTransform(registry, middle).getParent() == entt::null)
+	MRG_CHECK(getTransform(registry, middle).getDepth() == 0)
+	MRG_CHECK(getTransform(registry, leaf).getDepth() == 1)
+	MRG_CHECK(getTransform(registry, second).getFirstChild() == entt::null)
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {middle, leaf}) { MRG_CHECK(isUpToDate(registry, entity)) }
+}
+
+MRG_TEST(transformHierarchyCycle)
+{
+	entt::registry registry{};
+	const auto root       = createTransform(registry, {.translation = {1.f, 0.f, 0.f}});
+	const auto child      = createTransform(registry, {.translation = {0.f, 1.f, 0.f}});
+	const auto grandchild = createTransform(registry, {.translation = {0.f, 0.f, 1.f}});
+	MRG::Transforms::setParent(registry, child, root);
+	MRG::Transforms::setParent(registry, grandchild, child);
+
+	// Both are refused, and leave the hierarchy untouched
+	MRG::Transforms::setParent(registry, root, grandchild);
+	MRG::Transforms::setParent(registry, child, child);
+	MRG_CHECK(getTransform(registry, root).getParent() == entt::null)
+	MRG_CHECK(getTransform(registry, child).getParent() == root)
+	MRG_CHECK(getTransform(registry, grandchild).getParent() == child)
+	MRG_CHECK(getTransform(registry, root).getFirstChild() == child)
+	MRG_CHECK(getTransform(registry, child).getFirstChild() == grandchild)
+	MRG_CHECK(getTransform(registry, grandchild).getFirstChild() == entt::null)
+	MRG_CHECK(getTransform(registry, root).getDepth() == 0)
+	MRG_CHECK(getTransform(registry, grandchild).getDepth() == 2)
+
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {root, child, grandchild}) { MRG_CHECK(isUpToDate(registry, entity)) }
+}
+
+MRG_TEST(transformDestroyedParent)
+{
+	entt::registry registry{};
+	const auto parent     = createTransform(registry, {.translation = {1.f, 0.f, 0.f}});
+	const auto first      = createTransform(registry, {.translation = {0.f, 1.f, 0.f}});
+	const auto second     = createTransform(registry, {.translation = {0.f, 2.f, 0.f}});
+	const auto third      = createTransform(registry, {.translation = {0.f, 3.f, 0.f}});
+	const auto grandchild = createTransform(registry, {.translation = {0.f, 0.f, 1.f}});
+	for (const auto child : {third, second, first}) { MRG::Transforms::setParent(registry, child, parent); }
+	MRG::Transforms::setParent(registry, grandchild, first);
+	MRG::Transforms::update<>(registry);
+
+	// Destroying a child unlinks it from its siblings
+	registry.destroy(second);
+	MRG_CHECK(getTransform(registry, parent).getFirstChild() == first)
+	MRG_CHECK(getTransform(registry, first).getNextSibling() == third)
+
+	// Destroying a parent turns its children into roots, keeping their own subtrees
+	registry.destroy(parent);
+	for (const auto child : {first, third}) {
+		MRG_CHECK(getTransform(registry, child).getParent() == entt::null)
+		MRG_CHECK(getTransform(registry, child).getNextSibling() == entt::null)
+		MRG_CHECK(getTransform(registry, child).getDepth() == 0)
+	}
+	MRG_CHECK(getTransform(registry, grandchild).getParent() == first)
+	MRG_CHECK(getTransform(registry, grandchild).getDepth() == 1)
+
+	MRG::Transforms::update<>(registry);
+	for (const auto entity : {first, third, grandchild}) { MRG_CHECK(isUpToDate(registry, entity)) }
+}
+
+MRG_TEST(transformVersionTracking)
+{
+	entt::registry registry{};
+	const auto parent = createTransform(registry, {.translation = {1.f, 0.f, 0.f}});
+	const auto child  = createTransform(registry, {.translation = {0.f, 1.f, 0.f}});
+	MRG::Transforms::setParent(registry, child, parent);
+
+	// Mesh renderers only re-upload their model matrix when the version of their transform changed
+	MRG::Components::TransformVersionTracker tracker{};
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(tracker.update(getTransform(registry, child)))
+	MRG_CHECK(!tracker.update(getTransform(registry, child)))
+
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(!tracker.update(getTransform(registry, child)))
+
+	// Including when only an ancestor changed
+	registry.get<MRG::Components::Transform>(parent).setTranslation({2.f, 0.f, 0.f});
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(tracker.update(getTransform(registry, child)))
+	MRG_CHECK(!tracker.update(getTransform(registry, child)))
+
+	// Modifying a transform without updating the hierarchy does not change its world matrix yet
+	registry.get<MRG::Components::Transform>(child).setScale({2.f, 2.f, 2.f});
+	MRG_CHECK(!tracker.update(getTransform(registry, child)))
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(tracker.update(getTransform(registry, child)))
+}
+
+MRG_TEST(transformReattaching)
+{
+	entt::registry registry{};
+	const auto parent = createTransform(registry, {.translation = {1.f, 0.f, 0.f}});
+	const auto child  = createTransform(registry, {.translation = {0.f, 1.f, 0.f}});
+	MRG::Transforms::setParent(registry, child, parent);
+	MRG::Transforms::update<>(registry);
+
+	// The parent does not change while the child is a root, so its version still matches the one the child was last computed from
+	MRG::Transforms::setParent(registry, child, entt::null);
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(isUpToDate(registry, child))
+
+	MRG::Transforms::setParent(registry, child, parent);
+	MRG::Transforms::update<>(registry);
+	MRG_CHECK(isUpToDate(registry, child))
+	MRG_CHECK(getTransform(registry, child).getVersion() == 3)
+}